@@ -33,6 +33,7 @@
 #include "asio/basic_signal_set.hpp"
 #include "asio/basic_socket.hpp"
 #include "asio/basic_socket_acceptor.hpp"
+#include "asio/basic_socket_acceptor_group.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_socket_streambuf.hpp"
 #include "asio/basic_stream_file.hpp"
@@ -109,6 +110,7 @@
 #include "asio/handler_invoke_hook.hpp"
 #include "asio/high_resolution_timer.hpp"
 #include "asio/io_context.hpp"
+#include "asio/io_context_pool.hpp"
 #include "asio/io_context_strand.hpp"
 #include "asio/io_service.hpp"
 #include "asio/io_service_strand.hpp"
@@ -154,6 +156,7 @@
 #include "asio/posix/stream_descriptor.hpp"
 #include "asio/post.hpp"
 #include "asio/prefer.hpp"
+#include "asio/provided_buffer_ring.hpp"
 #include "asio/query.hpp"
 #include "asio/random_access_file.hpp"
 #include "asio/read.hpp"
@@ -34,6 +34,8 @@
 # include "asio/detail/win_iocp_socket_service.hpp"
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 # include "asio/detail/io_uring_socket_service.hpp"
+#elif defined(ASIO_HAS_IO_URING_SELECTION)
+# include "asio/detail/dual_socket_service.hpp"
 #else
 # include "asio/detail/reactive_socket_service.hpp"
 #endif
@@ -92,6 +94,9 @@ public:
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   typedef typename detail::io_uring_socket_service<
     Protocol>::native_handle_type native_handle_type;
+#elif defined(ASIO_HAS_IO_URING_SELECTION)
+  typedef typename detail::dual_socket_service<
+    Protocol>::native_handle_type native_handle_type;
 #else
   typedef typename detail::reactive_socket_service<
     Protocol>::native_handle_type native_handle_type;
@@ -1843,6 +1848,9 @@ protected:
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   detail::io_object_impl<
     detail::io_uring_socket_service<Protocol>, Executor> impl_;
+#elif defined(ASIO_HAS_IO_URING_SELECTION)
+  detail::io_object_impl<
+    detail::dual_socket_service<Protocol>, Executor> impl_;
 #else
   detail::io_object_impl<
     detail::reactive_socket_service<Protocol>, Executor> impl_;
@@ -33,12 +33,15 @@
 # include "asio/detail/win_iocp_socket_service.hpp"
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 # include "asio/detail/io_uring_socket_service.hpp"
+#elif defined(ASIO_HAS_IO_URING_SELECTION)
+# include "asio/detail/dual_socket_service.hpp"
 #else
 # include "asio/detail/reactive_socket_service.hpp"
 #endif
 
 #if defined(ASIO_HAS_MOVE)
 # include <utility>
+# include <vector>
 #endif // defined(ASIO_HAS_MOVE)
 
 #include "asio/detail/push_options.hpp"
@@ -108,6 +111,9 @@ public:
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   typedef typename detail::io_uring_socket_service<
     Protocol>::native_handle_type native_handle_type;
+#elif defined(ASIO_HAS_IO_URING_SELECTION)
+  typedef typename detail::dual_socket_service<
+    Protocol>::native_handle_type native_handle_type;
 #else
   typedef typename detail::reactive_socket_service<
     Protocol>::native_handle_type native_handle_type;
@@ -2558,6 +2564,416 @@ public:
   }
 #endif // defined(ASIO_HAS_MOVE) || defined(GENERATING_DOCUMENTATION)
 
+#if (defined(ASIO_HAS_MOVE) \
+    && !defined(ASIO_WINDOWS_RUNTIME) \
+    && !defined(ASIO_HAS_IOCP) \
+    && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept all new connections that
+   * are pending on the acceptor, up to a limit, and deliver them to a single
+   * completion handler. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The operation waits until at least one connection is pending. It then
+   * keeps accepting until the listen queue is empty or @c max_connections
+   * connections have been accepted, so that a burst of connections costs one
+   * readiness notification and one handler invocation rather than one of
+   * each per connection.
+   *
+   * This operation is performed by the reactor. An acceptor whose
+   * io_context has selected io_uring for its sockets completes the operation
+   * with asio::error::operation_not_supported.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param max_connections The maximum number of connections to accept. Space
+   * for this many connections is reserved when the operation is started. A
+   * value greater than @c ASIO_ACCEPT_MANY_MAX_CONNECTIONS, 4096 by default,
+   * is reduced to that limit. A value of zero causes the operation to fail
+   * with asio::error::invalid_argument.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the accept completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // The newly accepted sockets. An error that occurs after at least one
+   *   // connection has been accepted is not reported, and is left to be
+   *   // picked up by the next accept operation.
+   *   std::vector<
+   *     typename Protocol::socket::template
+   *       rebind_executor<executor_type>::other> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::vector<
+   *     typename Protocol::socket::template
+   *       rebind_executor<executor_type>::other>) @endcode
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const asio::error_code& error,
+   *     std::vector<asio::ip::tcp::socket> peers)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_many(64, accept_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          executor_type>::other>)) AcceptManyToken
+            ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(AcceptManyToken,
+      void (asio::error_code,
+        std::vector<typename Protocol::socket::template
+          rebind_executor<executor_type>::other>))
+  async_accept_many(std::size_t max_connections,
+      ASIO_MOVE_ARG(AcceptManyToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type))
+  {
+    typedef typename Protocol::socket::template
+      rebind_executor<executor_type>::other other_socket_type;
+
+    return async_initiate<AcceptManyToken,
+      void (asio::error_code, std::vector<other_socket_type>)>(
+        initiate_async_accept_many(this), token, max_connections,
+        impl_.get_executor(), static_cast<other_socket_type*>(0));
+  }
+
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept all new connections that
+   * are pending on the acceptor, up to a limit, and deliver them to a single
+   * completion handler. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The operation waits until at least one connection is pending. It then
+   * keeps accepting until the listen queue is empty or @c max_connections
+   * connections have been accepted, so that a burst of connections costs one
+   * readiness notification and one handler invocation rather than one of
+   * each per connection.
+   *
+   * This operation is performed by the reactor. An acceptor whose
+   * io_context has selected io_uring for its sockets completes the operation
+   * with asio::error::operation_not_supported.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param max_connections The maximum number of connections to accept. Space
+   * for this many connections is reserved when the operation is started. A
+   * value greater than @c ASIO_ACCEPT_MANY_MAX_CONNECTIONS, 4096 by default,
+   * is reduced to that limit. A value of zero causes the operation to fail
+   * with asio::error::invalid_argument.
+   *
+   * @param ex The I/O executor object to be used for the newly accepted
+   * sockets.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the accept completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // The newly accepted sockets. An error that occurs after at least one
+   *   // connection has been accepted is not reported, and is left to be
+   *   // picked up by the next accept operation.
+   *   std::vector<
+   *     typename Protocol::socket::template
+   *       rebind_executor<Executor1>::other> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::vector<
+   *     typename Protocol::socket::template
+   *       rebind_executor<Executor1>::other>) @endcode
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const asio::error_code& error,
+   *     std::vector<asio::ip::tcp::socket> peers)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_many(64, my_context2.get_executor(),
+   *     accept_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename Executor1,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          Executor1>::other>)) AcceptManyToken
+            ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(AcceptManyToken,
+      void (asio::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          Executor1>::other>))
+  async_accept_many(std::size_t max_connections, const Executor1& ex,
+      ASIO_MOVE_ARG(AcceptManyToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type),
+      typename constraint<
+        is_executor<Executor1>::value
+          || execution::is_executor<Executor1>::value
+      >::type = 0)
+  {
+    typedef typename Protocol::socket::template rebind_executor<
+      Executor1>::other other_socket_type;
+
+    return async_initiate<AcceptManyToken,
+      void (asio::error_code, std::vector<other_socket_type>)>(
+        initiate_async_accept_many(this), token, max_connections,
+        ex, static_cast<other_socket_type*>(0));
+  }
+
+  /// Start an asynchronous accept of a batch of connections.
+  /**
+   * This function is used to asynchronously accept all new connections that
+   * are pending on the acceptor, up to a limit, and deliver them to a single
+   * completion handler. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The operation waits until at least one connection is pending. It then
+   * keeps accepting until the listen queue is empty or @c max_connections
+   * connections have been accepted, so that a burst of connections costs one
+   * readiness notification and one handler invocation rather than one of
+   * each per connection.
+   *
+   * This operation is performed by the reactor. An acceptor whose
+   * io_context has selected io_uring for its sockets completes the operation
+   * with asio::error::operation_not_supported.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param max_connections The maximum number of connections to accept. Space
+   * for this many connections is reserved when the operation is started. A
+   * value greater than @c ASIO_ACCEPT_MANY_MAX_CONNECTIONS, 4096 by default,
+   * is reduced to that limit. A value of zero causes the operation to fail
+   * with asio::error::invalid_argument.
+   *
+   * @param context The I/O execution context object to be used for the newly
+   * accepted sockets.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the accept completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // The newly accepted sockets. An error that occurs after at least one
+   *   // connection has been accepted is not reported, and is left to be
+   *   // picked up by the next accept operation.
+   *   std::vector<
+   *     typename Protocol::socket::template rebind_executor<
+   *       typename ExecutionContext::executor_type>::other> peers
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using asio::post().
+   *
+   * @par Completion Signature
+   * @code void(asio::error_code, std::vector<
+   *     typename Protocol::socket::template rebind_executor<
+   *       typename ExecutionContext::executor_type>::other>) @endcode
+   *
+   * @par Example
+   * @code
+   * void accept_handler(const asio::error_code& error,
+   *     std::vector<asio::ip::tcp::socket> peers)
+   * {
+   *   if (!error)
+   *   {
+   *     // Accept succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_many(64, my_context2, accept_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this asynchronous operation supports
+   * cancellation for the following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ExecutionContext,
+      ASIO_COMPLETION_TOKEN_FOR(void (asio::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          typename ExecutionContext::executor_type>::other>)) AcceptManyToken
+            ASIO_DEFAULT_COMPLETION_TOKEN_TYPE(executor_type)>
+  ASIO_INITFN_AUTO_RESULT_TYPE(AcceptManyToken,
+      void (asio::error_code,
+        std::vector<typename Protocol::socket::template rebind_executor<
+          typename ExecutionContext::executor_type>::other>))
+  async_accept_many(std::size_t max_connections, ExecutionContext& context,
+      ASIO_MOVE_ARG(AcceptManyToken) token
+        ASIO_DEFAULT_COMPLETION_TOKEN(executor_type),
+      typename constraint<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type = 0)
+  {
+    typedef typename Protocol::socket::template rebind_executor<
+      typename ExecutionContext::executor_type>::other other_socket_type;
+
+    return async_initiate<AcceptManyToken,
+      void (asio::error_code, std::vector<other_socket_type>)>(
+        initiate_async_accept_many(this), token, max_connections,
+        context.get_executor(), static_cast<other_socket_type*>(0));
+  }
+#endif // (defined(ASIO_HAS_MOVE)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT))
+       // || defined(GENERATING_DOCUMENTATION)
+
+#if (defined(ASIO_HAS_MOVE) \
+      && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+        || defined(ASIO_HAS_IO_URING_SELECTION))) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start a persistent asynchronous accept loop.
+  /**
+   * This function is used to accept new connections repeatedly using a single
+   * operation. Where the kernel supports it, the accept is submitted to
+   * io_uring once in its multishot form, and the kernel produces a completion
+   * for every connection without the accept being re-submitted. On older
+   * kernels the operation falls back to re-submitting a single-shot accept
+   * after each connection.
+   *
+   * The loop is performed by io_uring. On an acceptor whose io_context has
+   * selected the reactor for its sockets, the handler is called once with
+   * asio::error::operation_not_supported.
+   *
+   * This function always returns immediately. It is not an initiating
+   * function for an @ref asynchronous_operation, since the handler may be
+   * called many times, and so it does not accept completion tokens. Only one
+   * accept loop may run on an acceptor at a time; starting another fails with
+   * asio::error::already_started.
+   *
+   * @param handler The handler to be called when each accept completes. The
+   * function signature of the handler must be:
+   * @code bool handler(
+   *   // Result of operation.
+   *   const asio::error_code& error,
+   *
+   *   // On success, the newly accepted socket.
+   *   typename Protocol::socket::template
+   *     rebind_executor<executor_type>::other peer
+   * ); @endcode
+   * The handler returns @c true to accept again, or @c false to end the loop.
+   * The loop also ends after the handler has been called with an error. The
+   * handler will not be invoked from within this function. The acceptor must
+   * be in blocking mode, and must not be moved or destroyed until the loop
+   * has ended.
+   *
+   * @par Example
+   * @code
+   * acceptor.async_accept_loop(
+   *     [&](const asio::error_code& error, asio::ip::tcp::socket peer)
+   *     {
+   *       if (error)
+   *         return false;
+   *       start_session(std::move(peer));
+   *       return true;
+   *     });
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this operation supports cancellation for the
+   * following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * Cancellation, as well as a call to cancel() or close() on the acceptor,
+   * ends the loop. Connections that were accepted before the cancellation
+   * took effect are still passed to the handler, and the handler is then
+   * called with asio::error::operation_aborted.
+   */
+  template <typename AcceptLoopHandler>
+  void async_accept_loop(ASIO_MOVE_ARG(AcceptLoopHandler) handler)
+  {
+    typename decay<AcceptLoopHandler>::type handler2(
+        ASIO_MOVE_CAST(AcceptLoopHandler)(handler));
+
+    impl_.get_service().async_accept_loop(impl_.get_implementation(),
+        impl_.get_executor(), handler2, impl_.get_executor());
+  }
+#endif // (defined(ASIO_HAS_MOVE)
+       //   && (defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //     || defined(ASIO_HAS_IO_URING_SELECTION)))
+       // || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_socket_acceptor(const basic_socket_acceptor&) ASIO_DELETED;
@@ -2664,6 +3080,49 @@ private:
     basic_socket_acceptor* self_;
   };
 
+#if defined(ASIO_HAS_MOVE) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  class initiate_async_accept_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept_many(basic_socket_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    executor_type get_executor() const ASIO_NOEXCEPT
+    {
+      return self_->get_executor();
+    }
+
+    template <typename AcceptManyHandler, typename Executor1, typename Socket>
+    void operator()(ASIO_MOVE_ARG(AcceptManyHandler) handler,
+        std::size_t max_connections, const Executor1& peer_ex, Socket*) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a MoveAcceptHandler
+      // that receives a vector of sockets.
+      ASIO_MOVE_ACCEPT_HANDLER_CHECK(
+          AcceptManyHandler, handler, std::vector<Socket>) type_check;
+
+      detail::non_const_lvalue<AcceptManyHandler> handler2(handler);
+      self_->impl_.get_service().async_accept_many(
+          self_->impl_.get_implementation(), max_connections, peer_ex,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket_acceptor* self_;
+  };
+#endif // defined(ASIO_HAS_MOVE)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
 #if defined(ASIO_WINDOWS_RUNTIME)
   detail::io_object_impl<
     detail::null_socket_service<Protocol>, Executor> impl_;
@@ -2673,6 +3132,9 @@ private:
 #elif defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   detail::io_object_impl<
     detail::io_uring_socket_service<Protocol>, Executor> impl_;
+#elif defined(ASIO_HAS_IO_URING_SELECTION)
+  detail::io_object_impl<
+    detail::dual_socket_service<Protocol>, Executor> impl_;
 #else
   detail::io_object_impl<
     detail::reactive_socket_service<Protocol>, Executor> impl_;
@@ -0,0 +1,418 @@
+//
+// basic_socket_acceptor_group.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_BASIC_SOCKET_ACCEPTOR_GROUP_HPP
+#define ASIO_BASIC_SOCKET_ACCEPTOR_GROUP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <vector>
+#include "asio/any_io_executor.hpp"
+#include "asio/basic_socket_acceptor.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/reactor_shard_scope.hpp"
+#include "asio/detail/socket_types.hpp"
+#include "asio/detail/throw_error.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/socket_base.hpp"
+
+#if defined(ASIO_HAS_REUSEPORT_CBPF)
+# include <linux/filter.h>
+#endif // defined(ASIO_HAS_REUSEPORT_CBPF)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// Provides a group of acceptors that listen on the same endpoint.
+/**
+ * The basic_socket_acceptor_group class template opens a listening socket for
+ * each of its acceptors, all bound to the same endpoint using the
+ * SO_REUSEPORT socket option. The operating system shares incoming
+ * connections out among the listening sockets, so that each acceptor, and the
+ * execution context or thread that serves it, accepts only its own portion of
+ * the connections.
+ *
+ * The acceptors may each use a different execution context, such as one
+ * io_context per thread. When they all use the same io_context, and that
+ * io_context was created with ASIO_CONCURRENCY_HINT_SHARDED_REACTOR, the
+ * acceptor with index @c i is placed on the reactor shard of the thread with
+ * index @c i, and the sockets it accepts join the same shard.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * Accepting connections on one io_context per thread:
+ * @code
+ * asio::ip::tcp::acceptor_group group;
+ * for (std::size_t i = 0; i < contexts.size(); ++i)
+ *   group.add(*contexts[i]);
+ * group.open(asio::ip::tcp::endpoint(asio::ip::tcp::v4(), port));
+ * for (std::size_t i = 0; i < group.size(); ++i)
+ *   start_accept(group[i]);
+ * @endcode
+ */
+template <typename Protocol, typename Executor = any_io_executor>
+class basic_socket_acceptor_group
+  : private detail::noncopyable
+{
+public:
+  /// The type of the executor associated with the acceptors.
+  typedef Executor executor_type;
+
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of the acceptors in the group.
+  typedef basic_socket_acceptor<Protocol, Executor> acceptor_type;
+
+  /// Construct an empty acceptor group.
+  basic_socket_acceptor_group()
+  {
+  }
+
+  /// Destroys the acceptor group.
+  /**
+   * This function destroys the acceptors, closing any that are open.
+   */
+  ~basic_socket_acceptor_group()
+  {
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+      delete acceptors_[i];
+  }
+
+  /// Add an acceptor that uses the specified executor.
+  /**
+   * This function adds an acceptor to the group without opening it.
+   *
+   * @param ex The I/O executor that the acceptor will use, by default, to
+   * dispatch handlers for any asynchronous operations performed on it.
+   */
+  void add(const executor_type& ex)
+  {
+    acceptors_.reserve(acceptors_.size() + 1);
+    acceptors_.push_back(new acceptor_type(ex));
+  }
+
+  /// Add an acceptor that uses the specified execution context.
+  /**
+   * This function adds an acceptor to the group without opening it.
+   *
+   * @param context An execution context which provides the I/O executor that
+   * the acceptor will use, by default, to dispatch handlers for any
+   * asynchronous operations performed on it.
+   */
+  template <typename ExecutionContext>
+  void add(ExecutionContext& context,
+      typename constraint<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type = 0)
+  {
+    acceptors_.reserve(acceptors_.size() + 1);
+    acceptors_.push_back(new acceptor_type(context));
+  }
+
+  /// Get the number of acceptors in the group.
+  std::size_t size() const
+  {
+    return acceptors_.size();
+  }
+
+  /// Get the acceptor with the specified index.
+  acceptor_type& operator[](std::size_t index)
+  {
+    return *acceptors_[index];
+  }
+
+  /// Get the acceptor with the specified index.
+  const acceptor_type& operator[](std::size_t index) const
+  {
+    return *acceptors_[index];
+  }
+
+  /// Open all acceptors and start listening on the specified endpoint.
+  /**
+   * This function opens each acceptor in turn, sets the reuse_address and
+   * reuse_port options, binds it to the specified endpoint and puts it into
+   * the listening state. If the endpoint's port is zero, the acceptors after
+   * the first are bound to the port chosen for the first.
+   *
+   * @param endpoint An endpoint on the local machine on which the acceptors
+   * will listen for new connections.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each acceptor.
+   *
+   * @throws asio::system_error Thrown on failure, in which case all of the
+   * acceptors are closed.
+   */
+  void open(const endpoint_type& endpoint,
+      int backlog = socket_base::max_listen_connections)
+  {
+    asio::error_code ec;
+    open(endpoint, backlog, ec);
+    asio::detail::throw_error(ec, "open");
+  }
+
+  /// Open all acceptors and start listening on the specified endpoint.
+  /**
+   * This function opens each acceptor in turn, sets the reuse_address and
+   * reuse_port options, binds it to the specified endpoint and puts it into
+   * the listening state. If the endpoint's port is zero, the acceptors after
+   * the first are bound to the port chosen for the first.
+   *
+   * @param endpoint An endpoint on the local machine on which the acceptors
+   * will listen for new connections.
+   *
+   * @param backlog The maximum length of the queue of pending connections for
+   * each acceptor.
+   *
+   * @param ec Set to indicate what error occurred, if any. On failure, all of
+   * the acceptors are closed. The error is operation_not_supported if the
+   * platform does not support SO_REUSEPORT.
+   */
+  ASIO_SYNC_OP_VOID open(const endpoint_type& endpoint,
+      int backlog, asio::error_code& ec)
+  {
+#if defined(ASIO_OS_DEF_SO_REUSEPORT)
+    // Acceptors that share an execution context are placed on the shard with
+    // the same index, if the context's reactor is sharded.
+    bool shared_context = true;
+    for (std::size_t i = 1; i < acceptors_.size(); ++i)
+      if (acceptors_[i]->get_executor() != acceptors_[0]->get_executor())
+        shared_context = false;
+
+    endpoint_type bound_endpoint = endpoint;
+    ec = asio::error_code();
+    for (std::size_t i = 0; i < acceptors_.size() && !ec; ++i)
+    {
+      acceptor_type& acceptor = *acceptors_[i];
+      detail::reactor_shard_scope scope(
+          shared_context ? i : ~static_cast<std::size_t>(0));
+
+      acceptor.open(bound_endpoint.protocol(), ec);
+      if (!ec)
+        acceptor.set_option(socket_base::reuse_address(true), ec);
+      if (!ec)
+        acceptor.set_option(socket_base::reuse_port(true), ec);
+      if (!ec)
+        acceptor.bind(bound_endpoint, ec);
+      if (!ec)
+        acceptor.listen(backlog, ec);
+      if (!ec && i == 0 && bound_endpoint.port() == 0)
+        bound_endpoint = acceptor.local_endpoint(ec);
+    }
+
+    if (ec)
+    {
+      asio::error_code ignored_ec;
+      close(ignored_ec);
+    }
+#else // defined(ASIO_OS_DEF_SO_REUSEPORT)
+    (void)endpoint;
+    (void)backlog;
+    ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_OS_DEF_SO_REUSEPORT)
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Steer each new connection to the acceptor for the current CPU.
+  /**
+   * This function attaches a classic BPF program to the group's listening
+   * sockets using SO_ATTACH_REUSEPORT_CBPF. A connection that arrives while
+   * CPU @c n is handling the network receive is given to the acceptor with
+   * index @c n modulo the size of the group, rather than to an acceptor
+   * chosen by hashing the connection's addresses. This is most useful when the
+   * thread that serves each acceptor is bound to the matching CPU, and the
+   * network device's receive queues are bound to those CPUs.
+   *
+   * The acceptors must be open.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void steer_by_cpu()
+  {
+    asio::error_code ec;
+    steer_by_cpu(ec);
+    asio::detail::throw_error(ec, "steer_by_cpu");
+  }
+
+  /// Steer each new connection to the acceptor for the current CPU.
+  /**
+   * This function attaches a classic BPF program to the group's listening
+   * sockets using SO_ATTACH_REUSEPORT_CBPF. A connection that arrives while
+   * CPU @c n is handling the network receive is given to the acceptor with
+   * index @c n modulo the size of the group, rather than to an acceptor
+   * chosen by hashing the connection's addresses.
+   *
+   * The acceptors must be open.
+   *
+   * @param ec Set to indicate what error occurred, if any. The error is
+   * operation_not_supported if the platform does not support
+   * SO_ATTACH_REUSEPORT_CBPF.
+   */
+  ASIO_SYNC_OP_VOID steer_by_cpu(asio::error_code& ec)
+  {
+#if defined(ASIO_HAS_REUSEPORT_CBPF)
+    if (acceptors_.empty())
+    {
+      ec = asio::error::bad_descriptor;
+      ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    // The program is shared by all sockets in the SO_REUSEPORT group, so it
+    // need only be attached to one of them.
+    acceptors_[0]->set_option(cpu_steering_program(acceptors_.size()), ec);
+#else // defined(ASIO_HAS_REUSEPORT_CBPF)
+    ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_REUSEPORT_CBPF)
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Determine whether the acceptors are open.
+  bool is_open() const
+  {
+    return !acceptors_.empty() && acceptors_[0]->is_open();
+  }
+
+  /// Get the local endpoint on which the acceptors are listening.
+  /**
+   * @throws asio::system_error Thrown on failure.
+   */
+  endpoint_type local_endpoint() const
+  {
+    asio::error_code ec;
+    endpoint_type ep = local_endpoint(ec);
+    asio::detail::throw_error(ec, "local_endpoint");
+    return ep;
+  }
+
+  /// Get the local endpoint on which the acceptors are listening.
+  /**
+   * @param ec Set to indicate what error occurred, if any.
+   *
+   * @returns An object that represents the local endpoint of the acceptors.
+   * Returns a default-constructed endpoint object if an error occurred.
+   */
+  endpoint_type local_endpoint(asio::error_code& ec) const
+  {
+    if (acceptors_.empty())
+    {
+      ec = asio::error::bad_descriptor;
+      return endpoint_type();
+    }
+    return acceptors_[0]->local_endpoint(ec);
+  }
+
+  /// Close all acceptors.
+  /**
+   * This function closes each acceptor. Any asynchronous accept operations
+   * will be cancelled immediately.
+   *
+   * @throws asio::system_error Thrown on failure.
+   */
+  void close()
+  {
+    asio::error_code ec;
+    close(ec);
+    asio::detail::throw_error(ec, "close");
+  }
+
+  /// Close all acceptors.
+  /**
+   * This function closes each acceptor. Any asynchronous accept operations
+   * will be cancelled immediately.
+   *
+   * @param ec Set to indicate the first error that occurred, if any.
+   */
+  ASIO_SYNC_OP_VOID close(asio::error_code& ec)
+  {
+    ec = asio::error_code();
+    for (std::size_t i = 0; i < acceptors_.size(); ++i)
+    {
+      asio::error_code close_ec;
+      acceptors_[i]->close(close_ec);
+      if (close_ec && !ec)
+        ec = close_ec;
+    }
+    ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+private:
+#if defined(ASIO_HAS_REUSEPORT_CBPF)
+  // Socket option that attaches a program returning the index of the current
+  // CPU modulo the number of sockets in the group.
+  class cpu_steering_program
+  {
+  public:
+    explicit cpu_steering_program(std::size_t n)
+    {
+      sock_filter code[3] =
+      {
+        { BPF_LD | BPF_W | BPF_ABS, 0, 0,
+          static_cast<__u32>(SKF_AD_OFF + SKF_AD_CPU) },
+        { BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<__u32>(n) },
+        { BPF_RET | BPF_A, 0, 0, 0 }
+      };
+      for (int i = 0; i < 3; ++i)
+        code_[i] = code[i];
+      program_.len = 3;
+      program_.filter = code_;
+    }
+
+    template <typename P>
+    int level(const P&) const
+    {
+      return SOL_SOCKET;
+    }
+
+    template <typename P>
+    int name(const P&) const
+    {
+      return SO_ATTACH_REUSEPORT_CBPF;
+    }
+
+    template <typename P>
+    const void* data(const P&) const
+    {
+      return &program_;
+    }
+
+    template <typename P>
+    std::size_t size(const P&) const
+    {
+      return sizeof(program_);
+    }
+
+  private:
+    sock_filter code_[3];
+    sock_fprog program_;
+  };
+#endif // defined(ASIO_HAS_REUSEPORT_CBPF)
+
+  std::vector<acceptor_type*> acceptors_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_BASIC_SOCKET_ACCEPTOR_GROUP_HPP
@@ -24,6 +24,7 @@
 #include "asio/detail/non_const_lvalue.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
+#include "asio/provided_buffer_ring.hpp"
 
 #include "asio/detail/push_options.hpp"
 
@@ -1076,6 +1077,177 @@ public:
         buffers, socket_base::message_flags(0));
   }
 
+#if (!defined(ASIO_WINDOWS_RUNTIME) \
+    && !defined(ASIO_HAS_IOCP) \
+    && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start a persistent asynchronous read loop.
+  /**
+   * This function is used to read from the stream socket repeatedly using a
+   * single operation. The operation is allocated once, and is re-armed in
+   * place after each read for as long as the handler asks for more data. This
+   * avoids the allocation and deallocation of an operation per message that
+   * a chain of calls to async_read_some incurs.
+   *
+   * The loop is performed by the reactor. On a socket whose io_context has
+   * selected io_uring for its sockets, the handler is called once with
+   * asio::error::operation_not_supported.
+   *
+   * This function always returns immediately. It is not an initiating
+   * function for an @ref asynchronous_operation, since the handler may be
+   * called many times, and so it does not accept completion tokens.
+   *
+   * @param provider A function object that is called before each read to
+   * obtain the buffer into which data will be read. The function signature of
+   * the provider must be:
+   * @code asio::mutable_buffer provider(); @endcode
+   * The underlying memory must remain valid until the handler is called for
+   * the read that uses it. The provider is always called from within this
+   * function or from within the handler's executor, after the handler has
+   * returned. If the provider returns an empty buffer, the handler is called
+   * with asio::error::no_buffer_space and the loop ends.
+   *
+   * @param handler The handler to be called when each read completes. The
+   * function signature of the handler must be:
+   * @code bool handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   std::size_t bytes_transferred // Number of bytes read.
+   * ); @endcode
+   * The handler returns @c true to read again, or @c false to end the loop.
+   * The loop also ends after the handler has been called with an error, such
+   * as asio::error::eof when the peer closes the connection. The handler will
+   * not be invoked from within this function. The socket must not be moved or
+   * destroyed until the loop has ended.
+   *
+   * @par Example
+   * @code
+   * char data[1024];
+   * socket.async_read_loop(
+   *     [&]{ return asio::buffer(data); },
+   *     [&](const asio::error_code& error, std::size_t n)
+   *     {
+   *       if (error)
+   *         return false;
+   *       process(data, n);
+   *       return true;
+   *     });
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this operation supports cancellation for the
+   * following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * Cancellation, as well as a call to cancel() on the socket, only affects a
+   * read that is waiting for data. A read loop that is between reads, because
+   * its handler is running, is stopped by returning @c false from the handler.
+   */
+  template <typename BufferProvider, typename ReadLoopHandler>
+  void async_read_loop(ASIO_MOVE_ARG(BufferProvider) provider,
+      ASIO_MOVE_ARG(ReadLoopHandler) handler)
+  {
+    typename decay<BufferProvider>::type provider2(
+        ASIO_MOVE_CAST(BufferProvider)(provider));
+    typename decay<ReadLoopHandler>::type handler2(
+        ASIO_MOVE_CAST(ReadLoopHandler)(handler));
+
+    this->impl_.get_service().async_receive_loop(
+        this->impl_.get_implementation(), provider2,
+        handler2, this->impl_.get_executor());
+  }
+#endif // (!defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT))
+       // || defined(GENERATING_DOCUMENTATION)
+
+#if (defined(ASIO_HAS_MOVE) \
+      && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+        || defined(ASIO_HAS_IO_URING_SELECTION))) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Start a persistent asynchronous read loop using provided buffers.
+  /**
+   * This function is used to read from the stream socket repeatedly into
+   * buffers taken from a provided_buffer_ring. No buffer is held while the
+   * socket is idle. The kernel takes a buffer from the ring only when data
+   * arrives, and the data is passed to the handler as a provided_buffer that
+   * returns itself to the ring when destroyed. Where the kernel supports it,
+   * the receive is submitted to io_uring once in its multishot form.
+   *
+   * The loop is performed by io_uring. On a socket whose io_context has
+   * selected the reactor for its sockets, the handler is called once with
+   * asio::error::operation_not_supported.
+   *
+   * This function always returns immediately. It is not an initiating
+   * function for an @ref asynchronous_operation, since the handler may be
+   * called many times, and so it does not accept completion tokens.
+   *
+   * @param ring The ring from which buffers are taken. It must be registered
+   * with the socket's execution context, and must outlive the loop.
+   *
+   * @param handler The handler to be called when each read completes. The
+   * function signature of the handler must be:
+   * @code bool handler(
+   *   const asio::error_code& error, // Result of operation.
+   *   asio::provided_buffer data // The data that was read.
+   * ); @endcode
+   * The handler returns @c true to read again, or @c false to end the loop.
+   * The loop also ends after the handler has been called with an error, such
+   * as asio::error::eof when the peer closes the connection, or
+   * asio::error::no_buffer_space when all of the ring's buffers are in use.
+   * The handler will not be invoked from within this function. The socket
+   * must be in blocking mode, and must not be moved or destroyed until the
+   * loop has ended.
+   *
+   * @par Example
+   * @code
+   * asio::provided_buffer_ring ring(my_context, 1024, 4096);
+   * ...
+   * socket.async_read_loop(ring,
+   *     [&](const asio::error_code& error, asio::provided_buffer data)
+   *     {
+   *       if (error)
+   *         return false;
+   *       process(data.data(), data.size());
+   *       return true;
+   *     });
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX operating systems, this operation supports cancellation for the
+   * following asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   *
+   * Cancellation, as well as a call to cancel() or close() on the socket,
+   * ends the loop. Data that was read before the cancellation took effect is
+   * still passed to the handler, and the handler is then called with
+   * asio::error::operation_aborted.
+   */
+  template <typename ReadLoopHandler>
+  void async_read_loop(provided_buffer_ring& ring,
+      ASIO_MOVE_ARG(ReadLoopHandler) handler)
+  {
+    typename decay<ReadLoopHandler>::type handler2(
+        ASIO_MOVE_CAST(ReadLoopHandler)(handler));
+
+    this->impl_.get_service().async_receive_provided(
+        this->impl_.get_implementation(), ring.get_implementation(),
+        handler2, this->impl_.get_executor());
+  }
+#endif // (defined(ASIO_HAS_MOVE)
+       //   && (defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //     || defined(ASIO_HAS_IO_URING_SELECTION)))
+       // || defined(GENERATING_DOCUMENTATION)
+
 private:
   // Disallow copying and assignment.
   basic_stream_socket(const basic_stream_socket&) ASIO_DELETED;
@@ -0,0 +1,172 @@
+//
+// detail/atomic_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
+#define ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/op_queue.hpp"
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# include <atomic>
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+# include "asio/detail/mutex.hpp"
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A queue of operations that may be added to by any number of threads without
+// locking, and that is emptied by a single consumer in one step. Operations
+// are linked through the same next_ pointer used by op_queue, so an operation
+// must not be in an op_queue and an atomic_op_queue at the same time.
+template <typename Operation>
+class atomic_op_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  atomic_op_queue()
+    : head_(0)
+  {
+  }
+
+  // Destructor destroys all operations.
+  ~atomic_op_queue()
+  {
+    op_queue<Operation> ops;
+    take_all(ops);
+  }
+
+  // Push an operation. Returns true if the queue was previously empty, in
+  // which case the caller is responsible for notifying the consumer.
+  bool push(Operation* op)
+  {
+    return push_chain(op, op);
+  }
+
+  // Push all operations from an op_queue, preserving their order. Returns true
+  // if the queue was previously empty.
+  template <typename OtherOperation>
+  bool push(op_queue<OtherOperation>& q)
+  {
+    // The shared list is kept newest-first, so reverse the operations before
+    // linking them in as a single chain.
+    Operation* first = 0;
+    Operation* last = 0;
+    while (Operation* op = q.front())
+    {
+      q.pop();
+      op_queue_access::next(op, first);
+      first = op;
+      if (last == 0)
+        last = op;
+    }
+
+    return first ? push_chain(first, last) : false;
+  }
+
+  // Move all operations to the back of an op_queue, in the order in which they
+  // were pushed. Returns false if there were no operations to take.
+  template <typename OtherOperation>
+  bool take_all(op_queue<OtherOperation>& q)
+  {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    if (head_.load(std::memory_order_relaxed) == 0)
+      return false;
+    Operation* op = head_.exchange(0, std::memory_order_acquire);
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    mutex::scoped_lock lock(mutex_);
+    Operation* op = head_;
+    head_ = 0;
+    lock.unlock();
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+    if (op == 0)
+      return false;
+
+    // Reverse the list to recover the order in which operations were pushed.
+    Operation* first = 0;
+    while (op)
+    {
+      Operation* next = op_queue_access::next(op);
+      op_queue_access::next(op, first);
+      first = op;
+      op = next;
+    }
+
+    while (first)
+    {
+      Operation* next = op_queue_access::next(first);
+      q.push(first);
+      first = next;
+    }
+
+    return true;
+  }
+
+  // Whether the queue is empty. The result is only a hint unless no other
+  // thread is pushing operations.
+  bool empty() const
+  {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    return head_.load(std::memory_order_relaxed) == 0;
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    mutex::scoped_lock lock(mutex_);
+    return head_ == 0;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  }
+
+private:
+  // Link a chain of operations, given newest-first, on to the head of the list.
+  bool push_chain(Operation* first, Operation* last)
+  {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    Operation* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(last, head);
+    } while (!head_.compare_exchange_weak(head, first,
+          std::memory_order_release, std::memory_order_relaxed));
+    return head == 0;
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    mutex::scoped_lock lock(mutex_);
+    Operation* head = head_;
+    op_queue_access::next(last, head);
+    head_ = first;
+    return head == 0;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  }
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // The most recently pushed operation.
+  std::atomic<Operation*> head_;
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // Mutex to protect access to the list.
+  mutable mutex mutex_;
+
+  // The most recently pushed operation.
+  Operation* head_;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
@@ -0,0 +1,116 @@
+//
+// detail/atomic_op_slot.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_ATOMIC_OP_SLOT_HPP
+#define ASIO_DETAIL_ATOMIC_OP_SLOT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#include <atomic>
+#include <cstdint>
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A single word that holds either one of a small number of states, or a
+// pointer to an operation. Operations are at least word aligned, so their
+// addresses never collide with the state values.
+template <typename Operation>
+class atomic_op_slot
+  : private noncopyable
+{
+public:
+  typedef std::uintptr_t value_type;
+
+  // The states that a slot may be in, other than holding an operation.
+  enum
+  {
+    // No operation is waiting, and the descriptor is not known to be ready.
+    empty = 0,
+
+    // No operation is waiting, and the descriptor may be ready.
+    ready = 1,
+
+    // More than one operation is waiting, or the slot has been closed. The
+    // operations are managed by the descriptor's mutex.
+    queued = 2
+  };
+
+  // Constructor.
+  explicit atomic_op_slot(value_type v = empty)
+    : value_(v)
+  {
+  }
+
+  // Whether a value holds an operation.
+  static bool holds_op(value_type v)
+  {
+    return v > queued;
+  }
+
+  // Get the operation held by a value.
+  static Operation* to_op(value_type v)
+  {
+    return reinterpret_cast<Operation*>(v);
+  }
+
+  // Get the value that holds an operation.
+  static value_type from_op(Operation* op)
+  {
+    return reinterpret_cast<value_type>(op);
+  }
+
+  // Get the current value.
+  value_type load() const
+  {
+    return value_.load(std::memory_order_acquire);
+  }
+
+  // Set the current value.
+  void store(value_type v)
+  {
+    value_.store(v, std::memory_order_release);
+  }
+
+  // Set the current value, returning the previous one.
+  value_type exchange(value_type v)
+  {
+    return value_.exchange(v, std::memory_order_acq_rel);
+  }
+
+  // Replace the value if it is equal to the expected one. Otherwise the
+  // expected value is updated to the current value.
+  bool compare_exchange(value_type& expected, value_type desired)
+  {
+    return value_.compare_exchange_strong(expected, desired,
+        std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<value_type> value_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+#endif // ASIO_DETAIL_ATOMIC_OP_SLOT_HPP
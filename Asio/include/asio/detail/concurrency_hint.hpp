@@ -33,6 +33,54 @@
 // If set, this bit indicates that the reactor should perform locking for I/O.
 #define ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO 0x4u
 
+// If set, this bit indicates that the scheduler should give each thread that
+// calls run() its own handler queue, with idle threads stealing from others.
+#define ASIO_CONCURRENCY_HINT_ENABLE_WORK_STEALING 0x8u
+
+// If set, this bit indicates that the scheduler should accept handlers posted
+// from outside its own threads using a lock-free queue.
+#define ASIO_CONCURRENCY_HINT_ENABLE_LOCKFREE_POST 0x10u
+
+// If set, this bit indicates that threads that run out of handlers should spin
+// for a time before blocking.
+#define ASIO_CONCURRENCY_HINT_ENABLE_BUSY_POLL 0x20u
+
+// If set, this bit indicates that the scheduler should wake the idle thread
+// that most recently ran out of work, rather than an arbitrary one.
+#define ASIO_CONCURRENCY_HINT_ENABLE_LIFO_WAKE 0x40u
+
+// If set, this bit indicates that the reactor should give each thread that
+// calls run() its own epoll instance, and assign descriptors among them.
+#define ASIO_CONCURRENCY_HINT_ENABLE_SHARDED_REACTOR 0x80u
+
+// If set, this bit indicates that the reactor should let threads start read
+// and write operations on a descriptor without acquiring its mutex.
+#define ASIO_CONCURRENCY_HINT_ENABLE_LOCKFREE_DESCRIPTORS 0x100u
+
+// If set, this bit indicates that the reactor should not register a descriptor
+// with epoll until an operation on it has to wait.
+#define ASIO_CONCURRENCY_HINT_ENABLE_LAZY_REGISTRATION 0x200u
+
+// If set, this bit indicates that sockets should use io_uring rather than the
+// reactor, when both are available.
+#define ASIO_CONCURRENCY_HINT_ENABLE_IO_URING 0x400u
+
+// If set, this bit indicates that io_uring should use a kernel thread to poll
+// its submission queue.
+#define ASIO_CONCURRENCY_HINT_ENABLE_IO_URING_SQPOLL 0x800u
+
+// If set, this bit indicates that io_uring should give each thread that calls
+// run() its own ring, and assign I/O objects among them.
+#define ASIO_CONCURRENCY_HINT_ENABLE_SHARDED_IO_URING 0x1000u
+
+// If set, this bit indicates that the scheduler should give each thread that
+// calls run() an index, by which functions may be submitted to that thread.
+#define ASIO_CONCURRENCY_HINT_ENABLE_THREAD_TARGETING 0x2000u
+
+// If set, this bit indicates that the reactor should keep statistics on its
+// calls to epoll_wait.
+#define ASIO_CONCURRENCY_HINT_ENABLE_REACTOR_STATISTICS 0x4000u
+
 // Helper macro to determine if we have a special concurrency hint.
 #define ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
   ((static_cast<unsigned>(hint) \
@@ -46,6 +94,13 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_ ## facility)) \
         ^ ASIO_CONCURRENCY_HINT_ID) != 0)
 
+// Helper macro to determine if an optional scheduler or reactor feature has
+// been requested. Features may only be enabled using a special hint.
+#define ASIO_CONCURRENCY_HINT_IS_ENABLED(feature, hint) \
+  (ASIO_CONCURRENCY_HINT_IS_SPECIAL(hint) \
+    && ((static_cast<unsigned>(hint) \
+      & ASIO_CONCURRENCY_HINT_ENABLE_ ## feature) != 0))
+
 // This special concurrency hint disables locking in both the scheduler and
 // reactor I/O. This hint has the following restrictions:
 //
@@ -78,12 +133,196 @@
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_REGISTRATION \
       | ASIO_CONCURRENCY_HINT_LOCKING_REACTOR_IO)
 
+// This special concurrency hint provides full thread safety, and gives each
+// thread that calls run() a private queue for the handlers it posts. Threads
+// that run out of work steal handlers from the queues of other threads. The
+// shared queue is used only for handlers posted from outside the scheduler.
+//
+// Special hints that enable optional features may be combined using bitwise
+// or, e.g. ASIO_CONCURRENCY_HINT_WORK_STEALING | <another feature hint>.
+#define ASIO_CONCURRENCY_HINT_WORK_STEALING \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_WORK_STEALING)
+
+// This special concurrency hint provides full thread safety, and lets threads
+// post handlers without acquiring the scheduler's mutex. The handlers are added
+// to a lock-free queue that is emptied by the threads running the scheduler,
+// and a thread is woken only when the queue goes from empty to non-empty. This
+// hint has no effect on ordering guarantees.
+#define ASIO_CONCURRENCY_HINT_LOCKFREE_POST \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_LOCKFREE_POST)
+
+// This special concurrency hint provides full thread safety, and makes threads
+// that run out of handlers keep polling the queue and the reactor, without
+// blocking, before they go to sleep. This trades CPU time for lower wake-up
+// latency. The time spent spinning adapts to recent idle periods, and is
+// limited by io_context::set_busy_poll_duration().
+#define ASIO_CONCURRENCY_HINT_BUSY_POLL \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_BUSY_POLL)
+
+// This special concurrency hint provides full thread safety, and gives each
+// thread that calls run() its own wakeup event. Idle threads are kept on a
+// stack, and the thread that most recently ran out of work is woken first, so
+// that work stays on a few threads with warm caches while the others sleep.
+// Threads that have been idle for longer than ASIO_LIFO_WAKE_DEEP_SLEEP_USEC
+// are woken only one at a time, when no recently idled thread is available.
+#define ASIO_CONCURRENCY_HINT_LIFO_WAKE \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_LIFO_WAKE)
+
+// This special concurrency hint provides full thread safety, and gives each
+// thread that calls run() its own epoll instance, or shard. Descriptors are
+// assigned to shards in turn when they are registered, and the readiness of a
+// descriptor is processed, and its first completion handler run, by the thread
+// that owns its shard. An idle thread waits on its own shard, while the shards
+// of busy threads are watched through the shared epoll instance. Timers and
+// internal descriptors remain with the shared epoll instance. A shard whose
+// thread has left run() is served by any thread.
+// The acceptors of an ip::tcp::acceptor_group are instead placed on the shards
+// with their own indexes, and the sockets they accept join the same shards.
+// This hint has no effect on platforms that do not use epoll.
+#define ASIO_CONCURRENCY_HINT_SHARDED_REACTOR \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_SHARDED_REACTOR)
+
+// This special concurrency hint provides full thread safety, and lets threads
+// start read and write operations on a descriptor without acquiring the
+// descriptor's mutex. While a descriptor has at most one operation of each
+// type outstanding, the operation is handed to the reactor, or performed
+// speculatively, using an atomic slot. The mutex is still used when several
+// operations of the same type are outstanding, and by the reactor when it
+// performs operations. Read operations do not wait for outstanding exception
+// operations, and the descriptor is registered for writability up front. This
+// hint has no effect on platforms that do not use epoll, or when std::atomic
+// is not available.
+#define ASIO_CONCURRENCY_HINT_LOCKFREE_DESCRIPTORS \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_LOCKFREE_DESCRIPTORS)
+
+// This special concurrency hint provides full thread safety, and defers adding
+// a descriptor to the epoll set until the first operation on it cannot
+// complete immediately. Descriptors whose operations all complete without
+// waiting are never added to, or removed from, the epoll set. Descriptors
+// that epoll does not support are detected only when an operation would have
+// to wait, and the operation then fails with operation_not_supported, just as
+// it does without this hint. This hint has no effect on descriptors that use
+// lock-free op slots, or on platforms that do not use epoll.
+#define ASIO_CONCURRENCY_HINT_LAZY_REGISTRATION \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_LAZY_REGISTRATION)
+
+// This special concurrency hint provides full thread safety, and makes the
+// sockets and acceptors of the io_context perform their operations using
+// io_uring. If io_uring cannot be initialised, for example because the kernel
+// does not support it or a seccomp filter blocks it, the sockets fall back to
+// the reactor. The ASIO_IO_BACKEND environment variable, if set to "io_uring"
+// or "epoll", overrides this hint for every io_context in the program. This
+// hint has no effect unless the program is built with ASIO_HAS_IO_URING on a
+// platform that also uses epoll.
+#define ASIO_CONCURRENCY_HINT_IO_URING \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_IO_URING)
+
+// This special concurrency hint is like ASIO_CONCURRENCY_HINT_IO_URING, and
+// also creates the io_uring instance with a kernel thread that polls the
+// submission queue. Submitting an operation then only writes to memory shared
+// with the kernel, and a system call is needed only to wake the polling thread
+// after it has been idle. The thread's idle time and CPU affinity are set by
+// io_context::set_io_uring_sqpoll(). If the kernel refuses to create the
+// thread, for example because the process lacks the required privileges, the
+// io_uring instance is created without it.
+#define ASIO_CONCURRENCY_HINT_IO_URING_SQPOLL \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_IO_URING \
+      | ASIO_CONCURRENCY_HINT_ENABLE_IO_URING_SQPOLL)
+
+// This special concurrency hint is like ASIO_CONCURRENCY_HINT_IO_URING, and
+// also gives each thread that calls run() its own io_uring instance, or shard.
+// I/O objects are assigned to shards in turn when they are opened. Their
+// operations are submitted to the shard's ring under the shard's own mutex,
+// and their completions are reaped, and their handlers run, by the thread
+// that owns the shard. An idle thread waits on its shard's ring, and is woken
+// by a write to an eventfd that the ring reads. Timers stay on the shared
+// ring. Multishot operations are submitted to the shared ring, where rings of
+// provided buffers are registered, but their handlers run on the thread that
+// owns the I/O object's shard. Operations on shards do not use the shared
+// ring's registered file table, and shards do not use a submission queue
+// polling thread. A shard whose thread has left run() is served by any thread.
+// If combined with ASIO_CONCURRENCY_HINT_SHARDED_REACTOR, idle threads wait
+// on their io_uring shards, and the reactor's shards are polled through its
+// shared epoll instance.
+#define ASIO_CONCURRENCY_HINT_SHARDED_IO_URING \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_IO_URING \
+      | ASIO_CONCURRENCY_HINT_ENABLE_SHARDED_IO_URING)
+
+// This special concurrency hint provides full thread safety, and gives each
+// thread that calls run() an index, the smallest not in use by another thread
+// inside run(). Functions may then be submitted to a single thread using the
+// executor returned by io_context::get_thread_executor(). Each thread inside
+// run() waits on its own wakeup event when idle, so that it can be woken
+// alone. The LIFO wake and sharded hints also give threads indexes.
+#define ASIO_CONCURRENCY_HINT_THREAD_TARGETING \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_THREAD_TARGETING)
+
+// This special concurrency hint provides full thread safety, and makes the
+// reactor count its waits and the events they return, and time the waits and
+// the dispatch of ready descriptors. The counts are available from the
+// io_context's reactor_waits() and related functions. Without this hint the
+// reactor reads no clocks and updates no counters for them. This hint has no
+// effect on platforms that do not use epoll.
+#define ASIO_CONCURRENCY_HINT_REACTOR_STATISTICS \
+  static_cast<int>(ASIO_CONCURRENCY_HINT_SAFE \
+      | ASIO_CONCURRENCY_HINT_ENABLE_REACTOR_STATISTICS)
+
 // This #define may be overridden at compile time to specify a program-wide
 // default concurrency hint, used by the zero-argument io_context constructor.
 #if !defined(ASIO_CONCURRENCY_HINT_DEFAULT)
 # define ASIO_CONCURRENCY_HINT_DEFAULT -1
 #endif // !defined(ASIO_CONCURRENCY_HINT_DEFAULT)
 
+// This #define may be overridden at compile time to specify the default limit,
+// in microseconds, on the time an idle thread spins when busy polling.
+#if !defined(ASIO_BUSY_POLL_USEC)
+# define ASIO_BUSY_POLL_USEC 50
+#endif // !defined(ASIO_BUSY_POLL_USEC)
+
+// This #define may be overridden at compile time to specify the time, in
+// microseconds, after which an idle thread is considered to be sleeping deeply
+// when idle threads are woken in LIFO order.
+#if !defined(ASIO_LIFO_WAKE_DEEP_SLEEP_USEC)
+# define ASIO_LIFO_WAKE_DEEP_SLEEP_USEC 2000
+#endif // !defined(ASIO_LIFO_WAKE_DEEP_SLEEP_USEC)
+
+// This #define may be overridden at compile time to specify the largest number
+// of epoll or io_uring instances used by a sharded reactor or io_uring.
+#if !defined(ASIO_SHARDED_REACTOR_MAX_SHARDS)
+# define ASIO_SHARDED_REACTOR_MAX_SHARDS 64
+#endif // !defined(ASIO_SHARDED_REACTOR_MAX_SHARDS)
+
+// This #define may be overridden at compile time to specify the default time,
+// in milliseconds, for which an io_uring submission queue polling thread keeps
+// polling after the last submission.
+#if !defined(ASIO_IO_URING_SQPOLL_IDLE_MSEC)
+# define ASIO_IO_URING_SQPOLL_IDLE_MSEC 1000
+#endif // !defined(ASIO_IO_URING_SQPOLL_IDLE_MSEC)
+
+// This #define may be overridden at compile time to specify the default number
+// of submission queue entries in each io_uring instance.
+#if !defined(ASIO_IO_URING_RING_SIZE)
+# define ASIO_IO_URING_RING_SIZE 16384
+#endif // !defined(ASIO_IO_URING_RING_SIZE)
+
+// This #define may be overridden at compile time to specify the largest number
+// of connections accepted by one async_accept_many operation. Larger limits
+// are reduced to this value.
+#if !defined(ASIO_ACCEPT_MANY_MAX_CONNECTIONS)
+# define ASIO_ACCEPT_MANY_MAX_CONNECTIONS 4096
+#endif // !defined(ASIO_ACCEPT_MANY_MAX_CONNECTIONS)
+
 // This #define may be overridden at compile time to specify a program-wide
 // concurrency hint, used by the one-argument io_context constructor when
 // passed a value of 1.
@@ -82,6 +82,16 @@ public:
       return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them.
+  std::size_t maybe_unlock_and_signal_some(
+      conditionally_enabled_mutex::scoped_lock& lock, std::size_t n)
+  {
+    if (lock.mutex_.enabled_)
+      return event_.maybe_unlock_and_signal_some(lock, n);
+    else
+      return 0;
+  }
+
   // Reset the event.
   void clear(conditionally_enabled_mutex::scoped_lock& lock)
   {
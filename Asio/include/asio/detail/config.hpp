@@ -1468,7 +1468,7 @@
 # include <unistd.h>
 #endif // defined(ASIO_HAS_UNISTD_H)
 
-// Linux: epoll, eventfd and timerfd.
+// Linux: epoll, eventfd, timerfd and SO_ATTACH_REUSEPORT_CBPF.
 #if defined(__linux__)
 # include <linux/version.h>
 # if !defined(ASIO_HAS_EPOLL)
@@ -1492,6 +1492,13 @@
 #   endif // (__GLIBC__ > 2) || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 8)
 #  endif // defined(ASIO_HAS_EPOLL)
 # endif // !defined(ASIO_HAS_TIMERFD)
+# if !defined(ASIO_HAS_REUSEPORT_CBPF)
+#  if !defined(ASIO_DISABLE_REUSEPORT_CBPF)
+#   if LINUX_VERSION_CODE >= KERNEL_VERSION(4,5,0)
+#    define ASIO_HAS_REUSEPORT_CBPF 1
+#   endif // LINUX_VERSION_CODE >= KERNEL_VERSION(4,5,0)
+#  endif // !defined(ASIO_DISABLE_REUSEPORT_CBPF)
+# endif // !defined(ASIO_HAS_REUSEPORT_CBPF)
 #endif // defined(__linux__)
 
 // Linux: io_uring is used instead of epoll.
@@ -1501,6 +1508,18 @@
 # endif // !defined(ASIO_HAS_EPOLL) && defined(ASIO_HAS_IO_URING)
 #endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 
+// Linux: both epoll and io_uring are available, and sockets use whichever the
+// io_context selects at runtime.
+#if !defined(ASIO_HAS_IO_URING_SELECTION)
+# if defined(ASIO_HAS_EPOLL) && defined(ASIO_HAS_IO_URING)
+#  if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#   if !defined(ASIO_DISABLE_IO_URING_SELECTION)
+#    define ASIO_HAS_IO_URING_SELECTION 1
+#   endif // !defined(ASIO_DISABLE_IO_URING_SELECTION)
+#  endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+# endif // defined(ASIO_HAS_EPOLL) && defined(ASIO_HAS_IO_URING)
+#endif // !defined(ASIO_HAS_IO_URING_SELECTION)
+
 // Mac OS X, FreeBSD, NetBSD, OpenBSD: kqueue.
 #if (defined(__MACH__) && defined(__APPLE__)) \
   || defined(__FreeBSD__) \
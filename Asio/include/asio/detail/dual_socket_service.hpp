@@ -0,0 +1,748 @@
+//
+// detail/dual_socket_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_DUAL_SOCKET_SERVICE_HPP
+#define ASIO_DETAIL_DUAL_SOCKET_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+
+#include <cstddef>
+#include <vector>
+#include "asio/error.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/post.hpp"
+#include "asio/provided_buffer_ring.hpp"
+#include "asio/socket_base.hpp"
+#include "asio/detail/bind_handler.hpp"
+#include "asio/detail/io_backend_selector.hpp"
+#include "asio/detail/io_uring_socket_service.hpp"
+#include "asio/detail/reactive_socket_service.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A socket service that forwards each operation to either the reactive or the
+// io_uring socket service. The choice is made by the io_backend_selector when
+// a socket implementation is constructed, and is recorded in the
+// implementation so that each call costs a single branch.
+template <typename Protocol>
+class dual_socket_service :
+  public execution_context_service_base<dual_socket_service<Protocol> >
+{
+public:
+  // The protocol type.
+  typedef Protocol protocol_type;
+
+  // The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  // The native type of a socket.
+  typedef socket_type native_handle_type;
+
+  // The service used when the io_context selects the reactor.
+  typedef reactive_socket_service<Protocol> reactive_service_type;
+
+  // The service used when the io_context selects io_uring.
+  typedef io_uring_socket_service<Protocol> io_uring_service_type;
+
+  // The implementation type of the socket.
+  struct implementation_type
+  {
+    // Default constructor.
+    implementation_type()
+      : uses_io_uring_(false)
+    {
+    }
+
+    // Whether the socket uses io_uring rather than the reactor.
+    bool uses_io_uring_;
+
+    // The implementation used with the reactor.
+    typename reactive_service_type::implementation_type reactive_impl_;
+
+    // The implementation used with io_uring.
+    typename io_uring_service_type::implementation_type io_uring_impl_;
+  };
+
+  // Constructor.
+  dual_socket_service(execution_context& context)
+    : execution_context_service_base<dual_socket_service<Protocol> >(context),
+      reactive_service_(use_service<reactive_service_type>(context)),
+      io_uring_service_(use_service<io_backend_selector>(context).use_io_uring()
+          ? &use_service<io_uring_service_type>(context) : 0)
+  {
+  }
+
+  // Destroy all user-defined handler objects owned by the service.
+  void shutdown()
+  {
+  }
+
+  // Construct a new socket implementation.
+  void construct(implementation_type& impl)
+  {
+    impl.uses_io_uring_ = io_uring_service_ != 0;
+    if (impl.uses_io_uring_)
+      io_uring_service_->construct(impl.io_uring_impl_);
+    else
+      reactive_service_.construct(impl.reactive_impl_);
+  }
+
+  // Move-construct a new socket implementation.
+  void move_construct(implementation_type& impl,
+      implementation_type& other_impl) ASIO_NOEXCEPT
+  {
+    impl.uses_io_uring_ = other_impl.uses_io_uring_;
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->move_construct(
+          impl.io_uring_impl_, other_impl.io_uring_impl_);
+    }
+    else
+    {
+      reactive_service_.move_construct(
+          impl.reactive_impl_, other_impl.reactive_impl_);
+    }
+  }
+
+  // Move-assign from another socket implementation.
+  void move_assign(implementation_type& impl,
+      dual_socket_service& other_service,
+      implementation_type& other_impl)
+  {
+    if (impl.uses_io_uring_ != other_impl.uses_io_uring_)
+    {
+      // The other socket belongs to an io_context that selected a different
+      // backend, so the implementation is rebuilt using that backend.
+      destroy(impl);
+      other_service.move_construct(impl, other_impl);
+    }
+    else if (impl.uses_io_uring_)
+    {
+      io_uring_service_->move_assign(impl.io_uring_impl_,
+          *other_service.io_uring_service_, other_impl.io_uring_impl_);
+    }
+    else
+    {
+      reactive_service_.move_assign(impl.reactive_impl_,
+          other_service.reactive_service_, other_impl.reactive_impl_);
+    }
+  }
+
+  // Move-construct a new socket implementation from another protocol type.
+  template <typename Protocol1>
+  void converting_move_construct(implementation_type& impl,
+      dual_socket_service<Protocol1>& other_service,
+      typename dual_socket_service<
+        Protocol1>::implementation_type& other_impl)
+  {
+    impl.uses_io_uring_ = other_impl.uses_io_uring_;
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->converting_move_construct(impl.io_uring_impl_,
+          *other_service.io_uring_service_, other_impl.io_uring_impl_);
+    }
+    else
+    {
+      reactive_service_.converting_move_construct(impl.reactive_impl_,
+          other_service.reactive_service_, other_impl.reactive_impl_);
+    }
+  }
+
+  // Destroy a socket implementation.
+  void destroy(implementation_type& impl)
+  {
+    if (impl.uses_io_uring_)
+      io_uring_service_->destroy(impl.io_uring_impl_);
+    else
+      reactive_service_.destroy(impl.reactive_impl_);
+  }
+
+  // Determine whether the socket is open.
+  bool is_open(const implementation_type& impl) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->is_open(impl.io_uring_impl_)
+      : reactive_service_.is_open(impl.reactive_impl_);
+  }
+
+  // Destroy a socket implementation.
+  asio::error_code close(implementation_type& impl,
+      asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->close(impl.io_uring_impl_, ec)
+      : reactive_service_.close(impl.reactive_impl_, ec);
+  }
+
+  // Release ownership of the socket.
+  socket_type release(implementation_type& impl, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->release(impl.io_uring_impl_, ec)
+      : reactive_service_.release(impl.reactive_impl_, ec);
+  }
+
+  // Get the native socket representation.
+  native_handle_type native_handle(implementation_type& impl)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->native_handle(impl.io_uring_impl_)
+      : reactive_service_.native_handle(impl.reactive_impl_);
+  }
+
+  // Cancel all operations associated with the socket.
+  asio::error_code cancel(implementation_type& impl,
+      asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->cancel(impl.io_uring_impl_, ec)
+      : reactive_service_.cancel(impl.reactive_impl_, ec);
+  }
+
+  // Determine whether the socket is at the out-of-band data mark.
+  bool at_mark(const implementation_type& impl,
+      asio::error_code& ec) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->at_mark(impl.io_uring_impl_, ec)
+      : reactive_service_.at_mark(impl.reactive_impl_, ec);
+  }
+
+  // Determine the number of bytes available for reading.
+  std::size_t available(const implementation_type& impl,
+      asio::error_code& ec) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->available(impl.io_uring_impl_, ec)
+      : reactive_service_.available(impl.reactive_impl_, ec);
+  }
+
+  // Place the socket into the state where it will listen for new connections.
+  asio::error_code listen(implementation_type& impl,
+      int backlog, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->listen(impl.io_uring_impl_, backlog, ec)
+      : reactive_service_.listen(impl.reactive_impl_, backlog, ec);
+  }
+
+  // Perform an IO control command on the socket.
+  template <typename IO_Control_Command>
+  asio::error_code io_control(implementation_type& impl,
+      IO_Control_Command& command, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->io_control(impl.io_uring_impl_, command, ec)
+      : reactive_service_.io_control(impl.reactive_impl_, command, ec);
+  }
+
+  // Gets the non-blocking mode of the socket.
+  bool non_blocking(const implementation_type& impl) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->non_blocking(impl.io_uring_impl_)
+      : reactive_service_.non_blocking(impl.reactive_impl_);
+  }
+
+  // Sets the non-blocking mode of the socket.
+  asio::error_code non_blocking(implementation_type& impl,
+      bool mode, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->non_blocking(impl.io_uring_impl_, mode, ec)
+      : reactive_service_.non_blocking(impl.reactive_impl_, mode, ec);
+  }
+
+  // Gets the non-blocking mode of the native socket implementation.
+  bool native_non_blocking(const implementation_type& impl) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->native_non_blocking(impl.io_uring_impl_)
+      : reactive_service_.native_non_blocking(impl.reactive_impl_);
+  }
+
+  // Sets the non-blocking mode of the native socket implementation.
+  asio::error_code native_non_blocking(implementation_type& impl,
+      bool mode, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->native_non_blocking(impl.io_uring_impl_, mode, ec)
+      : reactive_service_.native_non_blocking(impl.reactive_impl_, mode, ec);
+  }
+
+  // Wait for the socket to become ready to read, ready to write, or to have
+  // pending error conditions.
+  asio::error_code wait(implementation_type& impl,
+      socket_base::wait_type w, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->wait(impl.io_uring_impl_, w, ec)
+      : reactive_service_.wait(impl.reactive_impl_, w, ec);
+  }
+
+  // Asynchronously wait for the socket to become ready to read, ready to
+  // write, or to have pending error conditions.
+  template <typename Handler, typename IoExecutor>
+  void async_wait(implementation_type& impl, socket_base::wait_type w,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+      io_uring_service_->async_wait(impl.io_uring_impl_, w, handler, io_ex);
+    else
+      reactive_service_.async_wait(impl.reactive_impl_, w, handler, io_ex);
+  }
+
+  // Open a new socket implementation.
+  asio::error_code open(implementation_type& impl,
+      const protocol_type& protocol, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->open(impl.io_uring_impl_, protocol, ec)
+      : reactive_service_.open(impl.reactive_impl_, protocol, ec);
+  }
+
+  // Assign a native socket to a socket implementation.
+  asio::error_code assign(implementation_type& impl,
+      const protocol_type& protocol, const native_handle_type& native_socket,
+      asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->assign(impl.io_uring_impl_,
+          protocol, native_socket, ec)
+      : reactive_service_.assign(impl.reactive_impl_,
+          protocol, native_socket, ec);
+  }
+
+  // Bind the socket to the specified local endpoint.
+  asio::error_code bind(implementation_type& impl,
+      const endpoint_type& endpoint, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->bind(impl.io_uring_impl_, endpoint, ec)
+      : reactive_service_.bind(impl.reactive_impl_, endpoint, ec);
+  }
+
+  // Set a socket option.
+  template <typename Option>
+  asio::error_code set_option(implementation_type& impl,
+      const Option& option, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->set_option(impl.io_uring_impl_, option, ec)
+      : reactive_service_.set_option(impl.reactive_impl_, option, ec);
+  }
+
+  // Get a socket option.
+  template <typename Option>
+  asio::error_code get_option(const implementation_type& impl,
+      Option& option, asio::error_code& ec) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->get_option(impl.io_uring_impl_, option, ec)
+      : reactive_service_.get_option(impl.reactive_impl_, option, ec);
+  }
+
+  // Get the local endpoint.
+  endpoint_type local_endpoint(const implementation_type& impl,
+      asio::error_code& ec) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->local_endpoint(impl.io_uring_impl_, ec)
+      : reactive_service_.local_endpoint(impl.reactive_impl_, ec);
+  }
+
+  // Get the remote endpoint.
+  endpoint_type remote_endpoint(const implementation_type& impl,
+      asio::error_code& ec) const
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->remote_endpoint(impl.io_uring_impl_, ec)
+      : reactive_service_.remote_endpoint(impl.reactive_impl_, ec);
+  }
+
+  // Disable sends or receives on the socket.
+  asio::error_code shutdown(implementation_type& impl,
+      socket_base::shutdown_type what, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->shutdown(impl.io_uring_impl_, what, ec)
+      : reactive_service_.shutdown(impl.reactive_impl_, what, ec);
+  }
+
+  // Send the given data to the peer.
+  template <typename ConstBufferSequence>
+  size_t send(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->send(impl.io_uring_impl_, buffers, flags, ec)
+      : reactive_service_.send(impl.reactive_impl_, buffers, flags, ec);
+  }
+
+  // Start an asynchronous send. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send(implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_send(impl.io_uring_impl_,
+          buffers, flags, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_send(impl.reactive_impl_,
+          buffers, flags, handler, io_ex);
+    }
+  }
+
+  // Receive some data from the peer. Returns the number of bytes received.
+  template <typename MutableBufferSequence>
+  size_t receive(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags flags, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->receive(impl.io_uring_impl_, buffers, flags, ec)
+      : reactive_service_.receive(impl.reactive_impl_, buffers, flags, ec);
+  }
+
+  // Start an asynchronous receive. The buffer for the data being received
+  // must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive(implementation_type& impl,
+      const MutableBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_receive(impl.io_uring_impl_,
+          buffers, flags, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_receive(impl.reactive_impl_,
+          buffers, flags, handler, io_ex);
+    }
+  }
+
+  // Start a persistent receive. Only the reactor supports this operation, so
+  // on a socket that uses io_uring the handler is called once with an error.
+  template <typename BufferProvider, typename Handler, typename IoExecutor>
+  void async_receive_loop(implementation_type& impl,
+      BufferProvider& provider, Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      asio::error_code ec = asio::error::operation_not_supported;
+      const std::size_t bytes_transferred = 0;
+      asio::post(io_ex, detail::bind_handler(
+            handler, ec, bytes_transferred));
+    }
+    else
+    {
+      reactive_service_.async_receive_loop(
+          impl.reactive_impl_, provider, handler, io_ex);
+    }
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  // Start a persistent receive into buffers selected from a ring. Only
+  // io_uring supports this operation, so on a socket that uses the reactor the
+  // handler is called once with an error.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_provided(implementation_type& impl,
+      io_uring_buffer_ring& ring, Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_receive_provided(
+          impl.io_uring_impl_, ring, handler, io_ex);
+    }
+    else
+    {
+      asio::post(io_ex, detail::move_binder2<Handler,
+          asio::error_code, provided_buffer>(0,
+            ASIO_MOVE_CAST(Handler)(handler),
+            asio::error::operation_not_supported, provided_buffer()));
+    }
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  // Receive some data with associated flags. Returns the number of bytes
+  // received.
+  template <typename MutableBufferSequence>
+  size_t receive_with_flags(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags in_flags,
+      socket_base::message_flags& out_flags, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->receive_with_flags(impl.io_uring_impl_,
+          buffers, in_flags, out_flags, ec)
+      : reactive_service_.receive_with_flags(impl.reactive_impl_,
+          buffers, in_flags, out_flags, ec);
+  }
+
+  // Start an asynchronous receive. The buffer for the data being received
+  // must be valid for the lifetime of the asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_with_flags(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      socket_base::message_flags in_flags,
+      socket_base::message_flags& out_flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_receive_with_flags(impl.io_uring_impl_,
+          buffers, in_flags, out_flags, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_receive_with_flags(impl.reactive_impl_,
+          buffers, in_flags, out_flags, handler, io_ex);
+    }
+  }
+
+  // Send a datagram to the specified endpoint. Returns the number of bytes
+  // sent.
+  template <typename ConstBufferSequence>
+  size_t send_to(implementation_type& impl, const ConstBufferSequence& buffers,
+      const endpoint_type& destination, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->send_to(impl.io_uring_impl_,
+          buffers, destination, flags, ec)
+      : reactive_service_.send_to(impl.reactive_impl_,
+          buffers, destination, flags, ec);
+  }
+
+  // Start an asynchronous send. The data being sent must be valid for the
+  // lifetime of the asynchronous operation.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_to(implementation_type& impl,
+      const ConstBufferSequence& buffers,
+      const endpoint_type& destination, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_send_to(impl.io_uring_impl_,
+          buffers, destination, flags, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_send_to(impl.reactive_impl_,
+          buffers, destination, flags, handler, io_ex);
+    }
+  }
+
+  // Receive a datagram with the endpoint of the sender. Returns the number of
+  // bytes received.
+  template <typename MutableBufferSequence>
+  size_t receive_from(implementation_type& impl,
+      const MutableBufferSequence& buffers,
+      endpoint_type& sender_endpoint, socket_base::message_flags flags,
+      asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->receive_from(impl.io_uring_impl_,
+          buffers, sender_endpoint, flags, ec)
+      : reactive_service_.receive_from(impl.reactive_impl_,
+          buffers, sender_endpoint, flags, ec);
+  }
+
+  // Start an asynchronous receive. The buffer for the data being received and
+  // the sender_endpoint object must both be valid for the lifetime of the
+  // asynchronous operation.
+  template <typename MutableBufferSequence,
+      typename Handler, typename IoExecutor>
+  void async_receive_from(implementation_type& impl,
+      const MutableBufferSequence& buffers, endpoint_type& sender_endpoint,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_receive_from(impl.io_uring_impl_,
+          buffers, sender_endpoint, flags, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_receive_from(impl.reactive_impl_,
+          buffers, sender_endpoint, flags, handler, io_ex);
+    }
+  }
+
+  // Accept a new connection.
+  template <typename Socket>
+  asio::error_code accept(implementation_type& impl,
+      Socket& peer, endpoint_type* peer_endpoint, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->accept(impl.io_uring_impl_,
+          peer, peer_endpoint, ec)
+      : reactive_service_.accept(impl.reactive_impl_,
+          peer, peer_endpoint, ec);
+  }
+
+  // Start an asynchronous accept. The peer and peer_endpoint objects must be
+  // valid until the accept's handler is invoked.
+  template <typename Socket, typename Handler, typename IoExecutor>
+  void async_accept(implementation_type& impl, Socket& peer,
+      endpoint_type* peer_endpoint, Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_accept(impl.io_uring_impl_,
+          peer, peer_endpoint, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_accept(impl.reactive_impl_,
+          peer, peer_endpoint, handler, io_ex);
+    }
+  }
+
+#if defined(ASIO_HAS_MOVE)
+  // Start an asynchronous accept. The peer_endpoint object must be valid until
+  // the accept's handler is invoked.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_move_accept(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, endpoint_type* peer_endpoint,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_move_accept(impl.io_uring_impl_,
+          peer_io_ex, peer_endpoint, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_move_accept(impl.reactive_impl_,
+          peer_io_ex, peer_endpoint, handler, io_ex);
+    }
+  }
+
+  // Start an asynchronous accept of a batch of connections. Only the reactor
+  // supports this operation, so on a socket that uses io_uring the handler is
+  // called with an error and no connections.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_accept_many(implementation_type& impl,
+      std::size_t max_connections, const PeerIoExecutor& peer_io_ex,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      typedef typename Protocol::socket::template rebind_executor<
+        PeerIoExecutor>::other peer_socket_type;
+
+      asio::post(io_ex, detail::move_binder2<Handler,
+          asio::error_code, std::vector<peer_socket_type> >(0,
+            ASIO_MOVE_CAST(Handler)(handler),
+            asio::error::operation_not_supported,
+            std::vector<peer_socket_type>()));
+    }
+    else
+    {
+      reactive_service_.async_accept_many(impl.reactive_impl_,
+          max_connections, peer_io_ex, handler, io_ex);
+    }
+  }
+
+  // Start a persistent accept. Only io_uring supports this operation, so on a
+  // socket that uses the reactor the handler is called once with an error.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_accept_loop(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_accept_loop(impl.io_uring_impl_,
+          peer_io_ex, handler, io_ex);
+    }
+    else
+    {
+      typedef typename Protocol::socket::template rebind_executor<
+        PeerIoExecutor>::other peer_socket_type;
+
+      asio::post(io_ex, detail::move_binder2<Handler,
+          asio::error_code, peer_socket_type>(0,
+            ASIO_MOVE_CAST(Handler)(handler),
+            asio::error::operation_not_supported,
+            peer_socket_type(peer_io_ex)));
+    }
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
+  // Connect the socket to the specified endpoint.
+  asio::error_code connect(implementation_type& impl,
+      const endpoint_type& peer_endpoint, asio::error_code& ec)
+  {
+    return impl.uses_io_uring_
+      ? io_uring_service_->connect(impl.io_uring_impl_, peer_endpoint, ec)
+      : reactive_service_.connect(impl.reactive_impl_, peer_endpoint, ec);
+  }
+
+  // Start an asynchronous connect.
+  template <typename Handler, typename IoExecutor>
+  void async_connect(implementation_type& impl,
+      const endpoint_type& peer_endpoint,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    if (impl.uses_io_uring_)
+    {
+      io_uring_service_->async_connect(impl.io_uring_impl_,
+          peer_endpoint, handler, io_ex);
+    }
+    else
+    {
+      reactive_service_.async_connect(impl.reactive_impl_,
+          peer_endpoint, handler, io_ex);
+    }
+  }
+
+private:
+  // Services for other protocol types are used for converting moves.
+  template <typename> friend class dual_socket_service;
+
+  // The service used for sockets on the reactor.
+  reactive_service_type& reactive_service_;
+
+  // The service used for sockets on io_uring, or 0 if the reactor is used.
+  io_uring_service_type* io_uring_service_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+#endif // ASIO_DETAIL_DUAL_SOCKET_SERVICE_HPP
@@ -19,14 +19,20 @@
 
 #if defined(ASIO_HAS_EPOLL)
 
+#include <vector>
+#include <sys/epoll.h>
 #include "asio/detail/atomic_count.hpp"
+#include "asio/detail/atomic_op_slot.hpp"
+#include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/object_pool.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/scheduler_task.hpp"
 #include "asio/detail/select_interrupter.hpp"
+#include "asio/detail/slab_object_pool.hpp"
 #include "asio/detail/socket_types.hpp"
 #include "asio/detail/timer_queue_base.hpp"
 #include "asio/detail/timer_queue_set.hpp"
@@ -39,6 +45,13 @@
 
 #include "asio/detail/push_options.hpp"
 
+// This #define may be overridden at compile time to specify the largest number
+// of events that the reactor collects in one call to epoll_wait. The number
+// collected adapts to the load, up to this limit.
+#if !defined(ASIO_EPOLL_MAX_EVENTS)
+# define ASIO_EPOLL_MAX_EVENTS 1024
+#endif // !defined(ASIO_EPOLL_MAX_EVENTS)
+
 namespace asio {
 namespace detail {
 
@@ -54,6 +67,14 @@ public:
   enum op_types { read_op = 0, write_op = 1,
     connect_op = 1, except_op = 2, max_ops = 3 };
 
+  class shard_state;
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // Holds the one outstanding operation of a type on a descriptor, or records
+  // whether the descriptor may be ready, when lock-free descriptors are used.
+  typedef atomic_op_slot<reactor_op> op_slot;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   // Per-descriptor queues.
   class descriptor_state : operation
   {
@@ -67,13 +88,34 @@ public:
     epoll_reactor* reactor_;
     int descriptor_;
     uint32_t registered_events_;
+    bool registration_pending_;
     op_queue<reactor_op> op_queue_[max_ops];
     bool try_speculative_[max_ops];
     bool shutdown_;
+    shard_state* shard_;
+    bool shard_pinned_;
+    int io_quota_;
+    int io_quota_used_;
+    bool deferred_;
+    uint32_t deferred_events_;
+    descriptor_state* next_deferred_;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    std::atomic<int64_t> ready_usec_;
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    int64_t ready_usec_;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    bool lockfree_;
+    op_slot slot_[max_ops];
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
 
     ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
     void add_ready_events(uint32_t events) { task_result_ |= events; }
+    bool io_quota_spent() const
+    {
+      return io_quota_ != 0 && io_quota_used_ >= io_quota_;
+    }
     ASIO_DECL operation* perform_io(uint32_t events);
     ASIO_DECL static void do_complete(
         void* owner, operation* base,
@@ -83,6 +125,40 @@ public:
   // Per-descriptor data.
   typedef descriptor_state* per_descriptor_data;
 
+  // Per-thread epoll instance used when the reactor is sharded. The thread
+  // that owns the shard waits on it directly when idle. At other times the
+  // shard is registered, one-shot, with the shared epoll instance, and is
+  // queued as an operation that collects the ready descriptors when it is
+  // signalled.
+  class shard_state : operation
+  {
+    friend class epoll_reactor;
+
+    epoll_reactor* reactor_;
+    int epoll_fd_;
+    std::size_t index_;
+    bool rearm_;
+
+    // Whether the shard operation is queued, or its descriptors are.
+    // Protected by the reactor's mutex.
+    bool queued_;
+
+    // Whether the owning thread is waiting on the shard directly. Protected by
+    // the reactor's mutex.
+    bool waiting_;
+
+    // The shard's own event buffer and batch size, adapted as for the shared
+    // epoll instance. Used only by the thread waiting on the shard.
+    std::vector<epoll_event> event_buffer_;
+    int event_batch_;
+    int sparse_waits_;
+
+    ASIO_DECL shard_state();
+    ASIO_DECL static void do_complete(
+        void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+  };
+
   // Constructor.
   ASIO_DECL epoll_reactor(asio::execution_context& ctx);
 
@@ -154,6 +230,15 @@ public:
   ASIO_DECL void cleanup_descriptor_data(
       per_descriptor_data& descriptor_data);
 
+  // Set the number of operations performed on the descriptor each time it is
+  // found ready. Zero means no limit.
+  ASIO_DECL asio::error_code set_io_quota(
+      per_descriptor_data& descriptor_data, int quota);
+
+  // Get the number of operations performed on the descriptor each time it is
+  // found ready.
+  ASIO_DECL int io_quota(const per_descriptor_data& descriptor_data);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
@@ -194,10 +279,68 @@ public:
   // Interrupt the select loop.
   ASIO_DECL void interrupt();
 
+  // Wait on the shard owned by the thread with the given index, until its
+  // descriptors are ready or the wait is interrupted.
+  ASIO_DECL bool run_thread(std::size_t index, op_queue<operation>& ops);
+
+  // Interrupt a wait on the shard owned by a thread.
+  ASIO_DECL void interrupt_thread(std::size_t index);
+
+  // Get the number of calls to epoll_wait.
+  std::size_t waits() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(waits_));
+  }
+
+  // Get the number of calls to epoll_wait that returned no events.
+  std::size_t empty_waits() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(empty_waits_));
+  }
+
+  // Get the number of calls to epoll_wait that filled the event batch.
+  std::size_t full_waits() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(full_waits_));
+  }
+
+  // Get the total number of events returned by epoll_wait.
+  std::size_t events() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(events_));
+  }
+
+  // Get the total time, in microseconds, spent in epoll_wait.
+  uint64_t wait_usec() const
+  {
+    return static_cast<uint64_t>(wait_usec_);
+  }
+
+  // Get the number of dispatched descriptors whose delay was measured. The
+  // last descriptor found ready by each call to epoll_wait is measured.
+  std::size_t dispatch_samples() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(dispatch_samples_));
+  }
+
+  // Get the total time, in microseconds, from the measured descriptors being
+  // found ready to their being dispatched.
+  uint64_t dispatch_delay_usec() const
+  {
+    return static_cast<uint64_t>(dispatch_delay_usec_);
+  }
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
 
+  // The initial and smallest numbers of events collected by epoll_wait.
+  enum { initial_event_batch = 128, min_event_batch = 16 };
+
+  // The number of consecutive waits that use less than a quarter of the event
+  // batch before it is reduced.
+  enum { sparse_waits_to_shrink = 16 };
+
   // Create the epoll file descriptor. Throws an exception if the descriptor
   // cannot be created.
   ASIO_DECL static int do_epoll_create();
@@ -205,6 +348,87 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   ASIO_DECL static int do_timerfd_create();
 
+  // Get the current time in microseconds for the reactor's statistics.
+  ASIO_DECL static int64_t clock_usec();
+
+  // Update the statistics after a call to epoll_wait that collected up to
+  // max_events events. Returns the time at which the wait ended.
+  ASIO_DECL int64_t record_wait(int num_events,
+      int max_events, int64_t wait_start_usec);
+
+  // Update an event batch size after a call to epoll_wait, given the number
+  // of consecutive waits that used little of the batch.
+  ASIO_DECL static void adapt_event_batch(int num_events,
+      int& event_batch, int& sparse_waits);
+
+  // The type used for the statistics that total a time in microseconds. A
+  // long would overflow within an hour where it has 32 bits.
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  typedef std::atomic<uint64_t> usec_count;
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  typedef uint64_t usec_count;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+  // Add to a time statistic. Times are always zero where they cannot be added
+  // atomically, so the statistic is then never written.
+  static void add_usec(usec_count& total, int64_t usec)
+  {
+    if (usec > 0)
+      total += static_cast<uint64_t>(usec);
+  }
+
+  // Get the epoll file descriptor with which a descriptor is registered.
+  int descriptor_epoll_fd(descriptor_state* s) const
+  {
+    return s->shard_ ? s->shard_->epoll_fd_ : epoll_fd_;
+  }
+
+  // Choose the shard for a newly registered descriptor, creating its epoll
+  // instance if required. The requested index is used if it is not ~0.
+  // Returns 0 if the reactor is not sharded.
+  ASIO_DECL shard_state* assign_shard(std::size_t requested);
+
+  // Create the epoll instance of a shard and register it with the shared epoll
+  // instance.
+  ASIO_DECL void create_shard(shard_state& shard);
+
+  // Register, or re-enable, a shard with the shared epoll instance.
+  ASIO_DECL void arm_shard(shard_state& shard, int op);
+
+  // Wait for a shard's descriptors and add those that are ready to the queue.
+  ASIO_DECL void wait_shard(shard_state& shard,
+      int timeout, op_queue<operation>& ops);
+
+  // Collect the ready descriptors from a shard and post them to its thread.
+  ASIO_DECL void poll_shard(shard_state& shard);
+
+  // Whether an epoll event belongs to a shard.
+  bool is_shard(void* ptr) const
+  {
+    return shards_ && ptr >= static_cast<void*>(shards_)
+      && ptr < static_cast<void*>(shards_ + ASIO_SHARDED_REACTOR_MAX_SHARDS);
+  }
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // Start a new read or write operation on a descriptor that uses atomic op
+  // slots. The descriptor's mutex is acquired only if another operation of the
+  // same type is outstanding.
+  ASIO_DECL void start_lockfree_op(int op_type, socket_type descriptor,
+      per_descriptor_data& descriptor_data, reactor_op* op,
+      bool allow_speculative);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+  // Add a descriptor whose registration was deferred to the epoll set, with
+  // its registered events. The descriptor's mutex must be held.
+  ASIO_DECL asio::error_code register_pending_descriptor(
+      socket_type descriptor, descriptor_state* descriptor_data);
+
+  // Hand back the readiness of a descriptor that has used its I/O quota, to
+  // be dispatched again on the next pass of the reactor. The descriptor's
+  // mutex must be held.
+  ASIO_DECL void defer_descriptor(
+      descriptor_state* descriptor_data, uint32_t events);
+
   // Allocate a new descriptor state object.
   ASIO_DECL descriptor_state* allocate_descriptor_state();
 
@@ -252,11 +476,57 @@ private:
   // Whether the service has been shut down.
   bool shutdown_;
 
-  // Mutex to protect access to the registered descriptors.
+  // Mutex to protect access to the registered and deferred descriptors.
   mutex registered_descriptors_mutex_;
 
-  // Keep track of all registered descriptors.
+  // The descriptors that have used their I/O quota and are waiting for the
+  // next pass of the reactor, in the order in which they were deferred.
+  descriptor_state* first_deferred_;
+  descriptor_state* last_deferred_;
+
+  // Keep track of all registered descriptors. Unless disabled, they are kept
+  // in contiguous, cache line aligned chunks of memory.
+#if defined(ASIO_DISABLE_DESCRIPTOR_STATE_SLAB)
   object_pool<descriptor_state> registered_descriptors_;
+#else // defined(ASIO_DISABLE_DESCRIPTOR_STATE_SLAB)
+  slab_object_pool<descriptor_state> registered_descriptors_;
+#endif // defined(ASIO_DISABLE_DESCRIPTOR_STATE_SLAB)
+
+  // Whether descriptors are divided among per-thread epoll instances.
+  const bool sharded_;
+
+  // The number of descriptors that have been assigned to shards.
+  std::size_t next_shard_;
+
+  // The per-thread epoll instances, allocated only when the reactor is sharded
+  // and each created as it is first needed.
+  shard_state* shards_;
+
+  // Whether read and write operations are started using atomic op slots.
+  const bool lockfree_descriptors_;
+
+  // Whether descriptors are added to the epoll set only when first required.
+  const bool lazy_registration_;
+
+  // The buffer for events returned by epoll_wait, and the number of events
+  // to collect in the next call. Used only by the thread running the reactor.
+  std::vector<epoll_event> event_buffer_;
+  int event_batch_;
+
+  // The number of consecutive waits that used little of the event batch.
+  int sparse_waits_;
+
+  // Whether statistics are kept on the calls to epoll_wait.
+  const bool statistics_;
+
+  // Statistics on the calls to epoll_wait and on dispatching descriptors.
+  atomic_count waits_;
+  atomic_count empty_waits_;
+  atomic_count full_waits_;
+  atomic_count events_;
+  usec_count wait_usec_;
+  atomic_count dispatch_samples_;
+  usec_count dispatch_delay_usec_;
 
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
@@ -78,6 +78,7 @@ public:
     // Only the handler_tracking class will have access to the id. ֻо׷Ȩ޷id_
     friend class handler_tracking;
     friend class completion;
+    friend class handler_watchdog;
     uint64_t id_;   //u64 id
 
   protected:
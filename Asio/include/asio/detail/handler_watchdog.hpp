@@ -0,0 +1,210 @@
+//
+// detail/handler_watchdog.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_HANDLER_WATCHDOG_HPP
+#define ASIO_DETAIL_HANDLER_WATCHDOG_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+# if !defined(ASIO_HAS_THREADS) \
+  || !defined(ASIO_HAS_STD_ATOMIC) \
+  || !defined(ASIO_HAS_CHRONO)
+#  error ASIO_ENABLE_HANDLER_WATCHDOG requires threads, std::atomic and chrono
+# endif // !defined(ASIO_HAS_THREADS) ...
+# include <atomic>
+# include "asio/detail/cstdint.hpp"
+# include "asio/detail/noncopyable.hpp"
+# include "asio/detail/tss_ptr.hpp"
+#endif // defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+
+#include "asio/detail/push_options.hpp"
+
+// The time, in microseconds, that a handler may run before the watchdog
+// reports it.
+#if !defined(ASIO_HANDLER_WATCHDOG_THRESHOLD_USEC)
+# define ASIO_HANDLER_WATCHDOG_THRESHOLD_USEC 100000
+#endif // !defined(ASIO_HANDLER_WATCHDOG_THRESHOLD_USEC)
+
+namespace asio {
+namespace detail {
+
+#if defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+
+// Reports handlers that run for too long. Each thread that runs handlers owns
+// a slot recording the operation it is running, which is updated without
+// locking. A monitor thread looks at the slots periodically, and reports any
+// operation that it finds still running after the threshold has elapsed.
+//
+// The cost to each operation is a few uncontended stores. However, the monitor
+// thread means that a program which would otherwise have only one thread no
+// longer benefits from the C library's single-threaded fast paths, such as for
+// mutex locking, and this cost is usually the greater.
+class handler_watchdog
+{
+public:
+  // The record of the operation being run by a thread.
+  struct slot
+  {
+    // Incremented before and after the other fields are changed, so that the
+    // monitor can detect a torn read. An odd value means a change is underway.
+    std::atomic<std::size_t> sequence;
+
+    // The completion function of the operation being run, or null when the
+    // thread is not running an operation.
+    std::atomic<const void*> function;
+
+    // The handler tracking id of the operation being run, if known.
+    std::atomic<uint64_t> id;
+
+    // The following members are accessed only by the monitor thread.
+    std::size_t observed_sequence;
+    long observed_usec;
+    bool reported;
+
+    // The position of the slot in the list of slots.
+    std::size_t index;
+    slot* next;
+
+    // The next slot that is not owned by a thread. Protected by the mutex.
+    slot* next_free;
+  };
+
+  // Records that the calling thread is running an operation, for the lifetime
+  // of the object. Scopes may be nested, as when a strand runs its handlers
+  // inside an operation run by the scheduler. When an inner scope ends, the
+  // outer operation is timed afresh.
+  class scope
+    : private noncopyable
+  {
+  public:
+    template <typename Operation>
+    explicit scope(const Operation& op)
+      : slot_(handler_watchdog::current_slot()),
+        prev_function_(slot_->function.load(std::memory_order_relaxed)),
+        prev_id_(slot_->id.load(std::memory_order_relaxed))
+    {
+      handler_watchdog::update(*slot_,
+          handler_watchdog::function_of(op),
+          handler_watchdog::tracking_id_of(op));
+    }
+
+    ~scope()
+    {
+      handler_watchdog::update(*slot_, prev_function_, prev_id_);
+    }
+
+  private:
+    slot* slot_;
+    const void* prev_function_;
+    uint64_t prev_id_;
+  };
+
+  // Get the number of slots that have been created. Slots are reused once
+  // their threads exit.
+  ASIO_DECL static std::size_t slot_count();
+
+private:
+  struct watchdog_state;
+  struct slot_owner;
+
+  // Holds the calling thread's slot. This is a template so that the static
+  // member can be defined in a header file.
+  template <typename Slot>
+  struct thread_slot
+  {
+    static tss_ptr<Slot> ptr_;
+  };
+
+  // Get the slot for the calling thread, creating it if required.
+  static slot* current_slot()
+  {
+    if (slot* s = thread_slot<slot>::ptr_)
+      return s;
+    return create_slot();
+  }
+
+  // Create a slot for the calling thread, reusing one left by a thread that
+  // has exited if possible.
+  ASIO_DECL static slot* create_slot();
+
+  // Return a slot to the free list when its thread exits.
+  ASIO_DECL static void release_slot(slot* s);
+
+  // Change the operation recorded in a slot. Called only by the owning thread.
+  static void update(slot& s, const void* function, uint64_t id)
+  {
+    std::size_t sequence = s.sequence.load(std::memory_order_relaxed);
+    s.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.function.store(function, std::memory_order_relaxed);
+    s.id.store(id, std::memory_order_relaxed);
+    s.sequence.store(sequence + 2, std::memory_order_release);
+  }
+
+  // Get an identifier for the operation's handler type.
+  template <typename Operation>
+  static const void* function_of(const Operation& op)
+  {
+    return reinterpret_cast<const void*>(op.func_);
+  }
+
+  // Get the operation's handler tracking id, if handler tracking is enabled.
+  template <typename Operation>
+  static uint64_t tracking_id_of(const Operation& op)
+  {
+#if defined(ASIO_ENABLE_HANDLER_TRACKING) \
+  && !defined(ASIO_CUSTOM_HANDLER_TRACKING)
+    return op.id_;
+#else // defined(ASIO_ENABLE_HANDLER_TRACKING)
+      //   && !defined(ASIO_CUSTOM_HANDLER_TRACKING)
+    (void)op;
+    return 0;
+#endif // defined(ASIO_ENABLE_HANDLER_TRACKING)
+       //   && !defined(ASIO_CUSTOM_HANDLER_TRACKING)
+  }
+
+  // Look at every slot until the watchdog is destroyed.
+  ASIO_DECL static void monitor();
+
+  // Report an operation that has run for too long.
+  ASIO_DECL static void report(const slot& s, const void* function,
+      uint64_t id, long usec);
+
+  // Get the watchdog's shared state.
+  ASIO_DECL static watchdog_state& get_state();
+};
+
+template <typename Slot>
+tss_ptr<Slot> handler_watchdog::thread_slot<Slot>::ptr_;
+
+# define ASIO_HANDLER_WATCHDOG_SCOPE(args) \
+  asio::detail::handler_watchdog::scope watchdog_scope args
+
+#else // defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+
+# define ASIO_HANDLER_WATCHDOG_SCOPE(args) (void)0
+
+#endif // defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/handler_watchdog.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_DETAIL_HANDLER_WATCHDOG_HPP
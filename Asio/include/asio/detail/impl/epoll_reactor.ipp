@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <sys/epoll.h>
 #include "asio/detail/epoll_reactor.hpp"
+#include "asio/detail/reactor_shard_scope.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
@@ -44,7 +45,34 @@ epoll_reactor::epoll_reactor(asio::execution_context& ctx)
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    first_deferred_(0),
+    last_deferred_(0),
+    sharded_(ASIO_CONCURRENCY_HINT_IS_ENABLED(
+          SHARDED_REACTOR, scheduler_.concurrency_hint())),
+    next_shard_(0),
+    shards_(sharded_ ? new shard_state[ASIO_SHARDED_REACTOR_MAX_SHARDS] : 0),
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    lockfree_descriptors_(ASIO_CONCURRENCY_HINT_IS_ENABLED(
+          LOCKFREE_DESCRIPTORS, scheduler_.concurrency_hint())),
+#else // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    lockfree_descriptors_(false),
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    lazy_registration_(!lockfree_descriptors_
+        && ASIO_CONCURRENCY_HINT_IS_ENABLED(
+          LAZY_REGISTRATION, scheduler_.concurrency_hint())),
+    event_batch_(initial_event_batch < ASIO_EPOLL_MAX_EVENTS
+        ? initial_event_batch : ASIO_EPOLL_MAX_EVENTS),
+    sparse_waits_(0),
+    statistics_(ASIO_CONCURRENCY_HINT_IS_ENABLED(
+          REACTOR_STATISTICS, scheduler_.concurrency_hint())),
+    waits_(0),
+    empty_waits_(0),
+    full_waits_(0),
+    events_(0),
+    wait_usec_(0),
+    dispatch_samples_(0),
+    dispatch_delay_usec_(0)
 {
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
@@ -68,6 +96,13 @@ epoll_reactor::~epoll_reactor()
     close(epoll_fd_);
   if (timer_fd_ != -1)
     close(timer_fd_);
+  if (shards_)
+  {
+    for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+      if (shards_[i].epoll_fd_ != -1)
+        close(shards_[i].epoll_fd_);
+    delete[] shards_;
+  }
 }
 
 void epoll_reactor::shutdown()
@@ -81,10 +116,19 @@ void epoll_reactor::shutdown()
   while (descriptor_state* state = registered_descriptors_.first())
   {
     for (int i = 0; i < max_ops; ++i)
+    {
       ops.push(state->op_queue_[i]);
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+      op_slot::value_type slot = state->slot_[i].exchange(op_slot::queued);
+      if (op_slot::holds_op(slot))
+        ops.push(op_slot::to_op(slot));
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    }
     state->shutdown_ = true;
+    state->deferred_ = false;
     registered_descriptors_.free(state);
   }
+  first_deferred_ = last_deferred_ = 0;
 
   timer_queues_.get_all_timers(ops);
 
@@ -125,14 +169,29 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
+    // Recreate the shards and add them to epoll.
+    for (int i = 0; shards_ && i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+    {
+      if (shards_[i].epoll_fd_ != -1)
+      {
+        ::close(shards_[i].epoll_fd_);
+        shards_[i].epoll_fd_ = -1;
+        create_shard(shards_[i]);
+      }
+    }
+
     // Re-register all descriptors with epoll.
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
         state != 0; state = state->next_)
     {
+      if (state->registration_pending_)
+        continue;
+
       ev.events = state->registered_events_;
       ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
+      int result = epoll_ctl(descriptor_epoll_fd(state),
+          EPOLL_CTL_ADD, state->descriptor_, &ev);
       if (result != 0)
       {
         asio::error_code ec(errno,
@@ -152,6 +211,8 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     epoll_reactor::per_descriptor_data& descriptor_data)
 {
   descriptor_data = allocate_descriptor_state();
+  std::size_t requested_shard = reactor_shard_scope::current();
+  shard_state* shard = assign_shard(requested_shard);
 
   ASIO_HANDLER_REACTOR_REGISTRATION((
         context(), static_cast<uintmax_t>(descriptor),
@@ -163,15 +224,40 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+    descriptor_data->shard_ = shard;
+    descriptor_data->shard_pinned_ =
+      shard != 0 && requested_shard != ~static_cast<std::size_t>(0);
+    descriptor_data->registration_pending_ = lazy_registration_;
+    descriptor_data->io_quota_ = 0;
+    descriptor_data->io_quota_used_ = 0;
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    descriptor_data->lockfree_ = lockfree_descriptors_;
+    for (int i = 0; i < max_ops; ++i)
+      descriptor_data->slot_[i].store(op_slot::ready);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   }
 
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  // A write operation may be left in its slot without acquiring the mutex,
+  // so there is no opportunity to add EPOLLOUT when the first one blocks.
+  if (lockfree_descriptors_)
+    ev.events |= EPOLLOUT;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   descriptor_data->registered_events_ = ev.events;
+  if (lazy_registration_)
+  {
+    // The descriptor is added to the epoll set by the first operation that
+    // cannot complete immediately.
+    return 0;
+  }
+
   ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  int result = epoll_ctl(descriptor_epoll_fd(descriptor_data),
+      EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
   {
     if (errno == EPERM)
@@ -181,6 +267,9 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
       // this descriptor to be used and fail later if an operation on it would
       // otherwise require a trip through the reactor.
       descriptor_data->registered_events_ = 0;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+      descriptor_data->lockfree_ = false;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
       return 0;
     }
     return errno;
@@ -205,9 +294,17 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+    descriptor_data->shard_ = 0;
+    descriptor_data->shard_pinned_ = false;
+    descriptor_data->registration_pending_ = false;
+    descriptor_data->io_quota_ = 0;
+    descriptor_data->io_quota_used_ = 0;
     descriptor_data->op_queue_[op_type].push(op);
     for (int i = 0; i < max_ops; ++i)
       descriptor_data->try_speculative_[i] = true;
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    descriptor_data->lockfree_ = false;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -240,6 +337,15 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     return;
   }
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (descriptor_data->lockfree_ && op_type != except_op)
+  {
+    start_lockfree_op(op_type, descriptor,
+        descriptor_data, op, allow_speculative);
+    return;
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
   mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
   if (descriptor_data->shutdown_)
@@ -248,16 +354,26 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
     return;
   }
 
+  bool quota_spent = false;
   if (descriptor_data->op_queue_[op_type].empty())
   {
     if (allow_speculative
         && (op_type != read_op
           || descriptor_data->op_queue_[except_op].empty()))
     {
-      if (descriptor_data->try_speculative_[op_type])
+      if (descriptor_data->try_speculative_[op_type]
+          && descriptor_data->io_quota_spent())
+      {
+        // The operation is performed when the reactor next dispatches the
+        // descriptor, behind the other descriptors that are ready.
+        quota_spent = true;
+      }
+      else if (descriptor_data->try_speculative_[op_type])
       {
         if (reactor_op::status status = op->perform())
         {
+          if (descriptor_data->io_quota_ != 0)
+            ++descriptor_data->io_quota_used_;
           if (status == reactor_op::done_and_exhausted)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
@@ -274,14 +390,29 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
         return;
       }
 
-      if (op_type == write_op)
+      if (descriptor_data->registration_pending_)
+      {
+        if (op_type == write_op)
+          descriptor_data->registered_events_ |= EPOLLOUT;
+
+        asio::error_code ec = register_pending_descriptor(
+            descriptor, descriptor_data);
+        if (ec)
+        {
+          op->ec_ = ec;
+          scheduler_.post_immediate_completion(op, is_continuation);
+          return;
+        }
+      }
+      else if (op_type == write_op)
       {
         if ((descriptor_data->registered_events_ & EPOLLOUT) == 0)
         {
           epoll_event ev = { 0, { 0 } };
           ev.events = descriptor_data->registered_events_ | EPOLLOUT;
           ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
+          if (epoll_ctl(descriptor_epoll_fd(descriptor_data),
+                EPOLL_CTL_MOD, descriptor, &ev) == 0)
           {
             descriptor_data->registered_events_ |= ev.events;
           }
@@ -308,17 +439,119 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
         descriptor_data->registered_events_ |= EPOLLOUT;
       }
 
-      epoll_event ev = { 0, { 0 } };
-      ev.events = descriptor_data->registered_events_;
-      ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+      if (descriptor_data->registration_pending_)
+      {
+        asio::error_code ec = register_pending_descriptor(
+            descriptor, descriptor_data);
+        if (ec)
+        {
+          op->ec_ = ec;
+          scheduler_.post_immediate_completion(op, is_continuation);
+          return;
+        }
+      }
+      else
+      {
+        epoll_event ev = { 0, { 0 } };
+        ev.events = descriptor_data->registered_events_;
+        ev.data.ptr = descriptor_data;
+        epoll_ctl(descriptor_epoll_fd(descriptor_data),
+            EPOLL_CTL_MOD, descriptor, &ev);
+      }
     }
   }
 
   descriptor_data->op_queue_[op_type].push(op);
   scheduler_.work_started();
+
+  if (quota_spent)
+  {
+    defer_descriptor(descriptor_data, op_type == read_op ? EPOLLIN
+        : (op_type == write_op ? EPOLLOUT : EPOLLPRI));
+  }
 }
 
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+void epoll_reactor::start_lockfree_op(int op_type, socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data, reactor_op* op,
+    bool allow_speculative)
+{
+  // The operation is counted as work before any other thread can see it, so
+  // every completion below is a deferred one.
+  scheduler_.work_started();
+
+  op_slot& slot = descriptor_data->slot_[op_type];
+  for (;;)
+  {
+    op_slot::value_type state = slot.load();
+    if (allow_speculative && state == op_slot::ready)
+    {
+      // Claim the readiness and perform the operation. If it cannot complete,
+      // the slot is now empty and the operation is left there instead.
+      if (slot.compare_exchange(state, op_slot::empty))
+      {
+        if (reactor_op::status status = op->perform())
+        {
+          if (status != reactor_op::done_and_exhausted)
+          {
+            state = op_slot::empty;
+            slot.compare_exchange(state, op_slot::ready);
+          }
+          scheduler_.post_deferred_completion(op);
+          return;
+        }
+      }
+    }
+    else if (allow_speculative && state == op_slot::empty)
+    {
+      // The reactor performs the operation when the descriptor becomes ready.
+      if (slot.compare_exchange(state, op_slot::from_op(op)))
+        return;
+    }
+    else
+    {
+      mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+      if (descriptor_data->shutdown_)
+      {
+        descriptor_lock.unlock();
+        scheduler_.post_deferred_completion(op);
+        return;
+      }
+
+      // Only a thread holding the mutex may change a slot that is queued or
+      // that holds an operation.
+      state = slot.load();
+      if (state == op_slot::queued)
+      {
+        descriptor_data->op_queue_[op_type].push(op);
+        return;
+      }
+      else if (op_slot::holds_op(state))
+      {
+        descriptor_data->op_queue_[op_type].push(op_slot::to_op(state));
+        descriptor_data->op_queue_[op_type].push(op);
+        descriptor_data->try_speculative_[op_type] = false;
+        slot.store(op_slot::queued);
+        return;
+      }
+      else if (!allow_speculative
+          && slot.compare_exchange(state, op_slot::from_op(op)))
+      {
+        // Have epoll report the descriptor's current readiness again, now
+        // that the operation is where the reactor will find it.
+        epoll_event ev = { 0, { 0 } };
+        ev.events = descriptor_data->registered_events_;
+        ev.data.ptr = descriptor_data;
+        epoll_ctl(descriptor_epoll_fd(descriptor_data),
+            EPOLL_CTL_MOD, descriptor, &ev);
+        return;
+      }
+    }
+  }
+}
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
 void epoll_reactor::cancel_ops(socket_type,
     epoll_reactor::per_descriptor_data& descriptor_data)
 {
@@ -336,6 +569,24 @@ void epoll_reactor::cancel_ops(socket_type,
       descriptor_data->op_queue_[i].pop();
       ops.push(op);
     }
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    if (descriptor_data->lockfree_ && i != except_op)
+    {
+      op_slot::value_type state = descriptor_data->slot_[i].load();
+      if (op_slot::holds_op(state))
+      {
+        reactor_op* op = op_slot::to_op(state);
+        op->ec_ = asio::error::operation_aborted;
+        ops.push(op);
+        descriptor_data->slot_[i].store(op_slot::empty);
+      }
+      else if (state == op_slot::queued && !descriptor_data->shutdown_)
+      {
+        descriptor_data->slot_[i].store(descriptor_data->try_speculative_[i]
+            ? op_slot::ready : op_slot::empty);
+      }
+    }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
   }
 
   descriptor_lock.unlock();
@@ -366,6 +617,29 @@ void epoll_reactor::cancel_ops_by_key(socket_type,
       other_ops.push(op);
   }
   descriptor_data->op_queue_[op_type].push(other_ops);
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (descriptor_data->lockfree_ && op_type != except_op)
+  {
+    op_slot::value_type state = descriptor_data->slot_[op_type].load();
+    if (op_slot::holds_op(state))
+    {
+      reactor_op* op = op_slot::to_op(state);
+      if (op->cancellation_key_ == cancellation_key)
+      {
+        op->ec_ = asio::error::operation_aborted;
+        ops.push(op);
+        descriptor_data->slot_[op_type].store(op_slot::empty);
+      }
+    }
+    else if (state == op_slot::queued && !descriptor_data->shutdown_
+        && descriptor_data->op_queue_[op_type].empty())
+    {
+      descriptor_data->slot_[op_type].store(
+          descriptor_data->try_speculative_[op_type]
+            ? op_slot::ready : op_slot::empty);
+    }
+  }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
 
   descriptor_lock.unlock();
 
@@ -387,10 +661,12 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
       // The descriptor will be automatically removed from the epoll set when
       // it is closed.
     }
-    else if (descriptor_data->registered_events_ != 0)
+    else if (descriptor_data->registered_events_ != 0
+        && !descriptor_data->registration_pending_)
     {
       epoll_event ev = { 0, { 0 } };
-      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+      epoll_ctl(descriptor_epoll_fd(descriptor_data),
+          EPOLL_CTL_DEL, descriptor, &ev);
     }
 
     op_queue<operation> ops;
@@ -402,6 +678,18 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
         descriptor_data->op_queue_[i].pop();
         ops.push(op);
       }
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+      // Leave the slot queued, so that new operations find the descriptor
+      // has been shut down.
+      op_slot::value_type state =
+        descriptor_data->slot_[i].exchange(op_slot::queued);
+      if (op_slot::holds_op(state))
+      {
+        reactor_op* op = op_slot::to_op(state);
+        op->ec_ = asio::error::operation_aborted;
+        ops.push(op);
+      }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
     }
 
     descriptor_data->descriptor_ = -1;
@@ -473,6 +761,37 @@ void epoll_reactor::cleanup_descriptor_data(
   }
 }
 
+asio::error_code epoll_reactor::set_io_quota(
+    epoll_reactor::per_descriptor_data& descriptor_data, int quota)
+{
+  if (!descriptor_data)
+    return asio::error::bad_descriptor;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  // The quota cannot be enforced when operations are started without the
+  // mutex, or when the descriptor is dispatched by its shard's thread.
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (quota != 0 && descriptor_data->lockfree_)
+    return asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+  if (quota != 0 && descriptor_data->shard_)
+    return asio::error::operation_not_supported;
+
+  descriptor_data->io_quota_ = quota;
+  return asio::error_code();
+}
+
+int epoll_reactor::io_quota(
+    const epoll_reactor::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return 0;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+  return descriptor_data->io_quota_;
+}
+
 void epoll_reactor::run(long usec, op_queue<operation>& ops)
 {
   // This code relies on the fact that the scheduler queues the reactor task
@@ -496,8 +815,14 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   }
 
   // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  if (event_buffer_.size() < static_cast<std::size_t>(event_batch_))
+    event_buffer_.resize(event_batch_);
+  epoll_event* events = &event_buffer_[0];
+  int64_t wait_start_usec = statistics_ ? clock_usec() : 0;
+  int num_events = epoll_wait(epoll_fd_, events, event_batch_, timeout);
+  int64_t ready_usec = statistics_
+    ? record_wait(num_events, event_batch_, wait_start_usec) : 0;
+  adapt_event_batch(num_events, event_batch_, sparse_waits_);
 
 #if defined(ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -514,6 +839,10 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       // Ignore.
     }
 # endif // defined(ASIO_HAS_TIMERFD)
+    else if (is_shard(ptr))
+    {
+      // Ignore.
+    }
     else
     {
       unsigned event_mask = 0;
@@ -534,8 +863,10 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
 #else // defined(ASIO_HAS_TIMERFD)
   bool check_timers = true;
 #endif // defined(ASIO_HAS_TIMERFD)
+  bool check_deferred = false;
 
   // Dispatch the waiting events.
+  descriptor_state* last_ready = 0;
   for (int i = 0; i < num_events; ++i)
   {
     void* ptr = events[i].data.ptr;
@@ -546,6 +877,8 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       // to make it so that we only get woken up when the descriptor's epoll
       // registration is updated.
 
+      check_deferred = true;
+
 #if defined(ASIO_HAS_TIMERFD)
       if (timer_fd_ == -1)
         check_timers = true;
@@ -559,6 +892,27 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       check_timers = true;
     }
 #endif // defined(ASIO_HAS_TIMERFD)
+    else if (is_shard(ptr))
+    {
+      // The shard is not enabled again until its descriptors have been
+      // collected. If the owning thread has since started waiting on the shard
+      // itself, or has already queued it, the event is stale.
+      shard_state* shard = static_cast<shard_state*>(ptr);
+      mutex::scoped_lock lock(mutex_);
+      if (shard->waiting_ || shard->queued_)
+        continue;
+      shard->queued_ = true;
+      lock.unlock();
+      if (shard->index_ == scheduler_.this_thread_index())
+        ops.push(shard);
+      else
+      {
+        op_queue<operation> shard_ops;
+        shard_ops.push(shard);
+        scheduler_.post_deferred_completions_to_thread(
+            shard->index_, shard_ops);
+      }
+    }
     else
     {
       // The descriptor operation doesn't count as work in and of itself, so we
@@ -569,6 +923,7 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
       {
         descriptor_data->set_ready_events(events[i].events);
         ops.push(descriptor_data);
+        last_ready = descriptor_data;
       }
       else
       {
@@ -577,6 +932,36 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     }
   }
 
+  // Only the last descriptor is timed from being found ready to being
+  // dispatched, as it waits behind all of the others.
+  if (last_ready && ready_usec)
+    last_ready->ready_usec_ = ready_usec;
+
+  // Descriptors that used their I/O quota are dispatched behind those that
+  // have just been found ready. The interrupter is signalled when the first
+  // one is deferred. As with the descriptors above, they cannot still be
+  // queued from an earlier pass.
+  if (check_deferred)
+  {
+    mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+    while (descriptor_state* descriptor_data = first_deferred_)
+    {
+      first_deferred_ = descriptor_data->next_deferred_;
+      descriptor_data->next_deferred_ = 0;
+      descriptor_data->deferred_ = false;
+      if (!ops.is_enqueued(descriptor_data))
+      {
+        descriptor_data->set_ready_events(descriptor_data->deferred_events_);
+        ops.push(descriptor_data);
+      }
+      else
+      {
+        descriptor_data->add_ready_events(descriptor_data->deferred_events_);
+      }
+    }
+    last_deferred_ = 0;
+  }
+
   if (check_timers)
   {
     mutex::scoped_lock common_lock(mutex_);
@@ -628,6 +1013,58 @@ int epoll_reactor::do_epoll_create()
   return fd;
 }
 
+int64_t epoll_reactor::clock_usec()
+{
+#if defined(ASIO_HAS_THREADS) && !defined(ASIO_HAS_STD_ATOMIC)
+  // Times are not recorded, as the counters cannot be added to in one step.
+  return 0;
+#else // defined(ASIO_HAS_THREADS) && !defined(ASIO_HAS_STD_ATOMIC)
+  timespec ts;
+  if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+    return 0;
+  return static_cast<int64_t>(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#endif // defined(ASIO_HAS_THREADS) && !defined(ASIO_HAS_STD_ATOMIC)
+}
+
+int64_t epoll_reactor::record_wait(int num_events,
+    int max_events, int64_t wait_start_usec)
+{
+  int64_t now = clock_usec();
+  ++waits_;
+  add_usec(wait_usec_, now - wait_start_usec);
+  if (num_events > 0)
+    increment(events_, num_events);
+  else
+    ++empty_waits_;
+  if (num_events >= max_events)
+    ++full_waits_;
+  return now;
+}
+
+void epoll_reactor::adapt_event_batch(int num_events,
+    int& event_batch, int& sparse_waits)
+{
+  // Collect more events next time if the batch was filled, and fewer once
+  // the batch has been mostly unused for a while.
+  if (num_events >= event_batch)
+  {
+    sparse_waits = 0;
+    event_batch = event_batch < ASIO_EPOLL_MAX_EVENTS / 2
+      ? event_batch * 2 : ASIO_EPOLL_MAX_EVENTS;
+  }
+  else if (num_events < event_batch / 4 && event_batch > min_event_batch)
+  {
+    if (++sparse_waits >= sparse_waits_to_shrink)
+    {
+      sparse_waits = 0;
+      event_batch = event_batch / 2 > min_event_batch
+        ? event_batch / 2 : min_event_batch;
+    }
+  }
+  else
+    sparse_waits = 0;
+}
+
 int epoll_reactor::do_timerfd_create()
 {
 #if defined(ASIO_HAS_TIMERFD)
@@ -651,6 +1088,237 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(ASIO_HAS_TIMERFD)
 }
 
+epoll_reactor::shard_state* epoll_reactor::assign_shard(
+    std::size_t requested)
+{
+  if (!sharded_)
+    return 0;
+
+  // Unless a shard is requested, descriptors are shared out in turn among the
+  // threads that have entered run(), or all go to the first shard if no thread
+  // has done so yet.
+  bool is_requested = requested != ~static_cast<std::size_t>(0);
+  std::size_t threads = is_requested ? 0 : scheduler_.run_thread_index_limit();
+
+  mutex::scoped_lock lock(mutex_);
+  std::size_t index = is_requested
+    ? requested : (threads ? next_shard_++ % threads : 0);
+  shard_state& shard = shards_[index % ASIO_SHARDED_REACTOR_MAX_SHARDS];
+  if (shard.epoll_fd_ == -1)
+  {
+    shard.reactor_ = this;
+    shard.index_ = index % ASIO_SHARDED_REACTOR_MAX_SHARDS;
+    create_shard(shard);
+  }
+  return &shard;
+}
+
+void epoll_reactor::create_shard(shard_state& shard)
+{
+  shard.epoll_fd_ = do_epoll_create();
+
+  // The interrupter is also added to the shard, so that the owning thread can
+  // be woken while it waits on the shard directly.
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLET;
+  ev.data.ptr = &interrupter_;
+  epoll_ctl(shard.epoll_fd_, EPOLL_CTL_ADD,
+      interrupter_.read_descriptor(), &ev);
+
+  arm_shard(shard, EPOLL_CTL_ADD);
+}
+
+void epoll_reactor::arm_shard(shard_state& shard, int op)
+{
+  // The shard is level-triggered, so it is reported again if it still has
+  // ready descriptors when it is re-enabled.
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLONESHOT;
+  ev.data.ptr = &shard;
+  epoll_ctl(epoll_fd_, op, shard.epoll_fd_, &ev);
+}
+
+bool epoll_reactor::run_thread(std::size_t index, op_queue<operation>& ops)
+{
+  if (!sharded_ || index >= ASIO_SHARDED_REACTOR_MAX_SHARDS)
+    return false;
+
+  // The shard is taken out of the shared epoll instance while its thread waits
+  // on it, unless it has already been reported there.
+  shard_state& shard = shards_[index];
+  mutex::scoped_lock lock(mutex_);
+  if (shard.epoll_fd_ == -1 || shard.queued_ || shutdown_)
+    return false;
+  shard.waiting_ = true;
+  epoll_event ev = { 0, { 0 } };
+  ev.data.ptr = &shard;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, shard.epoll_fd_, &ev);
+  lock.unlock();
+
+  wait_shard(shard, -1, ops);
+
+  lock.lock();
+  shard.waiting_ = false;
+  if (ops.empty())
+  {
+    arm_shard(shard, EPOLL_CTL_MOD);
+    return true;
+  }
+
+  // As in poll_shard(), the shard is queued behind its descriptors.
+  shard.queued_ = true;
+  shard.rearm_ = true;
+  ops.push(&shard);
+  return true;
+}
+
+void epoll_reactor::interrupt_thread(std::size_t index)
+{
+  if (!sharded_ || index >= ASIO_SHARDED_REACTOR_MAX_SHARDS)
+    return;
+
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLET;
+  ev.data.ptr = &interrupter_;
+  epoll_ctl(shards_[index].epoll_fd_, EPOLL_CTL_MOD,
+      interrupter_.read_descriptor(), &ev);
+}
+
+void epoll_reactor::wait_shard(shard_state& shard,
+    int timeout, op_queue<operation>& ops)
+{
+  if (shard.event_buffer_.size()
+      < static_cast<std::size_t>(shard.event_batch_))
+    shard.event_buffer_.resize(shard.event_batch_);
+  epoll_event* events = &shard.event_buffer_[0];
+  int64_t wait_start_usec = statistics_ ? clock_usec() : 0;
+  int num_events = epoll_wait(shard.epoll_fd_,
+      events, shard.event_batch_, timeout);
+  int64_t ready_usec = statistics_
+    ? record_wait(num_events, shard.event_batch_, wait_start_usec) : 0;
+  adapt_event_batch(num_events, shard.event_batch_, shard.sparse_waits_);
+
+  descriptor_state* last_ready = 0;
+  for (int i = 0; i < num_events; ++i)
+  {
+    if (events[i].data.ptr == &interrupter_)
+      continue;
+
+    descriptor_state* descriptor_data =
+      static_cast<descriptor_state*>(events[i].data.ptr);
+
+#if defined(ASIO_ENABLE_HANDLER_TRACKING)
+    unsigned event_mask = 0;
+    if ((events[i].events & EPOLLIN) != 0)
+      event_mask |= ASIO_HANDLER_REACTOR_READ_EVENT;
+    if ((events[i].events & EPOLLOUT))
+      event_mask |= ASIO_HANDLER_REACTOR_WRITE_EVENT;
+    if ((events[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+      event_mask |= ASIO_HANDLER_REACTOR_ERROR_EVENT;
+    ASIO_HANDLER_REACTOR_EVENTS((context(),
+          reinterpret_cast<uintmax_t>(descriptor_data), event_mask));
+#endif // defined(ASIO_ENABLE_HANDLER_TRACKING)
+
+    if (!ops.is_enqueued(descriptor_data))
+    {
+      descriptor_data->set_ready_events(events[i].events);
+      ops.push(descriptor_data);
+      last_ready = descriptor_data;
+    }
+    else
+    {
+      descriptor_data->add_ready_events(events[i].events);
+    }
+  }
+
+  // As in run(), only the last descriptor is timed.
+  if (last_ready && ready_usec)
+    last_ready->ready_usec_ = ready_usec;
+}
+
+void epoll_reactor::poll_shard(shard_state& shard)
+{
+  // The shard operation doesn't count as work in and of itself, so we need to
+  // compensate for the work_finished() call that the scheduler will make once
+  // this operation returns.
+  scheduler_.compensating_work_started();
+
+  op_queue<operation> ops;
+  if (!shard.rearm_)
+    wait_shard(shard, 0, ops);
+
+  if (ops.empty())
+  {
+    // The shard is re-enabled while holding the mutex that is also acquired
+    // when it is next reported, so that its removal from the queue is seen
+    // before it is queued again.
+    mutex::scoped_lock lock(mutex_);
+    shard.rearm_ = false;
+    shard.queued_ = false;
+    arm_shard(shard, EPOLL_CTL_MOD);
+    return;
+  }
+
+  // As with the shared epoll instance, the shard must not be polled again
+  // until the descriptor operations have been dequeued, so the shard is queued
+  // behind them to re-enable itself.
+  shard.rearm_ = true;
+  ops.push(&shard);
+  scheduler_.post_deferred_completions_to_thread(shard.index_, ops);
+}
+
+asio::error_code epoll_reactor::register_pending_descriptor(
+    socket_type descriptor, epoll_reactor::descriptor_state* descriptor_data)
+{
+  epoll_event ev = { 0, { 0 } };
+  ev.events = descriptor_data->registered_events_;
+  ev.data.ptr = descriptor_data;
+  if (epoll_ctl(descriptor_epoll_fd(descriptor_data),
+        EPOLL_CTL_ADD, descriptor, &ev) != 0)
+  {
+    if (errno == EPERM)
+    {
+      // This file descriptor type is not supported by epoll. As with eager
+      // registration, operations that do not block may still be used.
+      descriptor_data->registered_events_ = 0;
+      descriptor_data->registration_pending_ = false;
+      return asio::error::operation_not_supported;
+    }
+    return asio::error_code(errno, asio::error::get_system_category());
+  }
+
+  descriptor_data->registration_pending_ = false;
+  return asio::error_code();
+}
+
+void epoll_reactor::defer_descriptor(
+    epoll_reactor::descriptor_state* descriptor_data, uint32_t events)
+{
+  mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+
+  if (descriptor_data->deferred_)
+  {
+    descriptor_data->deferred_events_ |= events;
+    return;
+  }
+
+  bool first = (first_deferred_ == 0);
+  descriptor_data->deferred_ = true;
+  descriptor_data->deferred_events_ = events;
+  descriptor_data->next_deferred_ = 0;
+  if (last_deferred_)
+    last_deferred_->next_deferred_ = descriptor_data;
+  else
+    first_deferred_ = descriptor_data;
+  last_deferred_ = descriptor_data;
+
+  descriptors_lock.unlock();
+
+  // Wake the reactor so that it collects the deferred descriptors.
+  if (first)
+    interrupt();
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
@@ -661,6 +1329,28 @@ epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
+
+  if (s->deferred_)
+  {
+    // Remove the descriptor from the deferred list so that its state is not
+    // dispatched after it has been reused.
+    descriptor_state* prev = 0;
+    descriptor_state* d = first_deferred_;
+    while (d != s)
+    {
+      prev = d;
+      d = d->next_deferred_;
+    }
+    if (prev)
+      prev->next_deferred_ = s->next_deferred_;
+    else
+      first_deferred_ = s->next_deferred_;
+    if (last_deferred_ == s)
+      last_deferred_ = prev;
+    s->next_deferred_ = 0;
+    s->deferred_ = false;
+  }
+
   registered_descriptors_.free(s);
 }
 
@@ -723,12 +1413,12 @@ struct epoll_reactor::perform_io_cleanup_on_block_exit
 
   ~perform_io_cleanup_on_block_exit()
   {
+    // Post the remaining completed operations for invocation.
+    if (!ops_.empty())
+      reactor_->scheduler_.post_deferred_completions(ops_);
+
     if (first_op_)
     {
-      // Post the remaining completed operations for invocation.
-      if (!ops_.empty())
-        reactor_->scheduler_.post_deferred_completions(ops_);
-
       // A user-initiated operation has completed, but there's no need to
       // explicitly call work_finished() here. Instead, we'll take advantage of
       // the fact that the scheduler will call work_finished() once we return.
@@ -749,7 +1439,19 @@ struct epoll_reactor::perform_io_cleanup_on_block_exit
 
 epoll_reactor::descriptor_state::descriptor_state(bool locking)
   : operation(&epoll_reactor::descriptor_state::do_complete),
-    mutex_(locking)
+    mutex_(locking),
+    registration_pending_(false),
+    shard_(0),
+    shard_pinned_(false),
+    io_quota_(0),
+    io_quota_used_(0),
+    deferred_(false),
+    deferred_events_(0),
+    next_deferred_(0),
+    ready_usec_(0)
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+    , lockfree_(false)
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
 {
 }
 
@@ -759,6 +1461,12 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   perform_io_cleanup_on_block_exit io_cleanup(reactor_);
   mutex::scoped_lock descriptor_lock(mutex_, mutex::scoped_lock::adopt_lock);
 
+  // A descriptor with an I/O quota performs at most that many operations each
+  // time it is dispatched. The readiness of the queues that still have
+  // operations is handed back to the reactor.
+  io_quota_used_ = 0;
+  uint32_t deferred_events = 0;
+
   // Exception operations must be processed first to ensure that any
   // out-of-band data is read before normal data.
   static const int flag[max_ops] = { EPOLLIN, EPOLLOUT, EPOLLPRI };
@@ -766,11 +1474,45 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
   {
     if (events & (flag[j] | EPOLLERR | EPOLLHUP))
     {
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+      op_slot::value_type state = op_slot::queued;
+      if (lockfree_ && j != except_op)
+        state = slot_[j].load();
+      if (state != op_slot::queued)
+      {
+        // Other threads may only replace an empty or ready slot, so either
+        // the readiness is recorded or the operation in the slot is claimed.
+        while (!op_slot::holds_op(state)
+            && !slot_[j].compare_exchange(state, op_slot::ready))
+        {
+        }
+
+        if (op_slot::holds_op(state))
+        {
+          reactor_op* op = op_slot::to_op(state);
+          if (reactor_op::status status = op->perform())
+          {
+            io_cleanup.ops_.push(op);
+            slot_[j].store(status == reactor_op::done_and_exhausted
+                ? op_slot::empty : op_slot::ready);
+          }
+        }
+        continue;
+      }
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
       try_speculative_[j] = true;
       while (reactor_op* op = op_queue_[j].front())
       {
+        if (io_quota_spent())
+        {
+          deferred_events |= events & (flag[j] | EPOLLERR | EPOLLHUP);
+          break;
+        }
+
         if (reactor_op::status status = op->perform())
         {
+          ++io_quota_used_;
           op_queue_[j].pop();
           io_cleanup.ops_.push(op);
           if (status == reactor_op::done_and_exhausted)
@@ -782,13 +1524,27 @@ operation* epoll_reactor::descriptor_state::perform_io(uint32_t events)
         else
           break;
       }
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
+
+      if (lockfree_ && j != except_op && !shutdown_ && op_queue_[j].empty())
+        slot_[j].store(try_speculative_[j] ? op_slot::ready : op_slot::empty);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_STD_ATOMIC)
     }
   }
 
-  // The first operation will be returned for completion now. The others will
-  // be posted for later by the io_cleanup object's destructor.
-  io_cleanup.first_op_ = io_cleanup.ops_.front();
-  io_cleanup.ops_.pop();
+  if (deferred_events)
+    reactor_->defer_descriptor(this, deferred_events);
+
+  // The first operation will be returned for completion now, unless it has
+  // been given a priority, in which case it must go through the scheduler's
+  // priority queues. The others will be posted for later by the io_cleanup
+  // object's destructor.
+  operation* first_op = io_cleanup.ops_.front();
+  if (first_op && first_op->priority() == operation::normal_priority)
+  {
+    io_cleanup.first_op_ = first_op;
+    io_cleanup.ops_.pop();
+  }
   return io_cleanup.first_op_;
 }
 
@@ -800,13 +1556,58 @@ void epoll_reactor::descriptor_state::do_complete(
   {
     descriptor_state* descriptor_data = static_cast<descriptor_state*>(base);
     uint32_t events = static_cast<uint32_t>(bytes_transferred);
-    if (operation* op = descriptor_data->perform_io(events))
+    epoll_reactor* reactor = descriptor_data->reactor_;
+    if (reactor->statistics_)
+    {
+      if (int64_t ready_usec = descriptor_data->ready_usec_)
+      {
+        descriptor_data->ready_usec_ = 0;
+        ++reactor->dispatch_samples_;
+        add_usec(reactor->dispatch_delay_usec_, clock_usec() - ready_usec);
+      }
+    }
+    if (descriptor_data->shard_pinned_)
+    {
+      // Descriptors registered while completing an operation on a descriptor
+      // that was placed on a shard, such as accepted sockets, join that shard.
+      reactor_shard_scope scope(descriptor_data->shard_->index_);
+      if (operation* op = descriptor_data->perform_io(events))
+      {
+        op->complete(owner, ec, 0);
+      }
+    }
+    else if (operation* op = descriptor_data->perform_io(events))
     {
       op->complete(owner, ec, 0);
     }
   }
 }
 
+epoll_reactor::shard_state::shard_state()
+  : operation(&epoll_reactor::shard_state::do_complete),
+    reactor_(0),
+    epoll_fd_(-1),
+    index_(0),
+    rearm_(false),
+    queued_(false),
+    waiting_(false),
+    event_batch_(initial_event_batch < ASIO_EPOLL_MAX_EVENTS
+        ? initial_event_batch : ASIO_EPOLL_MAX_EVENTS),
+    sparse_waits_(0)
+{
+}
+
+void epoll_reactor::shard_state::do_complete(
+    void* owner, operation* base,
+    const asio::error_code& /*ec*/, std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    shard_state* shard = static_cast<shard_state*>(base);
+    shard->reactor_->poll_shard(*shard);
+  }
+}
+
 } // namespace detail
 } // namespace asio
 
@@ -0,0 +1,248 @@
+//
+// detail/impl/handler_watchdog.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_HANDLER_WATCHDOG_IPP
+#define ASIO_DETAIL_IMPL_HANDLER_WATCHDOG_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+
+#include <cstdio>
+#include "asio/detail/chrono.hpp"
+#include "asio/detail/event.hpp"
+#include "asio/detail/handler_watchdog.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/thread.hpp"
+
+#if defined(ASIO_WINDOWS_RUNTIME)
+# include "asio/detail/socket_types.hpp"
+#elif !defined(ASIO_WINDOWS)
+# include <unistd.h>
+#endif // !defined(ASIO_WINDOWS)
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+struct handler_watchdog::watchdog_state
+{
+  watchdog_state()
+    : slots_(0),
+      free_slots_(0),
+      slot_count_(0),
+      stopped_(false),
+      monitor_(0)
+  {
+  }
+
+  // Stop the monitor thread. The slots are not freed, as threads that have
+  // not yet exited may still be using them.
+  ~watchdog_state()
+  {
+    asio::detail::mutex::scoped_lock lock(mutex_);
+    stopped_ = true;
+    wakeup_.signal(lock);
+    lock.unlock();
+
+    if (monitor_)
+    {
+      monitor_->join();
+      delete monitor_;
+    }
+  }
+
+  asio::detail::mutex mutex_;
+  asio::detail::event wakeup_;
+  slot* slots_;
+  slot* free_slots_;
+  std::size_t slot_count_;
+  bool stopped_;
+  asio::detail::thread* monitor_;
+};
+
+// Returns the calling thread's slot to the free list when the thread exits.
+struct handler_watchdog::slot_owner
+{
+  slot_owner()
+    : slot_(0)
+  {
+  }
+
+  ~slot_owner()
+  {
+    if (slot_)
+      handler_watchdog::release_slot(slot_);
+  }
+
+  slot* slot_;
+};
+
+handler_watchdog::slot* handler_watchdog::create_slot()
+{
+  watchdog_state& state = get_state();
+
+  asio::detail::mutex::scoped_lock lock(state.mutex_);
+  slot* s = state.free_slots_;
+  if (s)
+  {
+    // The slot is idle, and remains on the list looked at by the monitor.
+    state.free_slots_ = s->next_free;
+  }
+  else
+  {
+    s = new slot;
+    s->sequence.store(0, std::memory_order_relaxed);
+    s->function.store(0, std::memory_order_relaxed);
+    s->id.store(0, std::memory_order_relaxed);
+    s->observed_sequence = 0;
+    s->observed_usec = 0;
+    s->reported = false;
+    s->index = state.slot_count_++;
+    s->next = state.slots_;
+    state.slots_ = s;
+  }
+  s->next_free = 0;
+  if (!state.monitor_ && !state.stopped_)
+    state.monitor_ = new asio::detail::thread(&handler_watchdog::monitor);
+  lock.unlock();
+
+  static thread_local slot_owner owner;
+  owner.slot_ = s;
+  thread_slot<slot>::ptr_ = s;
+  return s;
+}
+
+void handler_watchdog::release_slot(slot* s)
+{
+  watchdog_state& state = get_state();
+
+  asio::detail::mutex::scoped_lock lock(state.mutex_);
+  s->next_free = state.free_slots_;
+  state.free_slots_ = s;
+}
+
+std::size_t handler_watchdog::slot_count()
+{
+  watchdog_state& state = get_state();
+
+  asio::detail::mutex::scoped_lock lock(state.mutex_);
+  return state.slot_count_;
+}
+
+void handler_watchdog::monitor()
+{
+  watchdog_state& state = get_state();
+  const long threshold = ASIO_HANDLER_WATCHDOG_THRESHOLD_USEC;
+
+  asio::detail::mutex::scoped_lock lock(state.mutex_);
+  while (!state.stopped_)
+  {
+    state.wakeup_.clear(lock);
+    state.wakeup_.wait_for_usec(lock, threshold / 4 > 0 ? threshold / 4 : 1);
+    if (state.stopped_)
+      break;
+
+    long now = static_cast<long>(
+        chrono::duration_cast<chrono::microseconds>(
+          chrono::steady_clock::now().time_since_epoch()).count());
+
+    for (slot* s = state.slots_; s; s = s->next)
+    {
+      // Take a consistent snapshot of the slot, or try again next time.
+      std::size_t sequence = s->sequence.load(std::memory_order_acquire);
+      if (sequence & 1)
+        continue;
+      const void* function = s->function.load(std::memory_order_relaxed);
+      uint64_t id = s->id.load(std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (s->sequence.load(std::memory_order_relaxed) != sequence)
+        continue;
+
+      if (function == 0 || sequence != s->observed_sequence)
+      {
+        // The thread is idle, or has started another operation since the slot
+        // was last looked at.
+        s->observed_sequence = sequence;
+        s->observed_usec = now;
+        s->reported = false;
+      }
+      else if (!s->reported && now - s->observed_usec >= threshold)
+      {
+        report(*s, function, id, now - s->observed_usec);
+        s->reported = true;
+      }
+    }
+  }
+}
+
+void handler_watchdog::report(const slot& s,
+    const void* function, uint64_t id, long usec)
+{
+  using namespace std; // For sprintf (or equivalent).
+
+  char line[256] = "";
+  int length = 0;
+  if (id != 0)
+  {
+#if defined(ASIO_HAS_SECURE_RTL)
+    length = sprintf_s(line, sizeof(line),
+#else // defined(ASIO_HAS_SECURE_RTL)
+    length = sprintf(line,
+#endif // defined(ASIO_HAS_SECURE_RTL)
+        "asio watchdog: handler %p (id %llu) on thread %u"
+        " has run for %ldms\n",
+        function, static_cast<unsigned long long>(id),
+        static_cast<unsigned>(s.index), usec / 1000);
+  }
+  else
+  {
+#if defined(ASIO_HAS_SECURE_RTL)
+    length = sprintf_s(line, sizeof(line),
+#else // defined(ASIO_HAS_SECURE_RTL)
+    length = sprintf(line,
+#endif // defined(ASIO_HAS_SECURE_RTL)
+        "asio watchdog: handler %p on thread %u has run for %ldms\n",
+        function, static_cast<unsigned>(s.index), usec / 1000);
+  }
+
+#if defined(ASIO_WINDOWS_RUNTIME)
+  wchar_t wline[256] = L"";
+  mbstowcs_s(0, wline, sizeof(wline) / sizeof(wchar_t), line, length);
+  ::OutputDebugStringW(wline);
+#elif defined(ASIO_WINDOWS)
+  HANDLE stderr_handle = ::GetStdHandle(STD_ERROR_HANDLE);
+  DWORD bytes_written = 0;
+  ::WriteFile(stderr_handle, line, length, &bytes_written, 0);
+#else // defined(ASIO_WINDOWS)
+  ssize_t result = ::write(STDERR_FILENO, line, length);
+  (void)result;
+#endif // defined(ASIO_WINDOWS)
+}
+
+handler_watchdog::watchdog_state& handler_watchdog::get_state()
+{
+  static watchdog_state state;
+  return state;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+
+#endif // ASIO_DETAIL_IMPL_HANDLER_WATCHDOG_IPP
@@ -0,0 +1,93 @@
+//
+// detail/impl/io_backend_selector.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_IO_BACKEND_SELECTOR_IPP
+#define ASIO_DETAIL_IMPL_IO_BACKEND_SELECTOR_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+
+#include <cstdlib>
+#include <cstring>
+#include "asio/detail/concurrency_hint.hpp"
+#include "asio/detail/io_backend_selector.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/system_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+io_backend_selector::io_backend_selector(asio::execution_context& ctx)
+  : execution_context_service_base<io_backend_selector>(ctx),
+    io_uring_service_(0)
+{
+  if (!io_uring_requested(use_service<scheduler>(ctx).concurrency_hint()))
+    return;
+
+  // Probe first, so that a kernel without io_uring, or a seccomp filter that
+  // blocks it, results in the reactor being used even without exceptions.
+  if (!io_uring_supported())
+    return;
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  try
+  {
+    io_uring_service_ = &use_service<io_uring_service>(ctx);
+  }
+  catch (const asio::system_error&)
+  {
+    // The full-sized ring could not be created. Use the reactor instead.
+  }
+#else // !defined(ASIO_NO_EXCEPTIONS)
+  io_uring_service_ = &use_service<io_uring_service>(ctx);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+}
+
+void io_backend_selector::shutdown()
+{
+}
+
+bool io_backend_selector::io_uring_requested(int concurrency_hint)
+{
+  if (const char* backend = std::getenv("ASIO_IO_BACKEND"))
+  {
+    if (std::strcmp(backend, "io_uring") == 0)
+      return true;
+    if (std::strcmp(backend, "epoll") == 0)
+      return false;
+  }
+
+  return ASIO_CONCURRENCY_HINT_IS_ENABLED(IO_URING, concurrency_hint);
+}
+
+bool io_backend_selector::io_uring_supported()
+{
+  ::io_uring ring;
+  if (::io_uring_queue_init(1, &ring, 0) < 0)
+    return false;
+  ::io_uring_queue_exit(&ring);
+  return true;
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+#endif // ASIO_DETAIL_IMPL_IO_BACKEND_SELECTOR_IPP
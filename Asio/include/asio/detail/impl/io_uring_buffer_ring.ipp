@@ -0,0 +1,91 @@
+//
+// detail/impl/io_uring_buffer_ring.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IMPL_IO_URING_BUFFER_RING_IPP
+#define ASIO_DETAIL_IMPL_IO_URING_BUFFER_RING_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <climits>
+#include "asio/error.hpp"
+#include "asio/detail/io_uring_buffer_ring.hpp"
+#include "asio/detail/throw_error.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+io_uring_buffer_ring::io_uring_buffer_ring(io_uring_service& service,
+    std::size_t buffer_count, std::size_t buffer_size)
+  : service_(service),
+    buffer_count_(buffer_count),
+    buffer_size_(buffer_size),
+    ring_(0),
+    group_id_(0)
+{
+  if (buffer_count == 0 || buffer_count > max_buffer_count
+      || (buffer_count & (buffer_count - 1)) != 0
+      || buffer_size == 0 || buffer_size > UINT_MAX)
+  {
+    asio::error_code ec(asio::error::invalid_argument);
+    asio::detail::throw_error(ec, "io_uring_buffer_ring");
+    return;
+  }
+
+  storage_.resize(buffer_count * buffer_size);
+
+  ring_ = service_.register_buffer_ring(
+      static_cast<unsigned>(buffer_count), group_id_);
+  if (!ring_)
+    return;
+
+  int mask = ::io_uring_buf_ring_mask(static_cast<unsigned>(buffer_count));
+  for (std::size_t i = 0; i < buffer_count; ++i)
+  {
+    ::io_uring_buf_ring_add(ring_, &storage_[0] + i * buffer_size,
+        static_cast<unsigned>(buffer_size),
+        static_cast<unsigned short>(i), mask, static_cast<int>(i));
+  }
+  ::io_uring_buf_ring_advance(ring_, static_cast<int>(buffer_count));
+}
+
+io_uring_buffer_ring::~io_uring_buffer_ring()
+{
+  if (ring_)
+  {
+    service_.unregister_buffer_ring(ring_,
+        static_cast<unsigned>(buffer_count_), group_id_);
+  }
+}
+
+void io_uring_buffer_ring::recycle(unsigned short id)
+{
+  mutex::scoped_lock lock(mutex_);
+  ::io_uring_buf_ring_add(ring_, buffer(id),
+      static_cast<unsigned>(buffer_size_), id,
+      ::io_uring_buf_ring_mask(static_cast<unsigned>(buffer_count_)), 0);
+  ::io_uring_buf_ring_advance(ring_, 1);
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IMPL_IO_URING_BUFFER_RING_IPP
@@ -21,9 +21,12 @@
 
 #include <cstddef>
 #include <sys/eventfd.h>
+#include <sys/resource.h>
 #include "asio/detail/io_uring_service.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/scheduler.hpp"
+#include "asio/detail/scoped_ptr.hpp"
+#include "asio/detail/socket_types.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/error.hpp"
 
@@ -37,20 +40,37 @@ io_uring_service::io_uring_service(asio::execution_context& ctx)
     scheduler_(use_service<scheduler>(ctx)),
     mutex_(ASIO_CONCURRENCY_HINT_IS_LOCKING(
           REACTOR_REGISTRATION, scheduler_.concurrency_hint())),
+    ring_size_(static_cast<unsigned>(scheduler_.io_uring_ring_size())),
     outstanding_work_(0),
-    submit_sqes_op_(this),
+    submit_sqes_op_(this, 0),
     pending_sqes_(0),
     pending_submit_sqes_op_(false),
     shutdown_(false),
+    sqpoll_(false),
     timeout_(),
     registration_mutex_(mutex_.enabled()),
+    multishot_ops_(0),
+    next_buffer_group_(0),
+    fixed_file_count_(0),
+    next_fixed_file_(0),
+    sharded_(ASIO_CONCURRENCY_HINT_IS_ENABLED(
+          SHARDED_IO_URING, scheduler_.concurrency_hint())),
+    next_shard_(0),
     reactor_(use_service<reactor>(ctx)),
     reactor_data_(),
     event_fd_(-1)
 {
+  for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+    shards_[i] = 0;
+
   reactor_.init_task();
   init_ring();
+  init_fixed_files();
   register_with_reactor();
+
+  // Idle threads wait on their own shards, rather than on the reactor.
+  if (sharded_)
+    scheduler_.init_thread_task(this);
 }
 
 io_uring_service::~io_uring_service()
@@ -59,6 +79,17 @@ io_uring_service::~io_uring_service()
     ::io_uring_queue_exit(&ring_);
   if (event_fd_ != -1)
     ::close(event_fd_);
+  for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+  {
+    if (shards_[i])
+    {
+      if (shards_[i]->ring_.ring_fd != -1)
+        ::io_uring_queue_exit(&shards_[i]->ring_);
+      if (shards_[i]->wakeup_fd_ != -1)
+        ::close(shards_[i]->wakeup_fd_);
+      delete shards_[i];
+    }
+  }
 }
 
 void io_uring_service::shutdown()
@@ -77,14 +108,50 @@ void io_uring_service::shutdown()
       if (!io_obj->queues_[i].op_queue_.empty())
       {
         ops.push(io_obj->queues_[i].op_queue_);
-        if (::io_uring_sqe* sqe = get_sqe())
+        if (::io_uring_sqe* sqe = get_sqe(io_obj))
           ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
       }
     }
+    remove_fixed_file(io_obj);
     io_obj->shutdown_ = true;
     registered_io_objects_.free(io_obj);
   }
 
+  // Cancel all multishot operations. Those that are not already queued for
+  // delivery are abandoned along with the other outstanding operations.
+  while (multishot_op* op = multishot_ops_)
+  {
+    multishot_ops_ = op->next_live_;
+    op->next_live_ = 0;
+    op->prev_live_ = 0;
+    op->io_object_ = 0;
+    if (op->armed_)
+    {
+      if (::io_uring_sqe* sqe = get_sqe())
+      {
+        ::io_uring_prep_cancel(sqe, multishot_user_data(op), 0);
+        ::io_uring_sqe_set_data(sqe, 0);
+      }
+    }
+    if (!op->scheduled_)
+      ops.push(op);
+  }
+
+  // Stop polling the shards, and end the reads of their eventfds.
+  for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+  {
+    if (shards_[i])
+    {
+      if (::io_uring_sqe* sqe = get_sqe())
+      {
+        ::io_uring_prep_cancel(sqe, shard_user_data(shards_[i]), 0);
+        ::io_uring_sqe_set_data(sqe, 0);
+      }
+      submit_shard_sqes(*shards_[i]);
+      wake_shard(*shards_[i]);
+    }
+  }
+
   // Cancel the timeout operation.
   if (::io_uring_sqe* sqe = get_sqe())
     ::io_uring_prep_cancel(sqe, &timeout_, IOSQE_IO_DRAIN);
@@ -97,6 +164,19 @@ void io_uring_service::shutdown()
     if (::io_uring_wait_cqe(&ring_, &cqe) != 0)
       break;
   }
+  for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+  {
+    if (shard_state* shard = shards_[i])
+    {
+      for (; shard->outstanding_work_ > 0; --shard->outstanding_work_)
+      {
+        ::io_uring_cqe* cqe = 0;
+        if (::io_uring_wait_cqe(&shard->ring_, &cqe) != 0)
+          break;
+        ::io_uring_cqe_seen(&shard->ring_, cqe);
+      }
+    }
+  }
 
   timer_queues_.get_all_timers(ops);
 
@@ -122,20 +202,53 @@ void io_uring_service::notify_fork(
           if (!io_obj->queues_[i].op_queue_.empty()
               && !io_obj->queues_[i].cancel_requested_)
           {
-            mutex::scoped_lock lock(mutex_);
-            if (::io_uring_sqe* sqe = get_sqe())
+            mutex::scoped_lock lock(ring_mutex(io_obj));
+            if (::io_uring_sqe* sqe = get_sqe(io_obj))
               ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
           }
         }
       }
 
-      // Cancel the timeout operation.
+      // Cancel the multishot operations, marking them to be resubmitted when
+      // the cancellation is delivered, and then the timeout operation.
       {
         mutex::scoped_lock lock(mutex_);
+        for (multishot_op* op = multishot_ops_; op; op = op->next_live_)
+        {
+          if (op->armed_ && !op->restart_)
+          {
+            if (::io_uring_sqe* sqe = get_sqe())
+            {
+              op->restart_ = true;
+              ::io_uring_prep_cancel(sqe, multishot_user_data(op), 0);
+              ::io_uring_sqe_set_data(sqe, 0);
+            }
+          }
+        }
+        for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+        {
+          if (shards_[i])
+          {
+            if (::io_uring_sqe* sqe = get_sqe())
+            {
+              ::io_uring_prep_cancel(sqe, shard_user_data(shards_[i]), 0);
+              ::io_uring_sqe_set_data(sqe, 0);
+            }
+          }
+        }
         if (::io_uring_sqe* sqe = get_sqe())
           ::io_uring_prep_cancel(sqe, &timeout_, IOSQE_IO_DRAIN);
         submit_sqes();
       }
+      for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+      {
+        if (shards_[i])
+        {
+          mutex::scoped_lock lock(shards_[i]->mutex_);
+          submit_shard_sqes(*shards_[i]);
+          wake_shard(*shards_[i]);
+        }
+      }
 
       // Wait for all completions to come back, and post all completed I/O
       // queues to the scheduler. Note that some operations may have already
@@ -149,7 +262,24 @@ void io_uring_service::notify_fork(
           break;
         if (void* ptr = ::io_uring_cqe_get_data(cqe))
         {
-          if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
+          if (multishot_op* op = multishot_from_user_data(ptr))
+          {
+            if (cqe_has_more(cqe))
+              ++outstanding_work_;
+            mutex::scoped_lock lock(mutex_);
+            bool release_work = record_multishot_result(op, cqe, ops);
+            lock.unlock();
+            if (release_work)
+              scheduler_.work_finished();
+          }
+          else if (shard_state* shard = shard_from_user_data(ptr))
+          {
+            // The shard's completions are collected below, and it is polled
+            // again after the fork.
+            mutex::scoped_lock lock(mutex_);
+            shard->armed_ = false;
+          }
+          else if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
           {
             io_queue* io_q = static_cast<io_queue*>(ptr);
             io_q->set_result(cqe->res);
@@ -157,6 +287,33 @@ void io_uring_service::notify_fork(
           }
         }
       }
+      for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+      {
+        if (shard_state* shard = shards_[i])
+        {
+          for (; shard->outstanding_work_ > 0; --shard->outstanding_work_)
+          {
+            ::io_uring_cqe* cqe = 0;
+            if (::io_uring_wait_cqe(&shard->ring_, &cqe) != 0)
+              break;
+            if (void* ptr = ::io_uring_cqe_get_data(cqe))
+            {
+              if (ptr == &shard->wakeup_value_)
+              {
+                mutex::scoped_lock lock(shard->mutex_);
+                shard->wakeup_armed_ = false;
+              }
+              else
+              {
+                io_queue* io_q = static_cast<io_queue*>(ptr);
+                io_q->set_result(cqe->res);
+                ops.push(io_q);
+              }
+            }
+            ::io_uring_cqe_seen(&shard->ring_, cqe);
+          }
+        }
+      }
       scheduler_.post_deferred_completions(ops);
 
       // Restart and eventfd operation.
@@ -165,16 +322,54 @@ void io_uring_service::notify_fork(
     break;
 
   case asio::execution_context::fork_parent:
-    // Restart the timeout and eventfd operations.
-    update_timeout();
-    register_with_reactor();
+    {
+      // Restart the timeout and eventfd operations, and the shard polls.
+      update_timeout();
+      register_with_reactor();
+      mutex::scoped_lock lock(mutex_);
+      for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+      {
+        if (shards_[i] && !shards_[i]->armed_)
+        {
+          arm_shard(*shards_[i], lock);
+          lock.lock();
+        }
+      }
+    }
     break;
 
   case asio::execution_context::fork_child:
     {
-      // The child process gets a new io_uring instance.
+      // The child process gets new io_uring instances.
       ::io_uring_queue_exit(&ring_);
       init_ring();
+      for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+      {
+        if (shard_state* shard = shards_[i])
+        {
+          ::io_uring_queue_exit(&shard->ring_);
+          decrement(shard->outstanding_work_, shard->outstanding_work_);
+          shard->pending_sqes_ = 0;
+          init_shard_ring(*shard);
+          mutex::scoped_lock lock(mutex_);
+          shard->armed_ = false;
+          arm_shard(*shard, lock);
+        }
+      }
+
+      // Populate a new registered file table.
+      init_fixed_files();
+      next_fixed_file_ = 0;
+      free_fixed_files_.clear();
+      mutex::scoped_lock registration_lock(registration_mutex_);
+      for (io_object* io_obj = registered_io_objects_.first();
+          io_obj != 0; io_obj = io_obj->next_)
+      {
+        io_obj->fixed_file_ = -1;
+        add_fixed_file(io_obj);
+      }
+      registration_lock.unlock();
+
       register_with_reactor();
     }
     break;
@@ -189,19 +384,26 @@ void io_uring_service::init_task()
 }
 
 void io_uring_service::register_io_object(
-    io_uring_service::per_io_object_data& io_obj)
+    io_uring_service::per_io_object_data& io_obj, int descriptor)
 {
+  shard_state* shard = assign_shard();
   io_obj = allocate_io_object();
 
   mutex::scoped_lock io_object_lock(io_obj->mutex_);
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->multishot_op_ = 0;
+  io_obj->descriptor_ = descriptor;
+  io_obj->fixed_file_ = -1;
+  io_obj->shard_ = shard;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
     io_obj->queues_[i].cancel_requested_ = false;
   }
+
+  add_fixed_file(io_obj);
 }
 
 void io_uring_service::register_internal_io_object(
@@ -214,6 +416,10 @@ void io_uring_service::register_internal_io_object(
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->multishot_op_ = 0;
+  io_obj->descriptor_ = -1;
+  io_obj->fixed_file_ = -1;
+  io_obj->shard_ = 0;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
@@ -239,18 +445,68 @@ void io_uring_service::register_internal_io_object(
 
 void io_uring_service::register_buffers(const ::iovec* v, unsigned n)
 {
+  mutex::scoped_lock lock(mutex_);
+
   int result = ::io_uring_register_buffers(&ring_, v, n);
+  for (int i = 0; result >= 0 && i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+  {
+    if (shards_[i])
+    {
+      result = ::io_uring_register_buffers(&shards_[i]->ring_, v, n);
+      if (result < 0)
+      {
+        (void)::io_uring_unregister_buffers(&ring_);
+        for (int j = 0; j < i; ++j)
+          if (shards_[j])
+            (void)::io_uring_unregister_buffers(&shards_[j]->ring_);
+      }
+    }
+  }
   if (result < 0)
   {
     asio::error_code ec(-result,
         asio::error::get_system_category());
     asio::detail::throw_error(ec, "io_uring_register_buffers");
   }
+
+  // Keep the buffers so that they can be registered with any shards that are
+  // created later.
+  if (sharded_)
+    registered_buffers_.assign(v, v + n);
 }
 
 void io_uring_service::unregister_buffers()
 {
+  mutex::scoped_lock lock(mutex_);
+
   (void)::io_uring_unregister_buffers(&ring_);
+  for (int i = 0; i < ASIO_SHARDED_REACTOR_MAX_SHARDS; ++i)
+    if (shards_[i])
+      (void)::io_uring_unregister_buffers(&shards_[i]->ring_);
+  registered_buffers_.clear();
+}
+
+::io_uring_buf_ring* io_uring_service::register_buffer_ring(
+    unsigned entries, int& group_id)
+{
+  mutex::scoped_lock lock(mutex_);
+  int result = 0;
+  ::io_uring_buf_ring* ring = ::io_uring_setup_buf_ring(
+      &ring_, entries, next_buffer_group_, 0, &result);
+  if (!ring)
+  {
+    asio::error_code ec(-result,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "io_uring_setup_buf_ring");
+  }
+  group_id = next_buffer_group_++;
+  return ring;
+}
+
+void io_uring_service::unregister_buffer_ring(
+    ::io_uring_buf_ring* ring, unsigned entries, int group_id)
+{
+  (void)::io_uring_free_buf_ring(&ring_, ring, entries, group_id);
 }
 
 void io_uring_service::start_op(int op_type,
@@ -284,13 +540,14 @@ void io_uring_service::start_op(int op_type,
     {
       io_obj->queues_[op_type].op_queue_.push(op);
       io_object_lock.unlock();
-      mutex::scoped_lock lock(mutex_);
-      if (::io_uring_sqe* sqe = get_sqe())
+      mutex::scoped_lock lock(ring_mutex(io_obj));
+      if (::io_uring_sqe* sqe = get_sqe(io_obj))
       {
         op->prepare(sqe);
+        use_fixed_file(io_obj, sqe);
         ::io_uring_sqe_set_data(sqe, &io_obj->queues_[op_type]);
         scheduler_.work_started();
-        post_submit_sqes_op(lock);
+        post_submit_sqes_op(io_obj, lock);
       }
       else
       {
@@ -307,6 +564,173 @@ void io_uring_service::start_op(int op_type,
   }
 }
 
+void io_uring_service::start_multishot_op(
+    io_uring_service::per_io_object_data& io_obj,
+    multishot_op* op, bool is_continuation)
+{
+  if (!io_obj)
+  {
+    push_multishot_result(op, -EBADF);
+    op->scheduled_ = true;
+    post_immediate_completion(op, is_continuation);
+    return;
+  }
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+  mutex::scoped_lock lock(mutex_);
+
+  op->next_live_ = multishot_ops_;
+  if (multishot_ops_)
+    multishot_ops_->prev_live_ = op;
+  multishot_ops_ = op;
+
+  int result = -ECANCELED;
+  if (!io_obj->shutdown_ && !shutdown_)
+  {
+    result = -EALREADY;
+    if (!io_obj->multishot_op_)
+    {
+      io_obj->multishot_op_ = op;
+      op->io_object_ = io_obj;
+      io_object_lock.unlock();
+      if (submit_multishot_op(op, lock))
+        return;
+      result = -ENOBUFS;
+    }
+  }
+
+  // The operation could not be submitted, so deliver the error.
+  push_multishot_result(op, result);
+  op->scheduled_ = true;
+  lock.unlock();
+  io_object_lock.unlock();
+  post_immediate_completion(op, is_continuation);
+}
+
+struct io_uring_service::multishot_delivery_cleanup_on_block_exit
+{
+  explicit multishot_delivery_cleanup_on_block_exit(
+      io_uring_service* s, multishot_op* o)
+    : service_(s), op_(o)
+  {
+  }
+
+  ~multishot_delivery_cleanup_on_block_exit()
+  {
+    if (op_)
+    {
+      // The handler exited via an exception. Stop the operation so that any
+      // further results are released, and schedule their release now unless
+      // the kernel has yet to report the end of the submission.
+      mutex::scoped_lock lock(service_->mutex_);
+      service_->stop_multishot_op(op_);
+      service_->submit_sqes();
+      if (op_->armed_)
+      {
+        op_->scheduled_ = false;
+      }
+      else
+      {
+        lock.unlock();
+        service_->scheduler_.post_immediate_completion(op_, true);
+      }
+    }
+  }
+
+  io_uring_service* service_;
+  multishot_op* op_;
+};
+
+bool io_uring_service::complete_multishot_op(multishot_op* op)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  for (;;)
+  {
+    while (op->next_result_ < op->results_.size())
+    {
+      int result = op->results_[op->next_result_].res;
+      unsigned flags = op->results_[op->next_result_].flags;
+      ++op->next_result_;
+
+      if (result == -EINVAL && op->multishot_
+          && !op->delivered_ && !op->stopped_)
+      {
+        // The kernel does not support the multishot form of the operation.
+        // Fall back to re-submitting the single-shot form for each result.
+        op->multishot_ = false;
+        continue;
+      }
+
+      if (result == -ECANCELED && op->restart_)
+      {
+        // The submission was cancelled in preparation for a fork.
+        op->restart_ = false;
+        continue;
+      }
+
+      bool deliver = !op->stopped_;
+      lock.unlock();
+      multishot_delivery_cleanup_on_block_exit on_exit(this, op);
+      bool more = op->deliver_func_(op, result, flags, deliver);
+      on_exit.op_ = 0;
+      lock.lock();
+
+      if (deliver)
+      {
+        if (result >= 0)
+          op->delivered_ = true;
+        if (result < 0 || !more)
+        {
+          stop_multishot_op(op);
+          submit_sqes();
+        }
+      }
+    }
+
+    op->results_.clear();
+    op->next_result_ = 0;
+
+    if (op->armed_)
+    {
+      // Further results will be delivered when they arrive.
+      op->scheduled_ = false;
+      return false;
+    }
+
+    if (op->stopped_)
+      break;
+
+    if (op->cancel_requested_ || !op->io_object_ || shutdown_)
+    {
+      op->cancel_requested_ = false;
+      push_multishot_result(op, -ECANCELED);
+    }
+    else if (submit_multishot_op(op, lock))
+    {
+      return false;
+    }
+    else
+    {
+      push_multishot_result(op, -ENOBUFS);
+    }
+  }
+
+  // The operation has finished.
+  if (op->io_object_ && op->io_object_->multishot_op_ == op)
+    op->io_object_->multishot_op_ = 0;
+  op->io_object_ = 0;
+  if (op->prev_live_)
+    op->prev_live_->next_live_ = op->next_live_;
+  else if (multishot_ops_ == op)
+    multishot_ops_ = op->next_live_;
+  if (op->next_live_)
+    op->next_live_->prev_live_ = op->prev_live_;
+  op->next_live_ = 0;
+  op->prev_live_ = 0;
+  return true;
+}
+
 void io_uring_service::cancel_ops(io_uring_service::per_io_object_data& io_obj)
 {
   if (!io_obj)
@@ -342,11 +766,11 @@ void io_uring_service::cancel_ops_by_key(
         if (!io_obj->queues_[op_type].cancel_requested_)
         {
           io_obj->queues_[op_type].cancel_requested_ = true;
-          mutex::scoped_lock lock(mutex_);
-          if (::io_uring_sqe* sqe = get_sqe())
+          mutex::scoped_lock lock(ring_mutex(io_obj));
+          if (::io_uring_sqe* sqe = get_sqe(io_obj))
           {
             ::io_uring_prep_cancel(sqe, &io_obj->queues_[op_type], 0);
-            submit_sqes();
+            submit_sqes(io_obj);
           }
         }
       }
@@ -362,6 +786,17 @@ void io_uring_service::cancel_ops_by_key(
   }
   io_obj->queues_[op_type].op_queue_.push(other_ops);
 
+  if (op_type == read_op)
+  {
+    mutex::scoped_lock lock(mutex_);
+    multishot_op* op = io_obj->multishot_op_;
+    if (op && op->cancellation_key_ == cancellation_key)
+    {
+      cancel_multishot_op(op);
+      submit_sqes();
+    }
+  }
+
   io_object_lock.unlock();
 
   scheduler_.post_deferred_completions(ops);
@@ -379,7 +814,26 @@ void io_uring_service::deregister_io_object(
     op_queue<operation> ops;
     do_cancel_ops(io_obj, ops);
     io_obj->shutdown_ = true;
+
+    // Detach any multishot operation, which completes once its cancellation
+    // has been delivered.
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (multishot_op* op = io_obj->multishot_op_)
+      {
+        op->io_object_ = 0;
+        io_obj->multishot_op_ = 0;
+      }
+    }
+
+    // The registered file table holds a reference to the descriptor's file,
+    // which would otherwise keep it open after the descriptor is closed. The
+    // slot is cleared after the object's mutex is released, since no further
+    // operations will be started on the object.
+    int fixed_file = detach_fixed_file(io_obj);
+
     io_object_lock.unlock();
+    release_fixed_file(fixed_file);
     scheduler_.post_deferred_completions(ops);
 
     // Leave io_obj set so that it will be freed by the subsequent
@@ -443,6 +897,8 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
 
   bool check_timers = false;
   int count = 0;
+  int more_count = 0;
+  int released_work = 0;
   while (result == 0)
   {
     if (void* ptr = ::io_uring_cqe_get_data(cqe))
@@ -465,6 +921,52 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
       {
         --local_ops;
       }
+      else if (shard_state* shard = shard_from_user_data(ptr))
+      {
+        // The shard's completions are reaped by the thread that owns it. A
+        // thread waiting on its shard reaps them itself, and polls the shard
+        // again once it stops waiting.
+        mutex::scoped_lock lock(mutex_);
+        shard->armed_ = false;
+        if (!shard->waiting_ && !shard->queued_)
+        {
+          shard->queued_ = true;
+          lock.unlock();
+          if (shard->index_ == scheduler_.this_thread_index())
+            ops.push(shard);
+          else
+          {
+            op_queue<operation> shard_ops;
+            shard_ops.push(shard);
+            scheduler_.post_deferred_completions_to_thread(
+                shard->index_, shard_ops);
+          }
+        }
+      }
+      else if (multishot_op* op = multishot_from_user_data(ptr))
+      {
+        // Only the final completion of a multishot submission is counted as
+        // outstanding work.
+        if (cqe_has_more(cqe))
+          ++more_count;
+        mutex::scoped_lock lock(mutex_);
+        op_queue<operation> multishot_ops;
+        if (record_multishot_result(op, cqe, multishot_ops))
+          ++released_work;
+        shard_state* owner = op->io_object_ ? op->io_object_->shard_ : 0;
+        lock.unlock();
+
+        // The results for an I/O object on a shard are delivered by the thread
+        // that owns the shard, even though the submission uses the shared
+        // ring.
+        if (owner && owner->index_ != scheduler_.this_thread_index())
+        {
+          scheduler_.post_deferred_completions_to_thread(
+              owner->index_, multishot_ops);
+        }
+        else
+          ops.push(multishot_ops);
+      }
       else
       {
         io_queue* io_q = static_cast<io_queue*>(ptr);
@@ -477,7 +979,10 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
       ? ::io_uring_peek_cqe(&ring_, &cqe) : -EAGAIN;
   }
 
-  decrement(outstanding_work_, count);
+  decrement(outstanding_work_, count - more_count);
+
+  for (; released_work > 0; --released_work)
+    scheduler_.work_finished();
 
   if (check_timers)
   {
@@ -509,7 +1014,30 @@ void io_uring_service::interrupt()
 
 void io_uring_service::init_ring()
 {
-  int result = ::io_uring_queue_init(ring_size, &ring_, 0);
+  int result = -1;
+  sqpoll_ = false;
+  if (ASIO_CONCURRENCY_HINT_IS_ENABLED(IO_URING_SQPOLL,
+        scheduler_.concurrency_hint()))
+  {
+    ::io_uring_params params = ::io_uring_params();
+    params.flags = IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = static_cast<unsigned>(
+        scheduler_.io_uring_sqpoll_idle_msec());
+    if (scheduler_.io_uring_sqpoll_cpu() >= 0)
+    {
+      params.flags |= IORING_SETUP_SQ_AFF;
+      params.sq_thread_cpu = static_cast<unsigned>(
+          scheduler_.io_uring_sqpoll_cpu());
+    }
+
+    // Creating the polling thread may need privileges that the process does
+    // not have, in which case the ring is created without it.
+    result = ::io_uring_queue_init_params(ring_size_, &ring_, &params);
+    sqpoll_ = (result == 0);
+  }
+
+  if (!sqpoll_)
+    result = ::io_uring_queue_init(ring_size_, &ring_, 0);
   if (result < 0)
   {
     ring_.ring_fd = -1;
@@ -572,6 +1100,16 @@ public:
     o->service_->run(0, ops);
     o->service_->scheduler_.post_deferred_completions(ops);
 
+    // A full batch may leave completions in the ring, for which the eventfd
+    // will not be signalled again.
+    ::io_uring_cqe* cqe = 0;
+    if (::io_uring_peek_cqe(&o->service_->ring_, &cqe) == 0)
+    {
+      uint64_t counter(1UL);
+      int result = ::write(o->service_->event_fd_, &counter, sizeof(uint64_t));
+      (void)result;
+    }
+
     return not_done;
   }
 
@@ -596,6 +1134,99 @@ void io_uring_service::register_with_reactor()
 #endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 }
 
+void io_uring_service::init_fixed_files()
+{
+  // The kernel does not allow the table to exceed the open file limit.
+  int count = fixed_file_table_size;
+  ::rlimit limit;
+  if (::getrlimit(RLIMIT_NOFILE, &limit) == 0
+      && limit.rlim_cur < static_cast< ::rlim_t>(count))
+    count = static_cast<int>(limit.rlim_cur);
+
+  if (count > 0 && ::io_uring_register_files_sparse(&ring_, count) == 0)
+    fixed_file_count_ = count;
+  else
+    fixed_file_count_ = 0;
+}
+
+void io_uring_service::add_fixed_file(io_uring_service::io_object* io_obj)
+{
+  // The table belongs to the shared ring, so it is not used for objects whose
+  // operations are submitted to a shard.
+  if (io_obj->descriptor_ < 0 || io_obj->shard_)
+    return;
+
+  mutex::scoped_lock lock(mutex_);
+
+  int slot;
+  if (!free_fixed_files_.empty())
+  {
+    slot = free_fixed_files_.back();
+    free_fixed_files_.pop_back();
+  }
+  else if (next_fixed_file_ < fixed_file_count_)
+  {
+    // Reserve room for every slot up front, so that releasing one can never
+    // fail.
+    if (free_fixed_files_.capacity() == 0)
+      free_fixed_files_.reserve(fixed_file_count_);
+    slot = next_fixed_file_++;
+  }
+  else
+  {
+    // Operations on the object will use its descriptor.
+    return;
+  }
+
+  // Updating the table waits for the kernel, so avoid doing it while holding
+  // the mutex.
+  lock.unlock();
+  int result = ::io_uring_register_files_update(
+      &ring_, slot, &io_obj->descriptor_, 1);
+  lock.lock();
+
+  if (result == 1)
+    io_obj->fixed_file_ = slot;
+  else
+    free_fixed_files_.push_back(slot);
+}
+
+void io_uring_service::remove_fixed_file(io_uring_service::io_object* io_obj)
+{
+  release_fixed_file(detach_fixed_file(io_obj));
+}
+
+int io_uring_service::detach_fixed_file(io_uring_service::io_object* io_obj)
+{
+  mutex::scoped_lock lock(mutex_);
+
+  int slot = io_obj->fixed_file_;
+  if (slot >= 0)
+  {
+    io_obj->fixed_file_ = -1;
+
+    // Submissions resolve the slot when they are submitted, so pending
+    // entries must be submitted before the slot is cleared.
+    submit_sqes();
+  }
+
+  return slot;
+}
+
+void io_uring_service::release_fixed_file(int slot)
+{
+  if (slot < 0)
+    return;
+
+  // Updating the table waits for the kernel, so it is done without holding
+  // the mutex.
+  int fd = -1;
+  (void)::io_uring_register_files_update(&ring_, slot, &fd, 1);
+
+  mutex::scoped_lock lock(mutex_);
+  free_fixed_files_.push_back(slot);
+}
+
 io_uring_service::io_object* io_uring_service::allocate_io_object()
 {
   mutex::scoped_lock registration_lock(registration_mutex_);
@@ -631,20 +1262,105 @@ void io_uring_service::do_cancel_ops(
     }
   }
 
-  if (cancel_op)
   {
     mutex::scoped_lock lock(mutex_);
+    if (io_obj->multishot_op_)
+    {
+      cancel_multishot_op(io_obj->multishot_op_);
+      submit_sqes();
+    }
+  }
+
+  if (cancel_op)
+  {
+    mutex::scoped_lock lock(ring_mutex(io_obj));
     for (int i = 0; i < max_ops; ++i)
     {
       if (!io_obj->queues_[i].op_queue_.empty()
           && !io_obj->queues_[i].cancel_requested_)
       {
         io_obj->queues_[i].cancel_requested_ = true;
-        if (::io_uring_sqe* sqe = get_sqe())
+        if (::io_uring_sqe* sqe = get_sqe(io_obj))
           ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
       }
     }
-    submit_sqes();
+    submit_sqes(io_obj);
+  }
+}
+
+bool io_uring_service::record_multishot_result(multishot_op* op,
+    const ::io_uring_cqe* cqe, op_queue<operation>& ops)
+{
+  bool more = cqe_has_more(cqe);
+  multishot_op::result_type r = { cqe->res, cqe->flags };
+  op->results_.push_back(r);
+  if (!more)
+    op->armed_ = false;
+
+  if (!op->scheduled_)
+  {
+    // The delivery takes over the submission's unit of work if this is the
+    // final completion, and otherwise needs one of its own.
+    op->scheduled_ = true;
+    ops.push(op);
+    if (more)
+      scheduler_.work_started();
+    return false;
+  }
+
+  // The delivery already holds a unit of work, so the submission's unit is
+  // no longer needed once it has ended.
+  return !more;
+}
+
+bool io_uring_service::submit_multishot_op(
+    multishot_op* op, mutex::scoped_lock& lock)
+{
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    op->prepare_func_(op, sqe, op->multishot_);
+    if (op->io_object_)
+      use_fixed_file(op->io_object_, sqe);
+    ::io_uring_sqe_set_data(sqe, multishot_user_data(op));
+    op->armed_ = true;
+    op->scheduled_ = false;
+    op->restart_ = false;
+    scheduler_.work_started();
+    post_submit_sqes_op(lock);
+    return true;
+  }
+  return false;
+}
+
+void io_uring_service::stop_multishot_op(multishot_op* op)
+{
+  if (!op->stopped_)
+  {
+    op->stopped_ = true;
+    if (op->armed_ && !op->cancel_requested_)
+    {
+      if (::io_uring_sqe* sqe = get_sqe())
+      {
+        ::io_uring_prep_cancel(sqe, multishot_user_data(op), 0);
+        ::io_uring_sqe_set_data(sqe, 0);
+      }
+    }
+  }
+}
+
+void io_uring_service::cancel_multishot_op(multishot_op* op)
+{
+  if (!op->stopped_ && !op->cancel_requested_)
+  {
+    op->cancel_requested_ = true;
+    if (op->armed_)
+    {
+      if (::io_uring_sqe* sqe = get_sqe())
+      {
+        ::io_uring_prep_cancel(sqe, multishot_user_data(op), 0);
+        ::io_uring_sqe_set_data(sqe, 0);
+      }
+    }
   }
 }
 
@@ -706,7 +1422,9 @@ void io_uring_service::submit_sqes()
 
 void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
 {
-  if (pending_sqes_ >= submit_batch_size)
+  // When the submission queue is polled, submitting only makes the entries
+  // visible to the polling thread, so there is nothing to gain by batching.
+  if (sqpoll_ || pending_sqes_ >= submit_batch_size)
   {
     submit_sqes();
   }
@@ -720,7 +1438,11 @@ void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
 
 void io_uring_service::push_submit_sqes_op(op_queue<operation>& ops)
 {
-  if (pending_sqes_ != 0 && !pending_submit_sqes_op_)
+  if (sqpoll_)
+  {
+    submit_sqes();
+  }
+  else if (pending_sqes_ != 0 && !pending_submit_sqes_op_)
   {
     pending_submit_sqes_op_ = true;
     ops.push(&submit_sqes_op_);
@@ -728,9 +1450,260 @@ void io_uring_service::push_submit_sqes_op(op_queue<operation>& ops)
   }
 }
 
-io_uring_service::submit_sqes_op::submit_sqes_op(io_uring_service* s)
+::io_uring_sqe* io_uring_service::get_sqe(io_object* io_obj)
+{
+  if (io_obj->shard_)
+    return get_shard_sqe(*io_obj->shard_);
+  return get_sqe();
+}
+
+void io_uring_service::submit_sqes(io_object* io_obj)
+{
+  if (io_obj->shard_)
+    submit_shard_sqes(*io_obj->shard_);
+  else
+    submit_sqes();
+}
+
+void io_uring_service::post_submit_sqes_op(
+    io_object* io_obj, mutex::scoped_lock& lock)
+{
+  shard_state* shard = io_obj->shard_;
+  if (!shard)
+  {
+    post_submit_sqes_op(lock);
+  }
+  else if (shard->pending_sqes_ >= submit_batch_size)
+  {
+    submit_shard_sqes(*shard);
+  }
+  else if (shard->pending_sqes_ != 0 && !shard->pending_submit_sqes_op_)
+  {
+    // The entries are submitted by the thread that owns the shard, so that
+    // the shard's ring is normally used by one thread only.
+    shard->pending_submit_sqes_op_ = true;
+    lock.unlock();
+    scheduler_.post_to_thread(shard->index_, &shard->submit_sqes_op_);
+  }
+}
+
+io_uring_service::shard_state* io_uring_service::assign_shard()
+{
+  if (!sharded_)
+    return 0;
+
+  // I/O objects are shared out in turn among the threads that have entered
+  // run(), or all go to the first shard if no thread has done so yet.
+  std::size_t threads = scheduler_.run_thread_index_limit();
+
+  mutex::scoped_lock lock(mutex_);
+  std::size_t index = (threads ? next_shard_++ % threads : 0)
+    % ASIO_SHARDED_REACTOR_MAX_SHARDS;
+  shard_state* shard = shards_[index];
+  if (!shard)
+  {
+    scoped_ptr<shard_state> new_shard(new shard_state(this, index));
+    init_shard_ring(*new_shard);
+    if (!registered_buffers_.empty())
+    {
+      int result = ::io_uring_register_buffers(&new_shard->ring_,
+          &registered_buffers_[0],
+          static_cast<unsigned>(registered_buffers_.size()));
+      if (result < 0)
+      {
+        ::io_uring_queue_exit(&new_shard->ring_);
+        asio::error_code ec(-result,
+            asio::error::get_system_category());
+        asio::detail::throw_error(ec, "io_uring_register_buffers");
+      }
+    }
+    shard = shards_[index] = new_shard.release();
+    arm_shard(*shard, lock);
+  }
+  return shard;
+}
+
+void io_uring_service::init_shard_ring(shard_state& shard)
+{
+  int result = ::io_uring_queue_init(ring_size_, &shard.ring_, 0);
+  if (result < 0)
+  {
+    shard.ring_.ring_fd = -1;
+    asio::error_code ec(-result,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "io_uring_queue_init");
+  }
+
+  // The eventfd is read by the ring, which waits for it to become readable,
+  // so it is left in blocking mode.
+  if (shard.wakeup_fd_ != -1)
+    ::close(shard.wakeup_fd_);
+  shard.wakeup_fd_ = ::eventfd(0, EFD_CLOEXEC);
+  shard.wakeup_armed_ = false;
+  if (shard.wakeup_fd_ < 0)
+  {
+    asio::error_code ec(errno,
+        asio::error::get_system_category());
+    ::io_uring_queue_exit(&shard.ring_);
+    shard.ring_.ring_fd = -1;
+    asio::detail::throw_error(ec, "eventfd");
+  }
+}
+
+void io_uring_service::arm_shard(shard_state& shard, mutex::scoped_lock& lock)
+{
+  if (shard.armed_ || shutdown_)
+    return;
+
+  // The poll is one-shot, so the shard is reported again only after it has
+  // been re-armed, and then straight away if it still has completions.
+  if (::io_uring_sqe* sqe = get_sqe())
+  {
+    ::io_uring_prep_poll_add(sqe, shard.ring_.ring_fd, POLLIN);
+    ::io_uring_sqe_set_data(sqe, shard_user_data(&shard));
+    shard.armed_ = true;
+    post_submit_sqes_op(lock);
+  }
+}
+
+void io_uring_service::reap_shard(shard_state& shard)
+{
+  // The shard operation doesn't count as work in and of itself, so we need to
+  // compensate for the work_finished() call that the scheduler will make once
+  // this operation returns.
+  scheduler_.compensating_work_started();
+
+  op_queue<operation> ops;
+  wait_shard(shard, false, ops);
+
+  mutex::scoped_lock lock(mutex_);
+  shard.queued_ = false;
+  arm_shard(shard, lock);
+  lock.unlock();
+
+  scheduler_.post_deferred_completions_to_thread(shard.index_, ops);
+}
+
+bool io_uring_service::run_thread(std::size_t index, op_queue<operation>& ops)
+{
+  if (!sharded_ || index >= ASIO_SHARDED_REACTOR_MAX_SHARDS)
+    return false;
+
+  // The shard is not queued when the shared ring reports it while its thread
+  // waits on it, unless it has already been queued.
+  mutex::scoped_lock lock(mutex_);
+  shard_state* shard = shards_[index];
+  if (!shard || shard->queued_ || shutdown_)
+    return false;
+  shard->waiting_ = true;
+  lock.unlock();
+
+  // The ring must be reading the eventfd for the wait to be interrupted.
+  mutex::scoped_lock shard_lock(shard->mutex_);
+  if (!shard->wakeup_armed_)
+  {
+    if (::io_uring_sqe* sqe = get_shard_sqe(*shard))
+    {
+      ::io_uring_prep_read(sqe, shard->wakeup_fd_, &shard->wakeup_value_,
+          sizeof(shard->wakeup_value_), 0);
+      ::io_uring_sqe_set_data(sqe, &shard->wakeup_value_);
+      shard->wakeup_armed_ = true;
+    }
+  }
+  submit_shard_sqes(*shard);
+  bool block = shard->wakeup_armed_;
+  shard_lock.unlock();
+
+  wait_shard(*shard, block, ops);
+
+  lock.lock();
+  shard->waiting_ = false;
+  arm_shard(*shard, lock);
+  return block;
+}
+
+void io_uring_service::interrupt_thread(std::size_t index)
+{
+  if (!sharded_ || index >= ASIO_SHARDED_REACTOR_MAX_SHARDS)
+    return;
+
+  mutex::scoped_lock lock(mutex_);
+  shard_state* shard = shards_[index];
+  lock.unlock();
+  if (shard)
+    wake_shard(*shard);
+}
+
+void io_uring_service::wait_shard(shard_state& shard,
+    bool block, op_queue<operation>& ops)
+{
+  int count = 0;
+  ::io_uring_cqe* cqe = 0;
+  int result = block
+    ? ::io_uring_wait_cqe(&shard.ring_, &cqe)
+    : ::io_uring_peek_cqe(&shard.ring_, &cqe);
+  while (result == 0)
+  {
+    if (void* ptr = ::io_uring_cqe_get_data(cqe))
+    {
+      if (ptr == &shard.wakeup_value_)
+      {
+        // The wait was interrupted.
+        mutex::scoped_lock lock(shard.mutex_);
+        shard.wakeup_armed_ = false;
+      }
+      else
+      {
+        io_queue* io_q = static_cast<io_queue*>(ptr);
+        io_q->set_result(cqe->res);
+        ops.push(io_q);
+      }
+    }
+    ::io_uring_cqe_seen(&shard.ring_, cqe);
+    result = (++count < complete_batch_size)
+      ? ::io_uring_peek_cqe(&shard.ring_, &cqe) : -EAGAIN;
+  }
+  decrement(shard.outstanding_work_, count);
+}
+
+void io_uring_service::wake_shard(shard_state& shard)
+{
+  uint64_t counter(1UL);
+  int result = ::write(shard.wakeup_fd_, &counter, sizeof(uint64_t));
+  (void)result;
+}
+
+::io_uring_sqe* io_uring_service::get_shard_sqe(shard_state& shard)
+{
+  ::io_uring_sqe* sqe = ::io_uring_get_sqe(&shard.ring_);
+  if (!sqe)
+  {
+    submit_shard_sqes(shard);
+    sqe = ::io_uring_get_sqe(&shard.ring_);
+  }
+  if (sqe)
+    ++shard.pending_sqes_;
+  return sqe;
+}
+
+void io_uring_service::submit_shard_sqes(shard_state& shard)
+{
+  if (shard.pending_sqes_ != 0)
+  {
+    int result = ::io_uring_submit(&shard.ring_);
+    if (result > 0)
+    {
+      shard.pending_sqes_ -= result;
+      increment(shard.outstanding_work_, result);
+    }
+  }
+}
+
+io_uring_service::submit_sqes_op::submit_sqes_op(
+    io_uring_service* s, shard_state* shard)
   : operation(&io_uring_service::submit_sqes_op::do_complete),
-    service_(s)
+    service_(s),
+    shard_(shard)
 {
 }
 
@@ -740,6 +1713,17 @@ void io_uring_service::submit_sqes_op::do_complete(void* owner, operation* base,
   if (owner)
   {
     submit_sqes_op* o = static_cast<submit_sqes_op*>(base);
+    if (shard_state* shard = o->shard_)
+    {
+      mutex::scoped_lock lock(shard->mutex_);
+      o->service_->submit_shard_sqes(*shard);
+      if (shard->pending_sqes_ != 0)
+        o->service_->scheduler_.post_to_thread(shard->index_, o);
+      else
+        shard->pending_submit_sqes_op_ = false;
+      return;
+    }
+
     mutex::scoped_lock lock(o->service_->mutex_);
     o->service_->submit_sqes();
     if (o->service_->pending_sqes_ != 0)
@@ -825,12 +1809,13 @@ operation* io_uring_service::io_queue::perform_io(int result)
   if (!op_queue_.empty())
   {
     io_uring_service* service = io_object_->service_;
-    mutex::scoped_lock lock(service->mutex_);
-    if (::io_uring_sqe* sqe = service->get_sqe())
+    mutex::scoped_lock lock(service->ring_mutex(io_object_));
+    if (::io_uring_sqe* sqe = service->get_sqe(io_object_))
     {
       op_queue_.front()->prepare(sqe);
+      use_fixed_file(io_object_, sqe);
       ::io_uring_sqe_set_data(sqe, this);
-      service->post_submit_sqes_op(lock);
+      service->post_submit_sqes_op(io_object_, lock);
     }
     else
     {
@@ -866,8 +1851,39 @@ void io_uring_service::io_queue::do_complete(void* owner, operation* base,
 }
 
 io_uring_service::io_object::io_object(bool locking)
-  : mutex_(locking)
+  : mutex_(locking),
+    shard_(0)
+{
+}
+
+io_uring_service::shard_state::shard_state(
+    io_uring_service* s, std::size_t index)
+  : operation(&io_uring_service::shard_state::do_complete),
+    service_(s),
+    mutex_(s->mutex_.enabled()),
+    index_(index),
+    pending_sqes_(0),
+    pending_submit_sqes_op_(false),
+    armed_(false),
+    queued_(false),
+    waiting_(false),
+    wakeup_fd_(-1),
+    wakeup_value_(0),
+    wakeup_armed_(false),
+    outstanding_work_(0),
+    submit_sqes_op_(s, this)
 {
+  ring_.ring_fd = -1;
+}
+
+void io_uring_service::shard_state::do_complete(void* owner, operation* base,
+    const asio::error_code& /*ec*/, std::size_t /*bytes_transferred*/)
+{
+  if (owner)
+  {
+    shard_state* shard = static_cast<shard_state*>(base);
+    shard->service_->reap_shard(*shard);
+  }
 }
 
 } // namespace detail
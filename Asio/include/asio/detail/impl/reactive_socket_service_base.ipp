@@ -290,6 +290,56 @@ void reactive_socket_service_base::start_connect_op(
   reactor_.post_immediate_completion(op, is_continuation);
 }
 
+asio::error_code reactive_socket_service_base::set_io_quota(
+    reactive_socket_service_base::base_implementation_type& impl,
+    const void* optval, std::size_t optlen, asio::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return ec;
+  }
+
+  if (optlen != sizeof(int) || *static_cast<const int*>(optval) < 0)
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+#if defined(ASIO_HAS_EPOLL)
+  ec = reactor_.set_io_quota(impl.reactor_data_,
+      *static_cast<const int*>(optval));
+#else // defined(ASIO_HAS_EPOLL)
+  ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_EPOLL)
+  return ec;
+}
+
+asio::error_code reactive_socket_service_base::get_io_quota(
+    const reactive_socket_service_base::base_implementation_type& impl,
+    void* optval, std::size_t* optlen, asio::error_code& ec) const
+{
+  if (!is_open(impl))
+  {
+    ec = asio::error::bad_descriptor;
+    return ec;
+  }
+
+  if (*optlen != sizeof(int))
+  {
+    ec = asio::error::invalid_argument;
+    return ec;
+  }
+
+#if defined(ASIO_HAS_EPOLL)
+  *static_cast<int*>(optval) = reactor_.io_quota(impl.reactor_data_);
+  ec = asio::error_code();
+#else // defined(ASIO_HAS_EPOLL)
+  ec = asio::error::operation_not_supported;
+#endif // defined(ASIO_HAS_EPOLL)
+  return ec;
+}
+
 } // namespace detail
 } // namespace asio
 
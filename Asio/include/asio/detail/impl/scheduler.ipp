@@ -17,8 +17,10 @@
 
 #include "asio/detail/config.hpp"
 
+#include "asio/detail/chrono.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/event.hpp"
+#include "asio/detail/handler_watchdog.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/scheduler.hpp"
 #include "asio/detail/scheduler_thread_info.hpp"
@@ -30,6 +32,16 @@
 # include "asio/detail/reactor.hpp"
 #endif // defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 
+#if defined(ASIO_HAS_STD_THREAD)
+# include <thread>
+#elif !defined(ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sched.h>
+#endif // defined(ASIO_HAS_STD_THREAD)
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+# include <intrin.h>
+#endif // defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -65,12 +77,51 @@ struct scheduler::task_cleanup
     }
     this_thread_->private_outstanding_work = 0;
 
+    // Completed operations with a high or low priority go to the priority
+    // queues, whichever queue the remaining operations are added to.
+    op_queue<operation> prioritised;
+    scheduler::split_prioritised(this_thread_->private_op_queue, prioritised);
+
+    // When work stealing, the completed operations belong to this thread's
+    // local queue, from where they may be taken by other idle threads.
+    // They are tracked until taken, as the task is not run again before then.
+    if (this_thread_->worker_index != thread_info::not_a_worker)
+    {
+      std::size_t n = scheduler_->track_task_output(
+          this_thread_->private_op_queue);
+      if (n > 0)
+      {
+        asio::detail::mutex::scoped_lock local_lock(
+            this_thread_->queues->local_mutex);
+        this_thread_->queues->local_op_queue.push(
+            this_thread_->private_op_queue);
+        this_thread_->local_op_count += n;
+      }
+    }
+
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
     lock_->lock();
+    this_thread_->run_state = thread_info::running;
     scheduler_->task_interrupted_ = true;
-    scheduler_->op_queue_.push(this_thread_->private_op_queue);
+    scheduler_->handlers_since_poll_ = 0;
+    if (scheduler_->poll_time_limit_usec_ != 0)
+      scheduler_->last_poll_usec_ = scheduler::clock_usec();
+    scheduler_->push_prioritised(prioritised);
+    if (scheduler_->poll_handler_limit_ != 0
+        || scheduler_->poll_time_limit_usec_ != 0)
+    {
+      // With a poll limit the task may be moved ahead of other handlers, but
+      // only once its completed operations have been taken. These are run
+      // first so that the task is not held back for long.
+      scheduler_->track_task_output(this_thread_->private_op_queue);
+      scheduler_->op_queue_.push_front(this_thread_->private_op_queue);
+    }
+    else
+      scheduler_->op_queue_.push(this_thread_->private_op_queue);
     scheduler_->op_queue_.push(&scheduler_->task_operation_);
+    if (scheduler_->busy_poll_)
+      ++scheduler_->busy_poll_epoch_;
   }
 
   scheduler* scheduler_;
@@ -97,8 +148,20 @@ struct scheduler::work_cleanup
 #if defined(ASIO_HAS_THREADS)
     if (!this_thread_->private_op_queue.empty())
     {
-      lock_->lock();
-      scheduler_->op_queue_.push(this_thread_->private_op_queue);
+      if (this_thread_->worker_index != thread_info::not_a_worker)
+      {
+        std::size_t n = 0;
+        for (operation* o = this_thread_->private_op_queue.front();
+            o; o = op_queue_access::next(o))
+          ++n;
+        scheduler_->post_local(*this_thread_,
+            this_thread_->private_op_queue, n);
+      }
+      else
+      {
+        lock_->lock();
+        scheduler_->op_queue_.push(this_thread_->private_op_queue);
+      }
     }
 #endif // defined(ASIO_HAS_THREADS)
   }
@@ -108,6 +171,66 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::worker_cleanup
+{
+  ~worker_cleanup()
+  {
+    // Move any handlers left on the local queue to the shared queue, where
+    // they can be run by other threads or by a subsequent call to run().
+    lock_->lock();
+    scheduler_->workers_[this_thread_->worker_index] = 0;
+    this_thread_->worker_index = thread_info::not_a_worker;
+    asio::detail::mutex::scoped_lock local_lock(
+        this_thread_->queues->local_mutex);
+    bool more_handlers = !this_thread_->queues->local_op_queue.empty();
+    scheduler_->op_queue_.push(this_thread_->queues->local_op_queue);
+    this_thread_->local_op_count = 0;
+    local_lock.unlock();
+    if (more_handlers && !scheduler_->stopped_)
+      scheduler_->wake_one_thread_and_unlock(*lock_);
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::run_thread_cleanup
+{
+  ~run_thread_cleanup()
+  {
+    if (this_thread_->run_index == thread_info::not_a_run_thread)
+      return;
+
+    // Move any handlers left on the targeted queues to the shared queues,
+    // where they can be run by other threads or by a subsequent call to run().
+    lock_->lock();
+    scheduler_->run_threads_[this_thread_->run_index] = 0;
+    this_thread_->run_index = thread_info::not_a_run_thread;
+    asio::detail::mutex::scoped_lock local_lock(
+        this_thread_->queues->local_mutex);
+    std::size_t n = 0;
+    for (operation* o = this_thread_->queues->targeted_op_queue.front();
+        o; o = op_queue_access::next(o))
+      ++n;
+    op_queue<operation> prioritised;
+    prioritised.push(this_thread_->queues->targeted_high_priority_queue);
+    prioritised.push(this_thread_->queues->targeted_low_priority_queue);
+    for (operation* o = prioritised.front(); o; o = op_queue_access::next(o))
+      ++n;
+    asio::detail::decrement(scheduler_->targeted_ops_, static_cast<long>(n));
+    scheduler_->op_queue_.push(this_thread_->queues->targeted_op_queue);
+    scheduler_->push_prioritised(prioritised);
+    local_lock.unlock();
+    if (n > 0 && !scheduler_->stopped_)
+      scheduler_->wake_threads_and_unlock(*lock_, n);
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
 scheduler::scheduler(asio::execution_context& ctx,
     int concurrency_hint, bool own_thread, get_task_func_type get_task)
   : asio::detail::execution_context_service_base<scheduler>(ctx),
@@ -119,12 +242,67 @@ scheduler::scheduler(asio::execution_context& ctx,
     mutex_(ASIO_CONCURRENCY_HINT_IS_LOCKING(
           SCHEDULER, concurrency_hint)),
     task_(0),
+    thread_task_(0),
     get_task_(get_task),
     task_interrupted_(true),
+    task_ops_pending_(0),
     outstanding_work_(0),
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
+    work_stealing_(!one_thread_
+        && ASIO_CONCURRENCY_HINT_IS_ENABLED(WORK_STEALING, concurrency_hint)),
+    lockfree_post_(ASIO_CONCURRENCY_HINT_IS_LOCKING(SCHEDULER, concurrency_hint)
+        && ASIO_CONCURRENCY_HINT_IS_ENABLED(LOCKFREE_POST, concurrency_hint)),
+    modes_((lockfree_post_ ? injection_mode : 0)
+        | (work_stealing_ ? task_output_mode : 0)
+        | (ASIO_POLL_HANDLER_LIMIT != 0 || ASIO_POLL_TIME_LIMIT_USEC != 0
+          ? poll_limit_mode | task_output_mode : 0)),
+    high_priority_ops_(0),
+    low_priority_ops_(0),
+    high_priority_streak_(0),
+    low_priority_wait_(0),
+#if defined(ASIO_HAS_CHRONO) \
+  && (!defined(ASIO_HAS_THREADS) || defined(ASIO_HAS_STD_ATOMIC))
+    busy_poll_(ASIO_CONCURRENCY_HINT_IS_ENABLED(BUSY_POLL, concurrency_hint)),
+#else // defined(ASIO_HAS_CHRONO)
+    busy_poll_(false),
+#endif // defined(ASIO_HAS_CHRONO)
+    busy_poll_max_usec_(ASIO_BUSY_POLL_USEC),
+    busy_poll_usec_(ASIO_BUSY_POLL_USEC),
+    busy_poll_hits_(0),
+    busy_poll_misses_(0),
+    busy_poll_epoch_(0),
+    poll_handler_limit_(ASIO_POLL_HANDLER_LIMIT),
+    poll_time_limit_usec_(ASIO_POLL_TIME_LIMIT_USEC),
+    handlers_since_poll_(0),
+    last_poll_usec_(clock_usec()),
+    handler_limit_polls_(0),
+    time_limit_polls_(0),
+#if defined(ASIO_HAS_IO_URING)
+    io_uring_sqpoll_idle_msec_(ASIO_IO_URING_SQPOLL_IDLE_MSEC),
+    io_uring_sqpoll_cpu_(-1),
+    io_uring_ring_size_(ASIO_IO_URING_RING_SIZE),
+#endif // defined(ASIO_HAS_IO_URING)
+    targeted_ops_(0),
+    lifo_wake_(!one_thread_
+        && ASIO_CONCURRENCY_HINT_IS_ENABLED(LIFO_WAKE, concurrency_hint)),
+    thread_indexes_(!one_thread_
+        && (ASIO_CONCURRENCY_HINT_IS_ENABLED(
+            THREAD_TARGETING, concurrency_hint)
+          || ASIO_CONCURRENCY_HINT_IS_ENABLED(
+            LIFO_WAKE, concurrency_hint)
+          || ASIO_CONCURRENCY_HINT_IS_ENABLED(
+            SHARDED_REACTOR, concurrency_hint)
+          || ASIO_CONCURRENCY_HINT_IS_ENABLED(
+            SHARDED_IO_URING, concurrency_hint))),
+    thread_tasks_(thread_indexes_
+        && (ASIO_CONCURRENCY_HINT_IS_ENABLED(
+            SHARDED_REACTOR, concurrency_hint)
+          || ASIO_CONCURRENCY_HINT_IS_ENABLED(
+            SHARDED_IO_URING, concurrency_hint))),
+    idle_workers_(0),
+    stopped_flag_(0),
     thread_(0)
 {
   ASIO_HANDLER_TRACKING_INIT;
@@ -167,6 +345,12 @@ void scheduler::shutdown()
   }
 
   // Destroy handler objects.
+  take_injected();
+  op_queue_.push(high_priority_queue_);
+  op_queue_.push(low_priority_queue_);
+  decrement(high_priority_ops_, static_cast<long>(high_priority_ops_));
+  decrement(low_priority_ops_, static_cast<long>(low_priority_ops_));
+  decrement(task_ops_pending_, static_cast<long>(task_ops_pending_));
   while (!op_queue_.empty())
   {
     operation* o = op_queue_.front();
@@ -177,6 +361,7 @@ void scheduler::shutdown()
 
   // Reset to initial state.
   task_ = 0;
+  thread_task_ = 0;
 }
 
 void scheduler::init_task()
@@ -190,6 +375,23 @@ void scheduler::init_task()
   }
 }
 
+void scheduler::init_thread_task(scheduler_task* task)
+{
+  mutex::scoped_lock lock(mutex_);
+  if (shutdown_ || thread_task_ == task)
+    return;
+
+  // Threads waiting on the previous task go round again to wait on the new
+  // one.
+  for (std::size_t i = idle_threads_.size(); i > 0; --i)
+  {
+    thread_info& idle_thread = *idle_threads_[i - 1];
+    if (idle_thread.run_state == thread_info::waiting_in_task)
+      wake_idle_thread(lock, idle_thread);
+  }
+  thread_task_ = task;
+}
+
 std::size_t scheduler::run(asio::error_code& ec)
 {
   ec = asio::error_code();
@@ -205,6 +407,9 @@ std::size_t scheduler::run(asio::error_code& ec)
 
   mutex::scoped_lock lock(mutex_);
 
+  if (work_stealing_ || thread_indexes_)
+    return run_registered(lock, this_thread, ec);
+
   std::size_t n = 0;
   for (; do_run_one(lock, this_thread, ec); lock.lock())
     if (n != (std::numeric_limits<std::size_t>::max)())
@@ -212,6 +417,39 @@ std::size_t scheduler::run(asio::error_code& ec)
   return n;
 }
 
+std::size_t scheduler::run_registered(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, asio::error_code& ec)
+{
+  // Other threads may take operations from this thread, or target operations
+  // at it and wake it alone, so it has its own queues and event.
+  scheduler_thread_queues queues;
+  event wakeup_event;
+  this_thread.queues = &queues;
+  this_thread.wakeup_event = &wakeup_event;
+  if (thread_indexes_)
+    register_run_thread(this_thread);
+  run_thread_cleanup on_run_exit = { this, &lock, &this_thread };
+  (void)on_run_exit;
+
+  std::size_t n = 0;
+  if (work_stealing_)
+  {
+    register_worker(this_thread);
+    worker_cleanup on_exit = { this, &lock, &this_thread };
+    (void)on_exit;
+
+    for (; do_run_one_stealing(lock, this_thread, ec); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+
+  for (; do_run_one(lock, this_thread, ec); lock.lock())
+    if (n != (std::numeric_limits<std::size_t>::max)())
+      ++n;
+  return n;
+}
+
 std::size_t scheduler::run_one(asio::error_code& ec)
 {
   ec = asio::error_code();
@@ -321,9 +559,34 @@ bool scheduler::stopped() const
 void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
+  if (stopped_ && (work_stealing_ || busy_poll_))
+    --stopped_flag_;
   stopped_ = false;
 }
 
+void scheduler::set_busy_poll_usec(long usec)
+{
+  busy_poll_max_usec_ = usec > 0 ? usec : 0;
+  busy_poll_usec_ = usec > 0 ? usec : 0;
+}
+
+void scheduler::set_poll_handler_limit(std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  poll_handler_limit_ = n;
+  if (n != 0)
+    modes_ |= poll_limit_mode | task_output_mode;
+}
+
+void scheduler::set_poll_time_limit_usec(long usec)
+{
+  mutex::scoped_lock lock(mutex_);
+  poll_time_limit_usec_ = usec > 0 ? usec : 0;
+  last_poll_usec_ = clock_usec();
+  if (usec > 0)
+    modes_ |= poll_limit_mode | task_output_mode;
+}
+
 void scheduler::compensating_work_started()
 {
   thread_info_base* this_thread = thread_call_stack::contains(this);
@@ -344,7 +607,26 @@ void scheduler::capture_current_exception()
 void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
+  if (op->priority() != operation::normal_priority)
+  {
+    work_started();
+    post_prioritised(op);
+    return;
+  }
+
 #if defined(ASIO_HAS_THREADS)
+  if (work_stealing_)
+  {
+    if (thread_info* this_thread = current_worker())
+    {
+      work_started();
+      op_queue<operation> ops;
+      ops.push(op);
+      post_local(*this_thread, ops, 1);
+      return;
+    }
+  }
+
   if (one_thread_ || is_continuation)
   {
     if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -359,6 +641,12 @@ void scheduler::post_immediate_completion(
 #endif // defined(ASIO_HAS_THREADS)
 
   work_started();
+  if (lockfree_post_)
+  {
+    post_injected(op);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -367,7 +655,26 @@ void scheduler::post_immediate_completion(
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
+  op_queue<operation> prioritised;
+  if (std::size_t m = split_prioritised(ops, prioritised))
+  {
+    increment(outstanding_work_, static_cast<long>(m));
+    post_prioritised(prioritised, m);
+    if ((n -= m) == 0)
+      return;
+  }
+
 #if defined(ASIO_HAS_THREADS)
+  if (work_stealing_)
+  {
+    if (thread_info* this_thread = current_worker())
+    {
+      increment(outstanding_work_, static_cast<long>(n));
+      post_local(*this_thread, ops, n);
+      return;
+    }
+  }
+
   if (one_thread_ || is_continuation)
   {
     if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -383,14 +690,37 @@ void scheduler::post_immediate_completions(std::size_t n,
 #endif // defined(ASIO_HAS_THREADS)
 
   increment(outstanding_work_, static_cast<long>(n));
+  if (lockfree_post_)
+  {
+    post_injected(ops);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(ops);
-  wake_one_thread_and_unlock(lock);
+  wake_threads_and_unlock(lock, n);
 }
 
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
+  if (op->priority() != operation::normal_priority)
+  {
+    post_prioritised(op);
+    return;
+  }
+
 #if defined(ASIO_HAS_THREADS)
+  if (work_stealing_)
+  {
+    if (thread_info* this_thread = current_worker())
+    {
+      op_queue<operation> ops;
+      ops.push(op);
+      post_local(*this_thread, ops, 1);
+      return;
+    }
+  }
+
   if (one_thread_)
   {
     if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -401,6 +731,12 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
   }
 #endif // defined(ASIO_HAS_THREADS)
 
+  if (lockfree_post_)
+  {
+    post_injected(op);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -409,9 +745,25 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
 void scheduler::post_deferred_completions(
     op_queue<scheduler::operation>& ops)
 {
+  op_queue<operation> prioritised;
+  if (std::size_t m = split_prioritised(ops, prioritised))
+    post_prioritised(prioritised, m);
+
   if (!ops.empty())
   {
 #if defined(ASIO_HAS_THREADS)
+    if (work_stealing_)
+    {
+      if (thread_info* this_thread = current_worker())
+      {
+        std::size_t n = 0;
+        for (operation* o = ops.front(); o; o = op_queue_access::next(o))
+          ++n;
+        post_local(*this_thread, ops, n);
+        return;
+      }
+    }
+
     if (one_thread_)
     {
       if (thread_info_base* this_thread = thread_call_stack::contains(this))
@@ -422,6 +774,12 @@ void scheduler::post_deferred_completions(
     }
 #endif // defined(ASIO_HAS_THREADS)
 
+    if (lockfree_post_)
+    {
+      post_injected(ops);
+      return;
+    }
+
     mutex::scoped_lock lock(mutex_);
     op_queue_.push(ops);
     wake_one_thread_and_unlock(lock);
@@ -432,11 +790,141 @@ void scheduler::do_dispatch(
     scheduler::operation* op)
 {
   work_started();
+  if (op->priority() != operation::normal_priority)
+  {
+    post_prioritised(op);
+    return;
+  }
+
+  if (lockfree_post_)
+  {
+    post_injected(op);
+    return;
+  }
+
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::post_to_thread(std::size_t index,
+    scheduler::operation* op)
+{
+  work_started();
+  op_queue<operation> ops;
+  ops.push(op);
+  post_deferred_completions_to_thread(index, ops);
+}
+
+void scheduler::post_deferred_completions_to_thread(
+    std::size_t index, op_queue<scheduler::operation>& ops)
+{
+  mutex::scoped_lock lock(mutex_);
+  thread_info* target = index < run_threads_.size() ? run_threads_[index] : 0;
+  if (target == 0)
+  {
+    // There is no thread with the index, so any thread may run the operations.
+    lock.unlock();
+    post_deferred_completions(ops);
+    return;
+  }
+
+  {
+    asio::detail::mutex::scoped_lock local_lock(target->queues->local_mutex);
+    push_targeted(*target, ops);
+  }
+
+  if (busy_poll_)
+    ++busy_poll_epoch_;
+
+  // An idle target waits on its own event, or on its part of the task. A
+  // target that is running a handler will look at its targeted queue before
+  // running another.
+  if (target->run_state == thread_info::waiting
+      || target->run_state == thread_info::waiting_in_task)
+  {
+    wake_idle_thread(lock, *target);
+  }
+  else if (target->run_state == thread_info::running_task)
+  {
+    if (!task_interrupted_ && task_)
+    {
+      task_interrupted_ = true;
+      task_->interrupt();
+    }
+  }
+}
+
+void scheduler::wait_for_wakeup(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  if (one_thread_ || this_thread.run_index == thread_info::not_a_run_thread)
+  {
+    wakeup_event_.clear(lock);
+    wakeup_event_.wait(lock);
+    return;
+  }
+
+  // The thread is taken off the idle list by the thread that wakes it.
+  this_thread.run_state = thread_info::waiting;
+  if (lifo_wake_)
+    this_thread.idle_since_usec = clock_usec();
+  idle_threads_.push_back(&this_thread);
+
+  scheduler_task* thread_task = thread_task_ ? thread_task_ : task_;
+  if (thread_tasks_ && thread_task)
+  {
+    // A thread that owns part of the task waits on it, so that the thread
+    // itself sees the events that it is to dispatch.
+    this_thread.run_state = thread_info::waiting_in_task;
+    lock.unlock();
+    op_queue<operation> ops;
+    bool waited = thread_task->run_thread(this_thread.run_index, ops);
+    lock.lock();
+
+    if (this_thread.run_state == thread_info::waiting_in_task)
+    {
+      if (waited)
+      {
+        remove_idle_thread(this_thread);
+        this_thread.run_state = thread_info::running;
+      }
+      else
+        this_thread.run_state = thread_info::waiting;
+    }
+
+    if (!ops.empty())
+    {
+      asio::detail::mutex::scoped_lock local_lock(
+          this_thread.queues->local_mutex);
+      push_targeted(this_thread, ops);
+    }
+  }
+
+  this_thread.wakeup_event->clear(lock);
+  while (this_thread.run_state == thread_info::waiting)
+    this_thread.wakeup_event->wait(lock);
+}
+
+std::size_t scheduler::this_thread_index()
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    return static_cast<thread_info*>(this_thread)->run_index;
+  return thread_info::not_a_run_thread;
+}
+
+std::size_t scheduler::run_thread_index_limit()
+{
+  mutex::scoped_lock lock(mutex_);
+  return run_threads_.size();
+}
+
+std::size_t scheduler::idle_thread_count()
+{
+  mutex::scoped_lock lock(mutex_);
+  return idle_threads_.size();
+}
+
 void scheduler::abandon_operations(
     op_queue<scheduler::operation>& ops)
 {
@@ -448,21 +936,34 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const asio::error_code& ec)
 {
+  // When busy polling, the time at which this thread ran out of work.
+  int64_t idle_start = -1;
+
   while (!stopped_)
   {
-    if (!op_queue_.empty())
+    prepare_shared_queue();
+
+    // Operations targeted at this thread are run ahead of the shared queue.
+    operation* o = pop_targeted(this_thread);
+
+    if (o == 0 && (o = front_shared()) != 0)
     {
       // Prepare to execute first handler from queue.
-      operation* o = op_queue_.front();
       op_queue_.pop();
-      bool more_handlers = (!op_queue_.empty());
 
       if (o == &task_operation_)
       {
-        task_interrupted_ = more_handlers;
+        bool more_handlers = handlers_queued();
+
+        // A busy polling thread with nothing else to do polls the task until
+        // its spin window has elapsed.
+        bool spin = !more_handlers && busy_poll_ && busy_poll_spin(idle_start);
+
+        task_interrupted_ = more_handlers || spin;
+        this_thread.run_state = thread_info::running_task;
 
         if (more_handlers && !one_thread_)
-          wakeup_event_.unlock_and_signal_one(lock);
+          unlock_and_wake_idle_thread(lock);
         else
           lock.unlock();
 
@@ -472,32 +973,44 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        task_->run(more_handlers || spin ? 0 : -1,
+            this_thread.private_op_queue);
+        continue;
       }
-      else
-      {
-        std::size_t task_result = o->task_result_;
+    }
 
-        if (more_handlers && !one_thread_)
-          wake_one_thread_and_unlock(lock);
-        else
-          lock.unlock();
+    if (o)
+    {
+      if (idle_start != -1)
+        busy_poll_hit(idle_start);
 
-        // Ensure the count of outstanding work is decremented on block exit.
-        work_cleanup on_exit = { this, &lock, &this_thread };
-        (void)on_exit;
+      task_output_dequeued(o);
+      std::size_t task_result = o->task_result_;
 
-        // Complete the operation. May throw an exception. Deletes the object.
-        o->complete(this, ec, task_result);
-        this_thread.rethrow_pending_exception();
+      if (handlers_queued() && !one_thread_)
+        wake_one_thread_and_unlock(lock);
+      else
+        lock.unlock();
 
-        return 1;
-      }
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      ASIO_HANDLER_WATCHDOG_SCOPE((*o));
+      o->complete(this, ec, task_result);
+      this_thread.rethrow_pending_exception();
+
+      return 1;
+    }
+    else if (busy_poll_ && busy_poll_spin(idle_start))
+    {
+      // Another thread is running the task.
+      busy_poll_wait(lock, idle_start);
     }
     else
     {
-      wakeup_event_.clear(lock);
-      wakeup_event_.wait(lock);
+      wait_for_wakeup(lock, this_thread);
     }
   }
 
@@ -511,24 +1024,26 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  prepare_shared_queue();
+  operation* o = front_shared();
   if (o == 0)
   {
     wakeup_event_.clear(lock);
     wakeup_event_.wait_for_usec(lock, usec);
     usec = 0; // Wait at most once.
-    o = op_queue_.front();
+    prepare_shared_queue();
+    o = front_shared();
   }
 
   if (o == &task_operation_)
   {
     op_queue_.pop();
-    bool more_handlers = (!op_queue_.empty());
+    bool more_handlers = handlers_queued();
 
     task_interrupted_ = more_handlers;
 
     if (more_handlers && !one_thread_)
-      wakeup_event_.unlock_and_signal_one(lock);
+      unlock_and_wake_idle_thread(lock);
     else
       lock.unlock();
 
@@ -542,11 +1057,13 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
     }
 
+    take_injected();
+    take_prioritised();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
       if (!one_thread_)
-        wakeup_event_.maybe_unlock_and_signal_one(lock);
+        maybe_wake_idle_thread(lock);
       return 0;
     }
   }
@@ -555,7 +1072,8 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     return 0;
 
   op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  task_output_dequeued(o);
+  bool more_handlers = handlers_queued();
 
   std::size_t task_result = o->task_result_;
 
@@ -569,6 +1087,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  ASIO_HANDLER_WATCHDOG_SCOPE((*o));
   o->complete(this, ec, task_result);
   this_thread.rethrow_pending_exception();
 
@@ -582,7 +1101,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
-  operation* o = op_queue_.front();
+  prepare_shared_queue();
+  operation* o = front_shared();
   if (o == &task_operation_)
   {
     op_queue_.pop();
@@ -598,10 +1118,12 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
       task_->run(0, this_thread.private_op_queue);
     }
 
+    take_injected();
+    take_prioritised();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
-      wakeup_event_.maybe_unlock_and_signal_one(lock);
+      maybe_wake_idle_thread(lock);
       return 0;
     }
   }
@@ -610,7 +1132,8 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
     return 0;
 
   op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  task_output_dequeued(o);
+  bool more_handlers = handlers_queued();
 
   std::size_t task_result = o->task_result_;
 
@@ -624,6 +1147,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
+  ASIO_HANDLER_WATCHDOG_SCOPE((*o));
   o->complete(this, ec, task_result);
   this_thread.rethrow_pending_exception();
 
@@ -633,8 +1157,12 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
 void scheduler::stop_all_threads(
     mutex::scoped_lock& lock)
 {
+  if (!stopped_ && (work_stealing_ || busy_poll_))
+    ++stopped_flag_;
   stopped_ = true;
   wakeup_event_.signal_all(lock);
+  if (!idle_threads_.empty())
+    wake_idle_threads(lock);
 
   if (!task_interrupted_ && task_)
   {
@@ -643,10 +1171,688 @@ void scheduler::stop_all_threads(
   }
 }
 
+std::size_t scheduler::do_run_one_stealing(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread,
+    const asio::error_code& ec)
+{
+  // When busy polling, the time at which this thread ran out of work.
+  int64_t idle_start = -1;
+
+  for (;;)
+  {
+    if (lock.locked())
+      lock.unlock();
+
+    if (stopped_flag_ != 0)
+      return 0;
+
+    // Handlers on the thread's own queue are run without acquiring the shared
+    // mutex. The shared queue holds the task and any handlers posted from
+    // outside the scheduler, and is checked periodically so that neither is
+    // starved by a thread that keeps posting to itself. High priority handlers
+    // are also on the shared queues, and so are looked for first.
+    // Operations targeted at this thread are run ahead of all others.
+    operation* o = pop_targeted(this_thread);
+    if (o == 0 && high_priority_ops_ == 0
+        && ++this_thread.local_tick % shared_queue_interval != 0)
+      o = pop_local(this_thread);
+
+    if (o == 0)
+    {
+      std::size_t local_handlers = this_thread.local_tick;
+      this_thread.local_tick = 0;
+      lock.lock();
+
+      if (stopped_)
+        return 0;
+
+      prepare_shared_queue(local_handlers);
+      if ((o = front_shared()) != 0)
+      {
+        op_queue_.pop();
+        bool more_handlers = handlers_queued();
+
+        if (o == &task_operation_)
+        {
+          // Only block in the task if this thread has nothing else to do.
+          bool more_local;
+          {
+            asio::detail::mutex::scoped_lock local_lock(
+                this_thread.queues->local_mutex);
+            more_local = !this_thread.queues->local_op_queue.empty();
+          }
+
+          bool spin = !more_handlers && !more_local
+            && busy_poll_ && busy_poll_spin(idle_start);
+
+          task_interrupted_ = more_handlers || more_local || spin;
+          this_thread.run_state = thread_info::running_task;
+
+          if (more_handlers)
+            unlock_and_wake_idle_thread(lock);
+          else
+            lock.unlock();
+
+          task_cleanup on_exit = { this, &lock, &this_thread };
+          (void)on_exit;
+
+          // Run the task. May throw an exception. Completed operations are
+          // added to this thread's local queue.
+          task_->run(more_handlers || more_local || spin ? 0 : -1,
+              this_thread.private_op_queue);
+          continue;
+        }
+
+        if (more_handlers)
+          wake_one_thread_and_unlock(lock);
+        else
+          lock.unlock();
+      }
+      else if ((o = pop_local(this_thread)) != 0)
+      {
+        lock.unlock();
+      }
+      else
+      {
+        // Register as idle before looking at the other local queues, so that
+        // a thread adding work after we have looked is sure to wake us. An
+        // operation may also have been targeted at this thread since its
+        // queue was last checked without the lock.
+        ++idle_workers_;
+        o = pop_targeted(this_thread);
+        if (o == 0)
+          o = steal(lock, this_thread);
+        if (o == 0 && task_ops_pending_ == 0
+            && op_queue_.front() == &task_operation_)
+        {
+          // The task's last completed operation was taken after the shared
+          // queue was checked.
+          --idle_workers_;
+          continue;
+        }
+        if (o == 0 && busy_poll_ && busy_poll_spin(idle_start))
+        {
+          busy_poll_wait(lock, idle_start);
+          --idle_workers_;
+          continue;
+        }
+        else if (o == 0)
+        {
+          wait_for_wakeup(lock, this_thread);
+          --idle_workers_;
+          continue;
+        }
+        --idle_workers_;
+        lock.unlock();
+      }
+    }
+
+    if (idle_start != -1)
+      busy_poll_hit(idle_start);
+
+    // Once the last of the task's completed operations has been taken, an
+    // idle thread may run the task again.
+    if (task_output_dequeued(o) && idle_workers_ > 0)
+    {
+      lock.lock();
+      if (!maybe_wake_idle_thread(lock))
+        lock.unlock();
+    }
+
+    std::size_t task_result = o->task_result_;
+
+    // Ensure the count of outstanding work is decremented on block exit.
+    work_cleanup on_exit = { this, &lock, &this_thread };
+    (void)on_exit;
+
+    // Complete the operation. May throw an exception. Deletes the object.
+    ASIO_HANDLER_WATCHDOG_SCOPE((*o));
+    o->complete(this, ec, task_result);
+    this_thread.rethrow_pending_exception();
+
+    return 1;
+  }
+}
+
+scheduler::thread_info* scheduler::current_worker()
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    if (static_cast<thread_info*>(this_thread)->worker_index
+        != thread_info::not_a_worker)
+      return static_cast<thread_info*>(this_thread);
+  return 0;
+}
+
+void scheduler::register_worker(scheduler::thread_info& this_thread)
+{
+  for (std::size_t i = 0; i < workers_.size(); ++i)
+  {
+    if (workers_[i] == 0)
+    {
+      workers_[i] = &this_thread;
+      this_thread.worker_index = i;
+      return;
+    }
+  }
+
+  workers_.push_back(&this_thread);
+  this_thread.worker_index = workers_.size() - 1;
+}
+
+void scheduler::post_local(scheduler::thread_info& this_thread,
+    op_queue<scheduler::operation>& ops, std::size_t n)
+{
+  {
+    asio::detail::mutex::scoped_lock local_lock(
+        this_thread.queues->local_mutex);
+    this_thread.queues->local_op_queue.push(ops);
+    this_thread.local_op_count += n;
+  }
+
+  if (idle_workers_ > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    maybe_wake_idle_thread(lock);
+  }
+}
+
+void scheduler::register_run_thread(scheduler::thread_info& this_thread)
+{
+  for (std::size_t i = 0; i < run_threads_.size(); ++i)
+  {
+    if (run_threads_[i] == 0)
+    {
+      run_threads_[i] = &this_thread;
+      this_thread.run_index = i;
+      return;
+    }
+  }
+
+  run_threads_.push_back(&this_thread);
+  this_thread.run_index = run_threads_.size() - 1;
+}
+
+scheduler::operation* scheduler::take_targeted(
+    scheduler::thread_info& this_thread)
+{
+  if (this_thread.run_index == thread_info::not_a_run_thread)
+    return 0;
+
+  asio::detail::mutex::scoped_lock local_lock(this_thread.queues->local_mutex);
+  op_queue<operation>* q = &this_thread.queues->targeted_high_priority_queue;
+  if (q->empty())
+    q = &this_thread.queues->targeted_op_queue;
+  if (q->empty())
+    q = &this_thread.queues->targeted_low_priority_queue;
+  operation* o = q->front();
+  if (o)
+  {
+    q->pop();
+    --targeted_ops_;
+  }
+  return o;
+}
+
+void scheduler::push_targeted(scheduler::thread_info& target,
+    op_queue<scheduler::operation>& ops)
+{
+  while (operation* o = ops.front())
+  {
+    ops.pop();
+    if (o->priority() == operation::high_priority)
+      target.queues->targeted_high_priority_queue.push(o);
+    else if (o->priority() == operation::low_priority)
+      target.queues->targeted_low_priority_queue.push(o);
+    else
+      target.queues->targeted_op_queue.push(o);
+    ++targeted_ops_;
+  }
+}
+
+scheduler::operation* scheduler::pop_local(scheduler::thread_info& this_thread)
+{
+  asio::detail::mutex::scoped_lock local_lock(this_thread.queues->local_mutex);
+  operation* o = this_thread.queues->local_op_queue.front();
+  if (o)
+  {
+    this_thread.queues->local_op_queue.pop();
+    --this_thread.local_op_count;
+  }
+  return o;
+}
+
+scheduler::operation* scheduler::steal(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread)
+{
+  std::size_t num_workers = workers_.size();
+  for (std::size_t i = 1; i < num_workers; ++i)
+  {
+    thread_info* victim =
+      workers_[(this_thread.worker_index + i) % num_workers];
+    if (victim == 0)
+      continue;
+
+    // Take half of the victim's handlers, rounding up.
+    op_queue<operation> ops;
+    std::size_t n = 0;
+    bool more_handlers = false;
+    {
+      asio::detail::mutex::scoped_lock victim_lock(victim->queues->local_mutex);
+      if (victim->local_op_count == 0)
+        continue;
+      n = (victim->local_op_count + 1) / 2;
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        operation* o = victim->queues->local_op_queue.front();
+        victim->queues->local_op_queue.pop();
+        ops.push(o);
+      }
+      victim->local_op_count -= n;
+      more_handlers = (victim->local_op_count > 0);
+    }
+
+    operation* o = ops.front();
+    ops.pop();
+
+    if (n > 1)
+    {
+      asio::detail::mutex::scoped_lock local_lock(
+          this_thread.queues->local_mutex);
+      this_thread.queues->local_op_queue.push(ops);
+      this_thread.local_op_count += n - 1;
+    }
+
+    // Let another idle thread look for the remaining work.
+    if (n > 1 || more_handlers)
+      maybe_wake_idle_thread(lock);
+
+    return o;
+  }
+
+  return 0;
+}
+
+void scheduler::post_injected(scheduler::operation* op)
+{
+  // Only the thread that makes the queue non-empty needs to wake a thread. Any
+  // thread that is not waiting will empty the queue the next time it acquires
+  // the lock.
+  if (injected_ops_.push(op))
+  {
+    mutex::scoped_lock lock(mutex_);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+void scheduler::post_injected(op_queue<scheduler::operation>& ops)
+{
+  if (injected_ops_.push(ops))
+  {
+    mutex::scoped_lock lock(mutex_);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+bool scheduler::busy_poll_spin(int64_t& idle_start)
+{
+  int64_t now = clock_usec();
+  if (idle_start == -1)
+    idle_start = now;
+
+  if (now - idle_start < busy_poll_usec_)
+    return true;
+
+  // The idle period has outlasted the spin window, so spin for less time on
+  // the next one. The window never shrinks to nothing, so that it can grow
+  // again when work starts arriving sooner.
+  if (busy_poll_max_usec_ > 0)
+  {
+    ++busy_poll_misses_;
+    long min_usec = busy_poll_max_usec_ / 16 + 1;
+    long usec = busy_poll_usec_ / 2;
+    busy_poll_usec_ = usec > min_usec ? usec : min_usec;
+  }
+
+  idle_start = -1;
+  return false;
+}
+
+void scheduler::busy_poll_hit(int64_t idle_start)
+{
+  ++busy_poll_hits_;
+
+  // Make the window long enough to cover an idle period of twice this length.
+  int64_t usec = 2 * (clock_usec() - idle_start);
+  long max_usec = busy_poll_max_usec_;
+  if (usec > busy_poll_usec_)
+    busy_poll_usec_ = usec < max_usec ? static_cast<long>(usec) : max_usec;
+}
+
+void scheduler::busy_poll_wait(mutex::scoped_lock& lock, int64_t idle_start)
+{
+  long epoch = busy_poll_epoch_;
+  lock.unlock();
+  for (int checks = 0; busy_poll_epoch_ == epoch && stopped_flag_ == 0
+      && clock_usec() - idle_start < busy_poll_usec_; ++checks)
+  {
+    busy_poll_pause(checks);
+  }
+  lock.lock();
+}
+
+void scheduler::busy_poll_pause(int checks)
+{
+  // A spinning thread gives up the processor once it has made enough checks
+  // to cover a short idle period, so that it does not starve other threads
+  // that share the core.
+  if (checks >= busy_poll_pause_checks)
+  {
+#if defined(ASIO_HAS_STD_THREAD)
+    std::this_thread::yield();
+#elif defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    ::SwitchToThread();
+#else // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    ::sched_yield();
+#endif // defined(ASIO_WINDOWS) || defined(__CYGWIN__)
+    return;
+  }
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) \
+  && (defined(__i386__) || defined(__x86_64__))
+  __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) \
+  && (defined(__aarch64__) || (defined(__ARM_ARCH) && __ARM_ARCH >= 7))
+  __asm__ __volatile__ ("yield" ::: "memory");
+#endif
+}
+
+int64_t scheduler::clock_usec()
+{
+#if defined(ASIO_HAS_CHRONO)
+  return static_cast<int64_t>(
+      chrono::duration_cast<chrono::microseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+#else // defined(ASIO_HAS_CHRONO)
+  return 0;
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+std::size_t scheduler::split_prioritised(
+    op_queue<scheduler::operation>& ops,
+    op_queue<scheduler::operation>& prioritised)
+{
+  // Most queues contain only normal priority operations, and are left as is.
+  operation* o = ops.front();
+  while (o && o->priority() == operation::normal_priority)
+    o = op_queue_access::next(o);
+  if (o == 0)
+    return 0;
+
+  std::size_t n = 0;
+  op_queue<operation> normal;
+  while ((o = ops.front()) != 0)
+  {
+    ops.pop();
+    if (o->priority() == operation::normal_priority)
+      normal.push(o);
+    else
+    {
+      prioritised.push(o);
+      ++n;
+    }
+  }
+  ops.push(normal);
+  return n;
+}
+
+void scheduler::post_prioritised(scheduler::operation* op)
+{
+  op_queue<operation> ops;
+  ops.push(op);
+  post_prioritised(ops, 1);
+}
+
+void scheduler::post_prioritised(
+    op_queue<scheduler::operation>& ops, std::size_t n)
+{
+  mutex::scoped_lock lock(mutex_);
+  push_prioritised(ops);
+  wake_threads_and_unlock(lock, n);
+}
+
+void scheduler::push_prioritised(op_queue<scheduler::operation>& ops)
+{
+  while (operation* o = ops.front())
+  {
+    ops.pop();
+    modes_ |= priority_mode;
+
+    // The quotas count from the time that a priority queue becomes non-empty.
+    if (o->priority() == operation::high_priority)
+    {
+      if (high_priority_ops_ == 0)
+        high_priority_streak_ = 0;
+      high_priority_queue_.push(o);
+      ++high_priority_ops_;
+    }
+    else
+    {
+      if (low_priority_ops_ == 0)
+        low_priority_wait_ = 0;
+      low_priority_queue_.push(o);
+      ++low_priority_ops_;
+    }
+  }
+}
+
+void scheduler::promote_prioritised()
+{
+  // An operation that was promoted earlier has not yet been taken from the
+  // front of the shared queue.
+  operation* front = op_queue_.front();
+  if (front && front->priority() != operation::normal_priority)
+    return;
+
+  if (high_priority_ops_ != 0)
+  {
+    // High priority operations run first, except that an operation with a
+    // lower priority gets a turn after every ASIO_PRIORITY_QUOTA of them.
+    bool lower_waiting = front != 0 || low_priority_ops_ != 0;
+    if (!lower_waiting || high_priority_streak_ < ASIO_PRIORITY_QUOTA)
+    {
+      if (lower_waiting)
+        ++high_priority_streak_;
+      operation* o = high_priority_queue_.front();
+      high_priority_queue_.pop();
+      --high_priority_ops_;
+      op_queue_.push_front(o);
+      return;
+    }
+
+    high_priority_streak_ = 0;
+    if (front != 0)
+      return;
+  }
+
+  if (low_priority_ops_ != 0)
+  {
+    // Low priority operations run when there are no other handlers, and so
+    // may follow the task. They also get a turn after waiting for
+    // ASIO_PRIORITY_QUOTA other operations.
+    bool idle = front == 0 || (front == &task_operation_
+        && op_queue_access::next(front) == 0);
+    bool starved = ++low_priority_wait_ > ASIO_PRIORITY_QUOTA;
+    if (idle || starved)
+    {
+      low_priority_wait_ = 0;
+      operation* o = low_priority_queue_.front();
+      low_priority_queue_.pop();
+      --low_priority_ops_;
+      if (starved)
+        op_queue_.push_front(o);
+      else
+        op_queue_.push(o);
+    }
+  }
+}
+
+scheduler::operation* scheduler::pass_over_task()
+{
+  operation* o = op_queue_access::next(&task_operation_);
+  if (o)
+  {
+    op_queue_.pop();
+    op_queue_.pop();
+    op_queue_.push_front(&task_operation_);
+    op_queue_.push_front(o);
+  }
+  return o;
+}
+
+std::size_t scheduler::track_task_output(op_queue<scheduler::operation>& ops)
+{
+  std::size_t n = 0;
+  for (operation* o = ops.front(); o; o = op_queue_access::next(o))
+  {
+    o->task_output_ = 1;
+    ++n;
+  }
+  if (n > 0)
+    increment(task_ops_pending_, static_cast<long>(n));
+  return n;
+}
+
+void scheduler::enforce_poll_limits(std::size_t n)
+{
+  handlers_since_poll_ += n;
+
+  operation* front = op_queue_.front();
+  if (front == 0 || front == &task_operation_)
+    return;
+
+  bool handler_limit = poll_handler_limit_ != 0
+    && handlers_since_poll_ >= poll_handler_limit_;
+
+  int64_t now = 0;
+  bool time_limit = false;
+  if (!handler_limit && poll_time_limit_usec_ != 0)
+  {
+    now = clock_usec();
+    time_limit = now - last_poll_usec_ >= poll_time_limit_usec_;
+  }
+
+  if (!handler_limit && !time_limit)
+  {
+    // The handler at the front of the queue is about to be run.
+    ++handlers_since_poll_;
+    return;
+  }
+
+  // The task is not in the queue if another thread is already running it, in
+  // which case that poll is good enough. Nor may it move while operations it
+  // completed on its previous run are still queued, as the reactor does not
+  // expect to find their descriptors ready again until they have been taken.
+  if (task_ops_pending_ != 0)
+    return;
+  if (op_queue_.erase(&task_operation_))
+  {
+    op_queue_.push_front(&task_operation_);
+    if (handler_limit)
+      ++handler_limit_polls_;
+    else
+      ++time_limit_polls_;
+  }
+
+  // Avoid searching the queue again until the task next returns.
+  handlers_since_poll_ = 0;
+  if (time_limit)
+    last_poll_usec_ = now;
+}
+
+std::size_t scheduler::maybe_wake_idle_threads(
+    mutex::scoped_lock& lock, std::size_t n)
+{
+  if (busy_poll_)
+    ++busy_poll_epoch_;
+
+  if (!thread_indexes_)
+  {
+    return n == 1
+      ? (wakeup_event_.maybe_unlock_and_signal_one(lock) ? 1 : 0)
+      : wakeup_event_.maybe_unlock_and_signal_some(lock, n);
+  }
+
+  // Threads inside run() wait on their own events, and are woken in the order
+  // in which they became idle. With LIFO wake, the most recently idled threads
+  // are woken first instead. Once one thread has been woken, threads that have
+  // been idle for longer than the threshold are left to sleep. As the stack is
+  // ordered by idle time, so are all below them.
+  std::size_t count = 0;
+  int64_t now = 0;
+  while (count < n && !idle_threads_.empty())
+  {
+    thread_info* idle_thread = lifo_wake_
+      ? idle_threads_.back() : idle_threads_.front();
+    if (lifo_wake_ && count == 1)
+      now = clock_usec();
+    if (lifo_wake_ && count > 0 && now - idle_thread->idle_since_usec
+        > ASIO_LIFO_WAKE_DEEP_SLEEP_USEC)
+      break;
+    wake_idle_thread(lock, *idle_thread);
+    ++count;
+  }
+
+  // Threads inside run_one(), poll() and the like wait on the shared event.
+  if (count < n)
+    count += wakeup_event_.maybe_unlock_and_signal_some(lock, n - count);
+
+  if (count > 0)
+    lock.unlock();
+  return count;
+}
+
+void scheduler::remove_idle_thread(scheduler::thread_info& idle_thread)
+{
+  for (std::size_t i = idle_threads_.size(); i > 0; --i)
+  {
+    if (idle_threads_[i - 1] == &idle_thread)
+    {
+      idle_threads_.erase(idle_threads_.begin() + (i - 1));
+      break;
+    }
+  }
+}
+
+void scheduler::wake_idle_threads(mutex::scoped_lock& lock)
+{
+  while (!idle_threads_.empty())
+    wake_idle_thread(lock, *idle_threads_.back());
+}
+
+void scheduler::wake_idle_thread(mutex::scoped_lock& lock,
+    scheduler::thread_info& idle_thread)
+{
+  remove_idle_thread(idle_thread);
+
+  if (idle_thread.run_state == thread_info::waiting_in_task)
+  {
+    idle_thread.run_state = thread_info::running;
+    (thread_task_ ? thread_task_ : task_)->interrupt_thread(
+        idle_thread.run_index);
+  }
+  else
+  {
+    idle_thread.run_state = thread_info::running;
+    idle_thread.wakeup_event->signal_all(lock);
+  }
+}
+
 void scheduler::wake_one_thread_and_unlock(
     mutex::scoped_lock& lock)
 {
-  if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
+  if (!maybe_wake_idle_thread(lock))
   {
     if (!task_interrupted_ && task_)
     {
@@ -657,6 +1863,15 @@ void scheduler::wake_one_thread_and_unlock(
   }
 }
 
+void scheduler::wake_threads_and_unlock(
+    mutex::scoped_lock& lock, std::size_t n)
+{
+  if (n > 1 && !one_thread_)
+    if (maybe_wake_idle_threads(lock, n) > 0)
+      return;
+  wake_one_thread_and_unlock(lock);
+}
+
 scheduler_task* scheduler::get_default_task(asio::execution_context& ctx)
 {
 #if defined(ASIO_HAS_IO_URING_AS_DEFAULT)
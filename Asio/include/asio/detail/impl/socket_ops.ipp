@@ -1871,6 +1871,13 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
     return socket_error_retval;
   }
 
+  if (level == custom_socket_option_level && optname == io_quota_option)
+  {
+    // Implemented by the socket service when the reactor supports it.
+    ec = asio::error::operation_not_supported;
+    return socket_error_retval;
+  }
+
   if (level == custom_socket_option_level
       && optname == enable_connection_aborted_option)
   {
@@ -1959,6 +1966,13 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
     return socket_error_retval;
   }
 
+  if (level == custom_socket_option_level && optname == io_quota_option)
+  {
+    // Implemented by the socket service when the reactor supports it.
+    ec = asio::error::operation_not_supported;
+    return socket_error_retval;
+  }
+
   if (level == custom_socket_option_level
       && optname == enable_connection_aborted_option)
   {
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include "asio/detail/handler_watchdog.hpp"
 #include "asio/detail/strand_executor_service.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -146,6 +147,7 @@ void strand_executor_service::run_ready_handlers(implementation_type& impl)
   while (scheduler_operation* o = impl->ready_queue_.front())
   {
     impl->ready_queue_.pop();
+    ASIO_HANDLER_WATCHDOG_SCOPE((*o));
     o->complete(impl.get(), ec, 0);
   }
 }
@@ -58,12 +58,28 @@ win_event::win_event()
         asio::error::get_system_category());
     asio::detail::throw_error(ec, "event");
   }
+
+#if defined(ASIO_WINDOWS_APP)
+  events_[2] = ::CreateSemaphoreExW(0, 0, LONG_MAX, 0, 0, SEMAPHORE_ALL_ACCESS);
+#else // defined(ASIO_WINDOWS_APP)
+  events_[2] = ::CreateSemaphoreW(0, 0, LONG_MAX, 0);
+#endif // defined(ASIO_WINDOWS_APP)
+  if (!events_[2])
+  {
+    DWORD last_error = ::GetLastError();
+    ::CloseHandle(events_[0]);
+    ::CloseHandle(events_[1]);
+    asio::error_code ec(last_error,
+        asio::error::get_system_category());
+    asio::detail::throw_error(ec, "event");
+  }
 }
 
 win_event::~win_event()
 {
   ::CloseHandle(events_[0]);
   ::CloseHandle(events_[1]);
+  ::CloseHandle(events_[2]);
 }
 
 } // namespace detail
@@ -0,0 +1,72 @@
+//
+// detail/io_backend_selector.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_BACKEND_SELECTOR_HPP
+#define ASIO_DETAIL_IO_BACKEND_SELECTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+
+#include "asio/execution_context.hpp"
+#include "asio/detail/io_uring_service.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Decides, once per execution context, whether sockets use the reactor or
+// io_uring. The decision is made from the ASIO_IO_BACKEND environment variable
+// if it is set, and otherwise from the scheduler's concurrency hint. A request
+// for io_uring falls back to the reactor if the ring cannot be created.
+class io_backend_selector
+  : public execution_context_service_base<io_backend_selector>
+{
+public:
+  // Constructor.
+  ASIO_DECL io_backend_selector(asio::execution_context& ctx);
+
+  // Destroy all user-defined handler objects owned by the service.
+  ASIO_DECL void shutdown();
+
+  // Whether sockets should use io_uring.
+  bool use_io_uring() const
+  {
+    return io_uring_service_ != 0;
+  }
+
+private:
+  // Determine whether io_uring has been requested for the given hint.
+  ASIO_DECL static bool io_uring_requested(int concurrency_hint);
+
+  // Determine whether the kernel allows an io_uring instance to be created.
+  ASIO_DECL static bool io_uring_supported();
+
+  // The io_uring service, or 0 if sockets use the reactor.
+  io_uring_service* io_uring_service_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/io_backend_selector.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+#endif // ASIO_DETAIL_IO_BACKEND_SELECTOR_HPP
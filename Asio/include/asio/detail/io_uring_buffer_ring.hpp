@@ -0,0 +1,110 @@
+//
+// detail/io_uring_buffer_ring.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_BUFFER_RING_HPP
+#define ASIO_DETAIL_IO_URING_BUFFER_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING)
+
+#include <cstddef>
+#include <vector>
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/mutex.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A pool of equally sized buffers that is registered with io_uring as a ring
+// of provided buffers. The kernel takes a buffer from the ring only when data
+// arrives for a receive that selects from the ring's buffer group, and the
+// buffer is added back to the ring once the application has finished with it.
+class io_uring_buffer_ring
+  : private noncopyable
+{
+public:
+  // The maximum number of buffers in a ring.
+  enum { max_buffer_count = 32768 };
+
+  // Constructor. The number of buffers must be a power of two.
+  ASIO_DECL io_uring_buffer_ring(io_uring_service& service,
+      std::size_t buffer_count, std::size_t buffer_size);
+
+  // Destructor. Unregisters the ring.
+  ASIO_DECL ~io_uring_buffer_ring();
+
+  // Get the number of buffers in the ring.
+  std::size_t buffer_count() const
+  {
+    return buffer_count_;
+  }
+
+  // Get the size of each buffer in the ring.
+  std::size_t buffer_size() const
+  {
+    return buffer_size_;
+  }
+
+  // Get the buffer group used to select from the ring.
+  int group_id() const
+  {
+    return group_id_;
+  }
+
+  // Get the memory of the buffer with the given identifier.
+  void* buffer(unsigned short id)
+  {
+    return &storage_[0] + id * buffer_size_;
+  }
+
+  // Return the buffer with the given identifier to the ring.
+  ASIO_DECL void recycle(unsigned short id);
+
+private:
+  // The io_uring service with which the ring is registered.
+  io_uring_service& service_;
+
+  // The number and size of the buffers.
+  std::size_t buffer_count_;
+  std::size_t buffer_size_;
+
+  // The memory backing all buffers.
+  std::vector<char> storage_;
+
+  // The ring shared with the kernel.
+  ::io_uring_buf_ring* ring_;
+
+  // The buffer group that identifies the ring.
+  int group_id_;
+
+  // Mutex to protect additions to the ring.
+  mutex mutex_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/detail/impl/io_uring_buffer_ring.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+#endif // ASIO_DETAIL_IO_URING_BUFFER_RING_HPP
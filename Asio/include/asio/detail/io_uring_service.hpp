@@ -19,10 +19,14 @@
 
 #if defined(ASIO_HAS_IO_URING)
 
+#include <cstddef>
+#include <vector>
 #include <liburing.h>
 #include "asio/detail/atomic_count.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
+#include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/io_uring_operation.hpp"
 #include "asio/detail/limits.hpp"
 #include "asio/detail/object_pool.hpp"
@@ -51,6 +55,8 @@ public:
   enum op_types { read_op = 0, write_op = 1, except_op = 2, max_ops = 3 };
 
   class io_object;
+  class multishot_op;
+  class shard_state;
 
   // An I/O queue stores operations that must run serially.
   class io_queue : operation
@@ -82,9 +88,177 @@ public:
     io_queue queues_[max_ops];
     bool shutdown_;
 
+    // The multishot operation running against the object, if any. Protected
+    // by the service's mutex rather than the object's.
+    multishot_op* multishot_op_;
+
+    // The object's descriptor, and its slot in the service's registered file
+    // table or -1 if it has none. The slot is protected by the service's
+    // mutex rather than the object's.
+    int descriptor_;
+    int fixed_file_;
+
+    // The per-thread ring on which the object's operations are submitted, or
+    // 0 if they use the shared ring.
+    shard_state* shard_;
+
     ASIO_DECL io_object(bool locking);
   };
 
+  // An operation that is submitted once and then produces a completion queue
+  // entry for each result, until the kernel ends it or it is cancelled. The
+  // results are delivered in order by calling complete_multishot_op from the
+  // operation's completion handler.
+  class multishot_op : public operation
+  {
+  public:
+    // The operation key used for targeted cancellation.
+    void* cancellation_key_;
+
+    // Release any results that have not been delivered.
+    void discard_results()
+    {
+      while (next_result_ < results_.size())
+      {
+        const result_type& r = results_[next_result_++];
+        deliver_func_(this, r.res, r.flags, false);
+      }
+      results_.clear();
+      next_result_ = 0;
+    }
+
+  protected:
+    // Prepares a submission, using the multishot form if requested.
+    typedef void (*prepare_func_type)(multishot_op*, ::io_uring_sqe*, bool);
+
+    // Delivers a result and its completion flags to the handler, or releases
+    // it if the final argument is false. Returns true if the handler wants
+    // more results.
+    typedef bool (*deliver_func_type)(multishot_op*, int, unsigned, bool);
+
+    multishot_op(prepare_func_type prepare_func,
+        deliver_func_type deliver_func, func_type complete_func)
+      : operation(complete_func),
+        cancellation_key_(0),
+        prepare_func_(prepare_func),
+        deliver_func_(deliver_func),
+        io_object_(0),
+        next_live_(0),
+        prev_live_(0),
+        next_result_(0),
+        multishot_(true),
+        armed_(false),
+        scheduled_(false),
+        stopped_(false),
+        cancel_requested_(false),
+        restart_(false),
+        delivered_(false)
+    {
+    }
+
+  private:
+    friend class io_uring_service;
+
+    prepare_func_type prepare_func_;
+    deliver_func_type deliver_func_;
+
+    // The object the operation runs against, or 0 once it has been closed.
+    io_object* io_object_;
+
+    // Links in the service's list of live multishot operations.
+    multishot_op* next_live_;
+    multishot_op* prev_live_;
+
+    // A result received from the kernel.
+    struct result_type
+    {
+      int res;
+      unsigned flags;
+    };
+
+    // Results received from the kernel and not yet delivered.
+    std::vector<result_type> results_;
+    std::size_t next_result_;
+
+    // Whether the multishot form of the operation is to be submitted.
+    bool multishot_;
+
+    // Whether a submission is outstanding in the kernel.
+    bool armed_;
+
+    // Whether the operation is queued for, or is performing, delivery.
+    bool scheduled_;
+
+    // Whether the handler has asked for no more results, or an error has
+    // been delivered.
+    bool stopped_;
+
+    // Whether cancellation has been requested.
+    bool cancel_requested_;
+
+    // Whether the submission was cancelled in preparation for a fork, and is
+    // to be restarted.
+    bool restart_;
+
+    // Whether at least one result has been delivered.
+    bool delivered_;
+  };
+
+  // Helper operation to submit pending submission queue entries.
+  class submit_sqes_op : operation
+  {
+    friend class io_uring_service;
+
+    io_uring_service* service_;
+
+    // The shard whose entries are submitted, or 0 for the shared ring.
+    shard_state* shard_;
+
+    ASIO_DECL submit_sqes_op(io_uring_service* s, shard_state* shard);
+    ASIO_DECL static void do_complete(void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+  };
+
+  // A ring owned by one of the threads that call run(), used when the rings
+  // are sharded. The owning thread waits on the shard's ring when it is idle,
+  // and is woken by a write to the shard's eventfd, which the ring is always
+  // reading while the thread waits. At other times the shared ring polls the
+  // shard's ring descriptor, and the shard is queued as an operation that
+  // reaps its completions on the owning thread when the shared ring reports
+  // it.
+  class shard_state : operation
+  {
+    friend class io_uring_service;
+
+    io_uring_service* service_;
+    mutex mutex_;
+    ::io_uring ring_;
+    std::size_t index_;
+    int pending_sqes_;
+    bool pending_submit_sqes_op_;
+
+    // Whether the shared ring is polling the shard's ring, whether the shard
+    // is queued to reap its completions, and whether the owning thread is
+    // waiting on the shard's ring. Protected by the service's mutex.
+    bool armed_;
+    bool queued_;
+    bool waiting_;
+
+    // The eventfd used to interrupt a wait on the shard's ring, the value read
+    // from it, and whether the ring is reading it. The last is protected by
+    // the shard's mutex.
+    int wakeup_fd_;
+    uint64_t wakeup_value_;
+    bool wakeup_armed_;
+
+    atomic_count outstanding_work_;
+    submit_sqes_op submit_sqes_op_;
+
+    ASIO_DECL shard_state(io_uring_service* s, std::size_t index);
+    ASIO_DECL static void do_complete(void* owner, operation* base,
+        const asio::error_code& ec, std::size_t bytes_transferred);
+  };
+
   // Per I/O object data.
   typedef io_object* per_io_object_data;
 
@@ -104,8 +278,9 @@ public:
   // Initialise the task.
   ASIO_DECL void init_task();
 
-  // Register an I/O object with io_uring.
-  ASIO_DECL void register_io_object(io_object*& io_obj);
+  // Register an I/O object with io_uring. If a descriptor is given, it is
+  // also added to the registered file table when a slot is available.
+  ASIO_DECL void register_io_object(io_object*& io_obj, int descriptor);
 
   // Register an internal I/O object with io_uring.
   ASIO_DECL void register_internal_io_object(
@@ -117,6 +292,15 @@ public:
   // Unregister buffers from io_uring.
   ASIO_DECL void unregister_buffers();
 
+  // Register a ring of provided buffers with io_uring. Returns the ring, and
+  // sets group_id to the buffer group that identifies it in submissions.
+  ASIO_DECL ::io_uring_buf_ring* register_buffer_ring(
+      unsigned entries, int& group_id);
+
+  // Unregister a ring of provided buffers from io_uring.
+  ASIO_DECL void unregister_buffer_ring(::io_uring_buf_ring* ring,
+      unsigned entries, int group_id);
+
   // Post an operation for immediate completion.
   void post_immediate_completion(operation* op, bool is_continuation);
 
@@ -125,6 +309,16 @@ public:
   ASIO_DECL void start_op(int op_type, per_io_object_data& io_obj,
       io_uring_operation* op, bool is_continuation);
 
+  // Start a multishot operation. Only one multishot operation may run against
+  // an I/O object at a time.
+  ASIO_DECL void start_multishot_op(per_io_object_data& io_obj,
+      multishot_op* op, bool is_continuation);
+
+  // Deliver the results received by a multishot operation, and re-submit it
+  // if it is to continue. Called from the operation's completion handler.
+  // Returns true when the operation has finished and may be destroyed.
+  ASIO_DECL bool complete_multishot_op(multishot_op* op);
+
   // Cancel all operations associated with the given I/O object. The handlers
   // associated with the I/O object will be invoked with the operation_aborted
   // error.
@@ -186,16 +380,24 @@ public:
   // Interrupt the io_uring wait.
   ASIO_DECL void interrupt();
 
-private:
-  // The hint to pass to io_uring_queue_init to size its data structures.
-  enum { ring_size = 16384 };
+  // Wait on the ring of the shard owned by the thread with the given index,
+  // until it has completions or the wait is interrupted. Returns false,
+  // without waiting, if the rings are not sharded or the thread has no shard.
+  ASIO_DECL bool run_thread(std::size_t index, op_queue<operation>& ops);
 
+  // Interrupt a wait on the ring of the shard owned by a thread.
+  ASIO_DECL void interrupt_thread(std::size_t index);
+
+private:
   // The number of operations to submit in a batch.
   enum { submit_batch_size = 128 };
 
   // The number of operations to complete in a batch.
   enum { complete_batch_size = 128 };
 
+  // The largest number of slots to use in the registered file table.
+  enum { fixed_file_table_size = 16384 };
+
   // The type used for processing eventfd readiness notifications.
   class event_fd_read_op;
 
@@ -205,6 +407,38 @@ private:
   // Register the eventfd descriptor for readiness notifications.
   ASIO_DECL void register_with_reactor();
 
+  // Register an empty file table with the ring. Registered files are not
+  // used if this fails.
+  ASIO_DECL void init_fixed_files();
+
+  // Add an I/O object's descriptor to the registered file table.
+  ASIO_DECL void add_fixed_file(io_object* io_obj);
+
+  // Remove an I/O object's descriptor from the registered file table. Any
+  // pending submissions that refer to its slot are submitted first, so that
+  // the slot may be reused.
+  ASIO_DECL void remove_fixed_file(io_object* io_obj);
+
+  // Take an I/O object's slot in the registered file table, after submitting
+  // any pending entries that refer to it. Returns the slot, or -1 if none.
+  ASIO_DECL int detach_fixed_file(io_object* io_obj);
+
+  // Clear a slot taken by detach_fixed_file and make it available for reuse.
+  // Must not be called with the mutex held.
+  ASIO_DECL void release_fixed_file(int slot);
+
+  // Make a submission queue entry refer to the I/O object's slot in the
+  // registered file table, rather than to its descriptor. The mutex must be
+  // held.
+  static void use_fixed_file(io_object* io_obj, ::io_uring_sqe* sqe)
+  {
+    if (io_obj->fixed_file_ >= 0 && sqe->fd == io_obj->descriptor_)
+    {
+      sqe->fd = io_obj->fixed_file_;
+      sqe->flags |= IOSQE_FIXED_FILE;
+    }
+  }
+
   // Allocate a new I/O object.
   ASIO_DECL io_object* allocate_io_object();
 
@@ -216,6 +450,71 @@ private:
   ASIO_DECL void do_cancel_ops(
       per_io_object_data& io_obj, op_queue<operation>& ops);
 
+  // Get the user data used to identify a shard's readiness notifications.
+  static void* shard_user_data(shard_state* shard)
+  {
+    return reinterpret_cast<char*>(shard) + 2;
+  }
+
+  // Get the shard identified by a completion's user data, or 0 if the
+  // completion does not belong to a shard.
+  static shard_state* shard_from_user_data(void* ptr)
+  {
+    uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+    return (p & 3) == 2 ? reinterpret_cast<shard_state*>(p - 2) : 0;
+  }
+
+  // Get the user data used to identify a multishot operation's completions.
+  static void* multishot_user_data(multishot_op* op)
+  {
+    return reinterpret_cast<char*>(op) + 1;
+  }
+
+  // Get the multishot operation identified by a completion's user data, or 0
+  // if the completion does not belong to a multishot operation.
+  static multishot_op* multishot_from_user_data(void* ptr)
+  {
+    uintptr_t p = reinterpret_cast<uintptr_t>(ptr);
+    return (p & 3) == 1 ? reinterpret_cast<multishot_op*>(p - 1) : 0;
+  }
+
+  // Determine whether a completion queue entry will be followed by others for
+  // the same submission.
+  static bool cqe_has_more(const ::io_uring_cqe* cqe)
+  {
+#if defined(IORING_CQE_F_MORE)
+    return (cqe->flags & IORING_CQE_F_MORE) != 0;
+#else // defined(IORING_CQE_F_MORE)
+    (void)cqe;
+    return false;
+#endif // defined(IORING_CQE_F_MORE)
+  }
+
+  // Add a result that was not produced by the kernel to a multishot operation.
+  static void push_multishot_result(multishot_op* op, int result)
+  {
+    multishot_op::result_type r = { result, 0 };
+    op->results_.push_back(r);
+  }
+
+  // Record the result of a multishot operation's completion queue entry. The
+  // operation is added to ops if it is not already scheduled. Returns true if
+  // a unit of outstanding work must be released once the mutex is unlocked.
+  ASIO_DECL bool record_multishot_result(multishot_op* op,
+      const ::io_uring_cqe* cqe, op_queue<operation>& ops);
+
+  // Submit a multishot operation. Returns false if no submission queue entry
+  // is available. On success the lock may have been released.
+  ASIO_DECL bool submit_multishot_op(
+      multishot_op* op, mutex::scoped_lock& lock);
+
+  // Stop a multishot operation, so that its remaining results are released
+  // rather than delivered. The mutex must be held.
+  ASIO_DECL void stop_multishot_op(multishot_op* op);
+
+  // Request cancellation of a multishot operation. The mutex must be held.
+  ASIO_DECL void cancel_multishot_op(multishot_op* op);
+
   // Helper function to add a new timer queue.
   ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -234,23 +533,62 @@ private:
   // Submit pending submission queue entries.
   ASIO_DECL void submit_sqes();
 
-  // Post an operation to submit the pending submission queue entries.
+  // Post an operation to submit the pending submission queue entries, or
+  // submit them now if the submission queue is polled.
   ASIO_DECL void post_submit_sqes_op(mutex::scoped_lock& lock);
 
-  // Push an operation to submit the pending submission queue entries.
+  // Push an operation to submit the pending submission queue entries, or
+  // submit them now if the submission queue is polled.
   ASIO_DECL void push_submit_sqes_op(op_queue<operation>& ops);
 
-  // Helper operation to submit pending submission queue entries.
-  class submit_sqes_op : operation
+  // Get the mutex that protects the ring used for an I/O object's operations.
+  mutex& ring_mutex(io_object* io_obj)
   {
-    friend class io_uring_service;
+    return io_obj->shard_ ? io_obj->shard_->mutex_ : mutex_;
+  }
 
-    io_uring_service* service_;
+  // Get a new submission queue entry from the ring used for an I/O object's
+  // operations. The ring's mutex must be held.
+  ASIO_DECL ::io_uring_sqe* get_sqe(io_object* io_obj);
 
-    ASIO_DECL submit_sqes_op(io_uring_service* s);
-    ASIO_DECL static void do_complete(void* owner, operation* base,
-        const asio::error_code& ec, std::size_t bytes_transferred);
-  };
+  // Submit the pending entries of the ring used for an I/O object's
+  // operations. The ring's mutex must be held.
+  ASIO_DECL void submit_sqes(io_object* io_obj);
+
+  // Arrange for the pending entries of the ring used for an I/O object's
+  // operations to be submitted. The lock on the ring's mutex may be released.
+  ASIO_DECL void post_submit_sqes_op(
+      io_object* io_obj, mutex::scoped_lock& lock);
+
+  // Choose the shard for a newly registered I/O object, creating its ring if
+  // required. Returns 0 if the rings are not sharded.
+  ASIO_DECL shard_state* assign_shard();
+
+  // Create a shard's ring, and the eventfd used to interrupt waits on it.
+  ASIO_DECL void init_shard_ring(shard_state& shard);
+
+  // Ask the shared ring to report when a shard has completions. The mutex
+  // must be held, and the lock may be released.
+  ASIO_DECL void arm_shard(shard_state& shard, mutex::scoped_lock& lock);
+
+  // Reap a shard's completions and post them to the thread that owns it.
+  ASIO_DECL void reap_shard(shard_state& shard);
+
+  // Reap a batch of a shard's completions, first waiting for one to arrive if
+  // block is true. The shard's eventfd must be being read if blocking.
+  ASIO_DECL void wait_shard(shard_state& shard,
+      bool block, op_queue<operation>& ops);
+
+  // Complete the read of a shard's eventfd, ending any wait on its ring.
+  ASIO_DECL void wake_shard(shard_state& shard);
+
+  // Get a new submission queue entry from a shard, flushing its queue if
+  // necessary. The shard's mutex must be held.
+  ASIO_DECL ::io_uring_sqe* get_shard_sqe(shard_state& shard);
+
+  // Submit a shard's pending submission queue entries. The shard's mutex must
+  // be held.
+  ASIO_DECL void submit_shard_sqes(shard_state& shard);
 
   // The scheduler implementation used to post completions.
   scheduler& scheduler_;
@@ -261,6 +599,9 @@ private:
   // The ring.
   ::io_uring ring_;
 
+  // The number of entries in each ring.
+  unsigned ring_size_;
+
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
@@ -276,6 +617,10 @@ private:
   // Whether the service has been shut down.
   bool shutdown_;
 
+  // Whether a kernel thread polls the submission queue, so that submitting
+  // entries does not require a system call.
+  bool sqpoll_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
@@ -293,6 +638,40 @@ private:
   struct perform_io_cleanup_on_block_exit;
   friend struct perform_io_cleanup_on_block_exit;
 
+  // Helper class to stop a multishot operation whose handler exits via an
+  // exception.
+  struct multishot_delivery_cleanup_on_block_exit;
+  friend struct multishot_delivery_cleanup_on_block_exit;
+
+  // The multishot operations that have been started and not yet finished.
+  multishot_op* multishot_ops_;
+
+  // The buffer group to be used for the next ring of provided buffers.
+  int next_buffer_group_;
+
+  // The number of slots in the registered file table, or 0 if the table is
+  // not in use.
+  int fixed_file_count_;
+
+  // The number of slots in the registered file table that have been used.
+  int next_fixed_file_;
+
+  // The slots in the registered file table that have been released.
+  std::vector<int> free_fixed_files_;
+
+  // The buffers registered with the shared ring, which are also registered
+  // with each shard.
+  std::vector< ::iovec> registered_buffers_;
+
+  // Whether I/O objects are divided among per-thread rings.
+  const bool sharded_;
+
+  // The number of I/O objects that have been assigned to shards.
+  std::size_t next_shard_;
+
+  // The per-thread rings, created as they are first needed.
+  shard_state* shards_[ASIO_SHARDED_REACTOR_MAX_SHARDS];
+
   // The reactor used to register for eventfd readiness.
   reactor& reactor_;
 
@@ -0,0 +1,192 @@
+//
+// detail/io_uring_socket_accept_loop_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_LOOP_OP_HPP
+#define ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_LOOP_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+
+#include "asio/error.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/socket_holder.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// An accept operation that is submitted once, using the multishot form where
+// the kernel supports it, and that passes every accepted connection to the
+// handler. The handler returns false to stop accepting.
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class io_uring_socket_accept_loop_op : public io_uring_service::multishot_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_socket_accept_loop_op);
+
+  io_uring_socket_accept_loop_op(io_uring_service& s,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      const Protocol& protocol, Handler& handler, const IoExecutor& io_ex)
+    : io_uring_service::multishot_op(
+        &io_uring_socket_accept_loop_op::do_prepare,
+        &io_uring_socket_accept_loop_op::do_deliver,
+        &io_uring_socket_accept_loop_op::do_complete),
+      service_(s),
+      peer_io_ex_(peer_io_ex),
+      socket_(socket),
+      protocol_(protocol),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_prepare(io_uring_service::multishot_op* base,
+      ::io_uring_sqe* sqe, bool multishot)
+  {
+    io_uring_socket_accept_loop_op* o(
+        static_cast<io_uring_socket_accept_loop_op*>(base));
+
+#if defined(IORING_ACCEPT_MULTISHOT)
+    if (multishot)
+    {
+      ::io_uring_prep_multishot_accept(sqe, o->socket_, 0, 0, 0);
+      return;
+    }
+#else // defined(IORING_ACCEPT_MULTISHOT)
+    (void)multishot;
+#endif // defined(IORING_ACCEPT_MULTISHOT)
+
+    ::io_uring_prep_accept(sqe, o->socket_, 0, 0, 0);
+  }
+
+  static bool do_deliver(io_uring_service::multishot_op* base,
+      int result, unsigned /*flags*/, bool deliver)
+  {
+    io_uring_socket_accept_loop_op* o(
+        static_cast<io_uring_socket_accept_loop_op*>(base));
+
+    // The holder closes the new connection if it is not passed on.
+    socket_holder new_socket(result >= 0 ? result : invalid_socket);
+    if (!deliver)
+      return false;
+
+    asio::error_code ec;
+    peer_socket_type peer(o->peer_io_ex_);
+    if (result >= 0)
+    {
+      peer.assign(o->protocol_, new_socket.get(), ec);
+      if (!ec)
+        new_socket.release();
+    }
+    else if (result == -ECANCELED)
+      ec = asio::error::operation_aborted;
+    else
+      ec = asio::error_code(-result, asio::error::get_system_category());
+
+    return o->handler_(static_cast<const asio::error_code&>(ec),
+        ASIO_MOVE_CAST(peer_socket_type)(peer));
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    io_uring_socket_accept_loop_op* o(
+        static_cast<io_uring_socket_accept_loop_op*>(base));
+
+    if (!owner)
+    {
+      o->discard_results();
+      o->destroy();
+      return;
+    }
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // The results are delivered through a small function object so that the
+    // operation is re-submitted, or freed, on whichever executor the handler
+    // is associated with. All of the results collected by one completion are
+    // tracked as a single invocation.
+    fenced_block b(fenced_block::half);
+    ASIO_HANDLER_INVOCATION_BEGIN(());
+    invoker i(o);
+    o->work_.complete(i, o->handler_);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  class invoker
+  {
+  public:
+    explicit invoker(io_uring_socket_accept_loop_op* o)
+      : op_(o)
+    {
+    }
+
+    void operator()()
+    {
+      if (op_->service_.complete_multishot_op(op_))
+        op_->destroy();
+    }
+
+  private:
+    io_uring_socket_accept_loop_op* op_;
+  };
+
+  // Free the operation's memory using the handler's allocator.
+  void destroy()
+  {
+    ptr p = { asio::detail::addressof(handler_), this, this };
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(work_));
+
+    // A sub-object of the handler may be the true owner of the memory
+    // associated with the handler, so a local copy is required to ensure that
+    // any owning sub-object remains valid until after we have deallocated the
+    // memory here.
+    Handler handler(ASIO_MOVE_CAST(Handler)(handler_));
+    p.h = asio::detail::addressof(handler);
+    p.reset();
+  }
+
+  io_uring_service& service_;
+  PeerIoExecutor peer_io_ex_;
+  socket_type socket_;
+  Protocol protocol_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_IO_URING_SOCKET_ACCEPT_LOOP_OP_HPP
@@ -0,0 +1,194 @@
+//
+// detail/io_uring_socket_recv_loop_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_IO_URING_SOCKET_RECV_LOOP_OP_HPP
+#define ASIO_DETAIL_IO_URING_SOCKET_RECV_LOOP_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+
+#include "asio/error.hpp"
+#include "asio/provided_buffer_ring.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/io_uring_buffer_ring.hpp"
+#include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/socket_ops.hpp"
+#include "asio/detail/socket_types.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A receive operation that is submitted once, using the multishot form where
+// the kernel supports it, and that selects a buffer from a ring of provided
+// buffers only when data arrives. Each read is passed to the handler as a
+// borrowed buffer. The handler returns false to stop receiving.
+template <typename Handler, typename IoExecutor>
+class io_uring_socket_recv_loop_op : public io_uring_service::multishot_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_loop_op);
+
+  io_uring_socket_recv_loop_op(io_uring_service& s, socket_type socket,
+      socket_ops::state_type state, io_uring_buffer_ring& ring,
+      Handler& handler, const IoExecutor& io_ex)
+    : io_uring_service::multishot_op(
+        &io_uring_socket_recv_loop_op::do_prepare,
+        &io_uring_socket_recv_loop_op::do_deliver,
+        &io_uring_socket_recv_loop_op::do_complete),
+      service_(s),
+      socket_(socket),
+      state_(state),
+      ring_(ring),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_prepare(io_uring_service::multishot_op* base,
+      ::io_uring_sqe* sqe, bool multishot)
+  {
+    io_uring_socket_recv_loop_op* o(
+        static_cast<io_uring_socket_recv_loop_op*>(base));
+
+#if defined(IORING_RECV_MULTISHOT)
+    if (multishot)
+      ::io_uring_prep_recv_multishot(sqe, o->socket_, 0, 0, 0);
+    else
+      ::io_uring_prep_recv(sqe, o->socket_, 0, 0, 0);
+#else // defined(IORING_RECV_MULTISHOT)
+    (void)multishot;
+    ::io_uring_prep_recv(sqe, o->socket_, 0, 0, 0);
+#endif // defined(IORING_RECV_MULTISHOT)
+
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = static_cast<unsigned short>(o->ring_.group_id());
+  }
+
+  static bool do_deliver(io_uring_service::multishot_op* base,
+      int result, unsigned flags, bool deliver)
+  {
+    io_uring_socket_recv_loop_op* o(
+        static_cast<io_uring_socket_recv_loop_op*>(base));
+
+    // The borrowed buffer goes back to the ring if it is not passed on.
+    provided_buffer buffer;
+    if ((flags & IORING_CQE_F_BUFFER) != 0)
+    {
+      buffer = provided_buffer_access::make_buffer(o->ring_,
+          static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT),
+          result > 0 ? static_cast<std::size_t>(result) : 0);
+    }
+    if (!deliver)
+      return false;
+
+    asio::error_code ec;
+    if (result == 0 && (o->state_ & socket_ops::stream_oriented) != 0)
+      ec = asio::error::eof;
+    else if (result == -ECANCELED)
+      ec = asio::error::operation_aborted;
+    else if (result < 0)
+      ec = asio::error_code(-result, asio::error::get_system_category());
+
+    bool more = o->handler_(static_cast<const asio::error_code&>(ec),
+        ASIO_MOVE_CAST(provided_buffer)(buffer));
+    return more && !ec;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    io_uring_socket_recv_loop_op* o(
+        static_cast<io_uring_socket_recv_loop_op*>(base));
+
+    if (!owner)
+    {
+      o->discard_results();
+      o->destroy();
+      return;
+    }
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // The results are delivered through a small function object so that the
+    // operation is re-submitted, or freed, on whichever executor the handler
+    // is associated with. All of the results collected by one completion are
+    // tracked as a single invocation.
+    fenced_block b(fenced_block::half);
+    ASIO_HANDLER_INVOCATION_BEGIN(());
+    invoker i(o);
+    o->work_.complete(i, o->handler_);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  class invoker
+  {
+  public:
+    explicit invoker(io_uring_socket_recv_loop_op* o)
+      : op_(o)
+    {
+    }
+
+    void operator()()
+    {
+      if (op_->service_.complete_multishot_op(op_))
+        op_->destroy();
+    }
+
+  private:
+    io_uring_socket_recv_loop_op* op_;
+  };
+
+  // Free the operation's memory using the handler's allocator.
+  void destroy()
+  {
+    ptr p = { asio::detail::addressof(handler_), this, this };
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(work_));
+
+    // A sub-object of the handler may be the true owner of the memory
+    // associated with the handler, so a local copy is required to ensure that
+    // any owning sub-object remains valid until after we have deallocated the
+    // memory here.
+    Handler handler(ASIO_MOVE_CAST(Handler)(handler_));
+    p.h = asio::detail::addressof(handler);
+    p.reset();
+  }
+
+  io_uring_service& service_;
+  socket_type socket_;
+  socket_ops::state_type state_;
+  io_uring_buffer_ring& ring_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+
+#endif // ASIO_DETAIL_IO_URING_SOCKET_RECV_LOOP_OP_HPP
@@ -28,6 +28,7 @@
 #include "asio/detail/noncopyable.hpp"
 #include "asio/detail/io_uring_null_buffers_op.hpp"
 #include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/io_uring_socket_accept_loop_op.hpp"
 #include "asio/detail/io_uring_socket_accept_op.hpp"
 #include "asio/detail/io_uring_socket_connect_op.hpp"
 #include "asio/detail/io_uring_socket_recvfrom_op.hpp"
@@ -557,6 +558,43 @@ public:
     start_accept_op(impl, p.p, is_continuation, false);
     p.v = p.p = 0;
   }
+
+  // Start a persistent accept. Each new connection is passed to the handler,
+  // until the handler returns false or is called with an error.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_accept_loop(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_accept_loop_op<Protocol,
+        PeerIoExecutor, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(io_uring_service_, peer_io_ex,
+        impl.socket_, impl.protocol_, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_accept_loop"));
+
+    io_uring_service_.start_multishot_op(
+        impl.io_object_data_, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
 #endif // defined(ASIO_HAS_MOVE)
 
   // Connect the socket to the specified endpoint.
@@ -27,8 +27,10 @@
 #include "asio/socket_base.hpp"
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/io_uring_buffer_ring.hpp"
 #include "asio/detail/io_uring_null_buffers_op.hpp"
 #include "asio/detail/io_uring_service.hpp"
+#include "asio/detail/io_uring_socket_recv_loop_op.hpp"
 #include "asio/detail/io_uring_socket_recv_op.hpp"
 #include "asio/detail/io_uring_socket_recvmsg_op.hpp"
 #include "asio/detail/io_uring_socket_send_op.hpp"
@@ -426,6 +428,44 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(ASIO_HAS_MOVE)
+  // Start a persistent receive into buffers selected from a ring. Each read is
+  // passed to the handler, until the handler returns false or is called with
+  // an error.
+  template <typename Handler, typename IoExecutor>
+  void async_receive_provided(base_implementation_type& impl,
+      io_uring_buffer_ring& ring, Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_loop_op<Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(io_uring_service_, impl.socket_,
+        impl.state_, ring, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_provided"));
+
+    io_uring_service_.start_multishot_op(
+        impl.io_object_data_, p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+#endif // defined(ASIO_HAS_MOVE)
+
   // Wait until data can be received without blocking.
   template <typename Handler, typename IoExecutor>
   void async_receive(base_implementation_type& impl,
@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include "asio/detail/config.hpp"
+#include <cstddef>
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -68,6 +69,13 @@ public:
     return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them.
+  template <typename Lock>
+  std::size_t maybe_unlock_and_signal_some(Lock&, std::size_t)
+  {
+    return 0;
+  }
+
   // Reset the event.
   template <typename Lock>
   void clear(Lock&)
@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <new>
 #include "asio/detail/noncopyable.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -46,6 +47,24 @@ public:
     delete o;
   }
 
+  template <typename Object>
+  static Object* construct(void* p)
+  {
+    return new (p) Object;
+  }
+
+  template <typename Object, typename Arg>
+  static Object* construct(void* p, Arg arg)
+  {
+    return new (p) Object(arg);
+  }
+
+  template <typename Object>
+  static void destruct(Object* o)
+  {
+    o->~Object();
+  }
+
   template <typename Object>
   static Object*& next(Object* o)
   {
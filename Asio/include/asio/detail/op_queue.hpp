@@ -115,6 +115,38 @@ public:
     }
   }
 
+  // Push an operation on to the front of the queue.
+  void push_front(Operation* h)
+  {
+    op_queue_access::next(h, front_);
+    front_ = h;
+    if (back_ == 0)
+      back_ = h;
+  }
+
+  // Remove an operation from anywhere in the queue. Returns false if the
+  // operation was not found.
+  bool erase(Operation* h)
+  {
+    Operation* prev = 0;
+    for (Operation* o = front_; o; prev = o, o = op_queue_access::next(o))
+    {
+      if (o == h)
+      {
+        Operation* next = op_queue_access::next(o);
+        if (prev)
+          op_queue_access::next(prev, next);
+        else
+          front_ = next;
+        if (back_ == o)
+          back_ = prev;
+        op_queue_access::next(o, static_cast<Operation*>(0));
+        return true;
+      }
+    }
+    return false;
+  }
+
   // Push all operations from another queue on to the back of the queue. The
   // source queue may contain operations of a derived type.
   template <typename OtherOperation>
@@ -132,6 +164,22 @@ public:
     }
   }
 
+  // Push all operations from another queue on to the front of the queue. The
+  // source queue may contain operations of a derived type.
+  template <typename OtherOperation>
+  void push_front(op_queue<OtherOperation>& q)
+  {
+    if (Operation* other_front = op_queue_access::front(q))
+    {
+      op_queue_access::next(op_queue_access::back(q), front_);
+      if (back_ == 0)
+        back_ = op_queue_access::back(q);
+      front_ = other_front;
+      op_queue_access::front(q) = 0;
+      op_queue_access::back(q) = 0;
+    }
+  }
+
   // Whether the queue is empty.
   bool empty() const
   {
@@ -0,0 +1,83 @@
+//
+// detail/operation_priority.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_OPERATION_PRIORITY_HPP
+#define ASIO_DETAIL_OPERATION_PRIORITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/associated_executor.hpp"
+#include "asio/detail/scheduler_operation.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/priority.hpp"
+#include "asio/query.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Map the priority property of an executor on to a scheduler queue.
+template <typename Executor>
+inline scheduler_operation::priority_type executor_priority(const Executor& ex,
+    typename enable_if<
+      can_query<const Executor&, execution::priority_t>::value
+    >::type* = 0)
+{
+  execution::priority_t p = asio::query(ex, execution::priority);
+  if (p == execution::priority.high)
+    return scheduler_operation::high_priority;
+  if (p == execution::priority.low)
+    return scheduler_operation::low_priority;
+  return scheduler_operation::normal_priority;
+}
+
+template <typename Executor>
+inline scheduler_operation::priority_type executor_priority(const Executor&,
+    typename enable_if<
+      !can_query<const Executor&, execution::priority_t>::value
+    >::type* = 0)
+{
+  return scheduler_operation::normal_priority;
+}
+
+// Set the priority with which the scheduler runs an operation from the
+// priority of an executor. Priorities are not supported by the I/O completion
+// port implementation.
+template <typename Operation, typename Executor>
+inline void set_operation_priority(Operation& op, const Executor& ex)
+{
+#if defined(ASIO_HAS_IOCP)
+  (void)op;
+  (void)ex;
+#else // defined(ASIO_HAS_IOCP)
+  op.set_priority(executor_priority(ex));
+#endif // defined(ASIO_HAS_IOCP)
+}
+
+// Give an asynchronous operation the priority of the executor that will be
+// used to run its completion handler.
+template <typename Operation, typename Handler, typename IoExecutor>
+inline void inherit_operation_priority(Operation& op,
+    const Handler& handler, const IoExecutor& io_ex)
+{
+  set_operation_priority(op,
+      asio::get_associated_executor(handler, io_ex));
+}
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_OPERATION_PRIORITY_HPP
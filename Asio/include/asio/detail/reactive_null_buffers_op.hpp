@@ -22,6 +22,7 @@
 #include "asio/detail/handler_invoke_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/operation_priority.hpp"
 #include "asio/detail/reactor_op.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -42,6 +43,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(handler)),
       work_(handler_, io_ex)
   {
+    inherit_operation_priority(*this, handler_, io_ex);
   }
 
   static status do_perform(reactor_op*)
@@ -17,15 +17,21 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/detail/bind_handler.hpp"
+#include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_invoke_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/operation_priority.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/socket_holder.hpp"
 #include "asio/detail/socket_ops.hpp"
 
+#if defined(ASIO_HAS_MOVE)
+# include <vector>
+#endif // defined(ASIO_HAS_MOVE)
+
 #include "asio/detail/push_options.hpp"
 
 namespace asio {
@@ -107,6 +113,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(handler)),
       work_(handler_, io_ex)
   {
+    inherit_operation_priority(*this, handler_, io_ex);
   }
 
   static void do_complete(void* owner, operation* base,
@@ -179,6 +186,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(handler)),
       work_(handler_, io_ex)
   {
+    inherit_operation_priority(*this, handler_, io_ex);
   }
 
   static void do_complete(void* owner, operation* base,
@@ -232,6 +240,150 @@ private:
   handler_work<Handler, IoExecutor> work_;
 };
 
+template <typename Protocol, typename PeerIoExecutor,
+    typename Handler, typename IoExecutor>
+class reactive_socket_accept_many_op : public reactor_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_accept_many_op);
+
+  reactive_socket_accept_many_op(const asio::error_code& success_ec,
+      const PeerIoExecutor& peer_io_ex, socket_type socket,
+      socket_ops::state_type state, const Protocol& protocol,
+      std::size_t max_connections, Handler& handler, const IoExecutor& io_ex)
+    : reactor_op(success_ec, &reactive_socket_accept_many_op::do_perform,
+        &reactive_socket_accept_many_op::do_complete),
+      socket_(socket),
+      state_(state),
+      protocol_(protocol),
+      peer_io_ex_(peer_io_ex),
+      max_connections_(max_connections < ASIO_ACCEPT_MANY_MAX_CONNECTIONS
+          ? max_connections : ASIO_ACCEPT_MANY_MAX_CONNECTIONS),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+    // Reserve space for the whole batch up front, so that accepting inside the
+    // reactor never needs to allocate.
+    new_sockets_.reserve(max_connections_);
+    inherit_operation_priority(*this, handler_, io_ex);
+  }
+
+  ~reactive_socket_accept_many_op()
+  {
+    // Close any connections that were not handed over to a peer socket.
+    for (std::size_t i = 0; i < new_sockets_.size(); ++i)
+    {
+      socket_holder new_socket(new_sockets_[i]);
+    }
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_accept_many_op* o(
+        static_cast<reactive_socket_accept_many_op*>(base));
+
+    // Accept until the listen queue is drained or the batch is full. An error
+    // is only reported if no connection has been accepted, as the connections
+    // already accepted must still be delivered.
+    status result = done;
+    while (o->new_sockets_.size() < o->max_connections_)
+    {
+      asio::error_code ec;
+      socket_type new_socket = invalid_socket;
+      if (!socket_ops::non_blocking_accept(o->socket_,
+            o->state_, 0, 0, ec, new_socket))
+      {
+        result = o->new_sockets_.empty() ? not_done : done_and_exhausted;
+        break;
+      }
+
+      if (new_socket == invalid_socket)
+      {
+        if (o->new_sockets_.empty())
+          o->ec_ = ec;
+        break;
+      }
+
+      o->new_sockets_.push_back(new_socket);
+    }
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_accept", o->ec_));
+
+    return result;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    reactive_socket_accept_many_op* o(
+        static_cast<reactive_socket_accept_many_op*>(base));
+    ptr p = { asio::detail::addressof(o->handler_), o, o };
+
+    // On success, assign the new connections to peer socket objects.
+    std::vector<peer_socket_type> peers;
+    if (owner)
+      o->do_assign(peers);
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(
+          o->work_));
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::move_binder2<Handler,
+      asio::error_code, std::vector<peer_socket_type> >
+        handler(0, ASIO_MOVE_CAST(Handler)(o->handler_), o->ec_,
+          ASIO_MOVE_CAST(std::vector<peer_socket_type>)(peers));
+    p.h = asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, "..."));
+      w.complete(handler, handler.handler_);
+      ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  void do_assign(std::vector<peer_socket_type>& peers)
+  {
+    peers.reserve(new_sockets_.size());
+    for (std::size_t i = 0; i < new_sockets_.size(); ++i)
+    {
+      peer_socket_type peer(peer_io_ex_);
+      peer.assign(protocol_, new_sockets_[i], ec_);
+      if (ec_)
+        break;
+      new_sockets_[i] = invalid_socket;
+      peers.push_back(ASIO_MOVE_CAST(peer_socket_type)(peer));
+    }
+  }
+
+  socket_type socket_;
+  socket_ops::state_type state_;
+  Protocol protocol_;
+  PeerIoExecutor peer_io_ex_;
+  std::size_t max_connections_;
+  std::vector<socket_type> new_sockets_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
 #endif // defined(ASIO_HAS_MOVE)
 
 } // namespace detail
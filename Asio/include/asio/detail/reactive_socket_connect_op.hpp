@@ -22,6 +22,7 @@
 #include "asio/detail/handler_invoke_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/operation_priority.hpp"
 #include "asio/detail/reactor_op.hpp"
 #include "asio/detail/socket_ops.hpp"
 
@@ -71,6 +72,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(handler)),
       work_(handler_, io_ex)
   {
+    inherit_operation_priority(*this, handler_, io_ex);
   }
 
   static void do_complete(void* owner, operation* base,
@@ -0,0 +1,198 @@
+//
+// detail/reactive_socket_recv_loop_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTIVE_SOCKET_RECV_LOOP_OP_HPP
+#define ASIO_DETAIL_REACTIVE_SOCKET_RECV_LOOP_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/buffer.hpp"
+#include "asio/detail/fenced_block.hpp"
+#include "asio/detail/handler_alloc_helpers.hpp"
+#include "asio/detail/handler_invoke_helpers.hpp"
+#include "asio/detail/handler_work.hpp"
+#include "asio/detail/memory.hpp"
+#include "asio/detail/operation_priority.hpp"
+#include "asio/detail/reactor.hpp"
+#include "asio/detail/reactor_op.hpp"
+#include "asio/detail/socket_ops.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// A receive operation that is allocated once and then re-armed in place after
+// each completion, for as long as the handler asks for more data. The handler
+// is called with the result of every read and returns false to stop.
+template <typename BufferProvider, typename Handler, typename IoExecutor>
+class reactive_socket_recv_loop_op : public reactor_op
+{
+public:
+  ASIO_DEFINE_HANDLER_PTR(reactive_socket_recv_loop_op);
+
+  reactive_socket_recv_loop_op(const asio::error_code& success_ec,
+      reactor& r, socket_type socket,
+      reactor::per_descriptor_data& reactor_data,
+      socket_ops::state_type state, BufferProvider& provider,
+      Handler& handler, const IoExecutor& io_ex)
+    : reactor_op(success_ec, &reactive_socket_recv_loop_op::do_perform,
+        &reactive_socket_recv_loop_op::do_complete),
+      success_ec_(success_ec),
+      reactor_(r),
+      socket_(socket),
+      reactor_data_(reactor_data),
+      state_(state),
+      provider_(ASIO_MOVE_CAST(BufferProvider)(provider)),
+      handler_(ASIO_MOVE_CAST(Handler)(handler)),
+      work_(handler_, io_ex)
+  {
+    inherit_operation_priority(*this, handler_, io_ex);
+  }
+
+  // Obtain the buffer for the next read and queue the operation with the
+  // reactor. The operation must not be touched after this call, as it may
+  // already be completing on another thread.
+  void start(bool is_continuation)
+  {
+    buffer_ = provider_();
+    this->ec_ = success_ec_;
+    this->bytes_transferred_ = 0;
+
+    // An empty buffer would complete a stream read at once, every time, so it
+    // ends the loop instead.
+    if ((state_ & socket_ops::stream_oriented) != 0 && buffer_.size() == 0)
+    {
+      this->ec_ = asio::error::no_buffer_space;
+      reactor_.post_immediate_completion(this, is_continuation);
+    }
+    else
+      reactor_.start_op(reactor::read_op, socket_,
+          reactor_data_, this, is_continuation, true);
+  }
+
+  static status do_perform(reactor_op* base)
+  {
+    reactive_socket_recv_loop_op* o(
+        static_cast<reactive_socket_recv_loop_op*>(base));
+
+    bool is_stream = (o->state_ & socket_ops::stream_oriented) != 0;
+    status result = socket_ops::non_blocking_recv1(o->socket_,
+        o->buffer_.data(), o->buffer_.size(), 0, is_stream,
+        o->ec_, o->bytes_transferred_) ? done : not_done;
+
+    if (result == done)
+      if (is_stream && o->bytes_transferred_ == 0)
+        result = done_and_exhausted;
+
+    ASIO_HANDLER_REACTOR_OPERATION((*o, "non_blocking_recv",
+          o->ec_, o->bytes_transferred_));
+
+    return result;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const asio::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    reactive_socket_recv_loop_op* o(
+        static_cast<reactive_socket_recv_loop_op*>(base));
+
+    if (!owner)
+    {
+      o->destroy();
+      return;
+    }
+
+    ASIO_HANDLER_COMPLETION((*o));
+
+    // The handler is invoked through a small function object so that the
+    // operation is re-armed, or freed, after the upcall has returned on
+    // whichever executor the handler is associated with.
+    fenced_block b(fenced_block::half);
+    ASIO_HANDLER_INVOCATION_BEGIN((o->ec_, o->bytes_transferred_));
+    invoker i(o);
+    o->work_.complete(i, o->handler_);
+    ASIO_HANDLER_INVOCATION_END;
+  }
+
+private:
+  class invoker
+  {
+  public:
+    explicit invoker(reactive_socket_recv_loop_op* o)
+      : op_(o)
+    {
+    }
+
+    void operator()()
+    {
+      // Frees the operation if the handler exits via an exception.
+      struct on_exit
+      {
+        reactive_socket_recv_loop_op* op_;
+        ~on_exit() { if (op_) op_->destroy(); }
+      } guard = { op_ };
+
+      asio::error_code ec(op_->ec_);
+      std::size_t bytes_transferred = op_->bytes_transferred_;
+
+      bool more = op_->handler_(
+          static_cast<const asio::error_code&>(ec), bytes_transferred);
+
+      if (more && !ec)
+      {
+        guard.op_ = 0;
+        op_->start(true);
+      }
+    }
+
+  private:
+    reactive_socket_recv_loop_op* op_;
+  };
+
+  // Free the operation's memory using the handler's allocator.
+  void destroy()
+  {
+    ptr p = { asio::detail::addressof(handler_), this, this };
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        ASIO_MOVE_CAST2(handler_work<Handler, IoExecutor>)(work_));
+
+    // A sub-object of the handler may be the true owner of the memory
+    // associated with the handler, so a local copy is required to ensure that
+    // any owning sub-object remains valid until after we have deallocated the
+    // memory here.
+    Handler handler(ASIO_MOVE_CAST(Handler)(handler_));
+    p.h = asio::detail::addressof(handler);
+    p.reset();
+  }
+
+  asio::error_code success_ec_;
+  reactor& reactor_;
+  socket_type socket_;
+  reactor::per_descriptor_data& reactor_data_;
+  socket_ops::state_type state_;
+  BufferProvider provider_;
+  asio::mutable_buffer buffer_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTIVE_SOCKET_RECV_LOOP_OP_HPP
@@ -160,6 +160,13 @@ public:
   asio::error_code set_option(implementation_type& impl,
       const Option& option, asio::error_code& ec)
   {
+    if (option.level(impl.protocol_) == custom_socket_option_level
+        && option.name(impl.protocol_) == io_quota_option)
+    {
+      return this->set_io_quota(impl, option.data(impl.protocol_),
+          option.size(impl.protocol_), ec);
+    }
+
     socket_ops::setsockopt(impl.socket_, impl.state_,
         option.level(impl.protocol_), option.name(impl.protocol_),
         option.data(impl.protocol_), option.size(impl.protocol_), ec);
@@ -172,9 +179,17 @@ public:
       Option& option, asio::error_code& ec) const
   {
     std::size_t size = option.size(impl.protocol_);
-    socket_ops::getsockopt(impl.socket_, impl.state_,
-        option.level(impl.protocol_), option.name(impl.protocol_),
-        option.data(impl.protocol_), &size, ec);
+    if (option.level(impl.protocol_) == custom_socket_option_level
+        && option.name(impl.protocol_) == io_quota_option)
+    {
+      this->get_io_quota(impl, option.data(impl.protocol_), &size, ec);
+    }
+    else
+    {
+      socket_ops::getsockopt(impl.socket_, impl.state_,
+          option.level(impl.protocol_), option.name(impl.protocol_),
+          option.data(impl.protocol_), &size, ec);
+    }
     if (!ec)
       option.resize(impl.protocol_, size);
     return ec;
@@ -550,6 +565,48 @@ public:
     start_accept_op(impl, p.p, is_continuation, false);
     p.v = p.p = 0;
   }
+
+  // Start an asynchronous accept of up to max_connections connections. All
+  // connections that are already pending are delivered to a single handler.
+  template <typename PeerIoExecutor, typename Handler, typename IoExecutor>
+  void async_accept_many(implementation_type& impl,
+      std::size_t max_connections, const PeerIoExecutor& peer_io_ex,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_accept_many_op<Protocol,
+        PeerIoExecutor, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, peer_io_ex, impl.socket_,
+        impl.state_, impl.protocol_, max_connections, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected() && max_connections != 0)
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_accept_many"));
+
+    if (max_connections == 0)
+    {
+      p.p->ec_ = asio::error::invalid_argument;
+      reactor_.post_immediate_completion(p.p, is_continuation);
+    }
+    else
+      start_accept_op(impl, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
 #endif // defined(ASIO_HAS_MOVE)
 
   // Connect the socket to the specified endpoint.
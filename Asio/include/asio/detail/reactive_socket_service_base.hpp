@@ -30,6 +30,7 @@
 #include "asio/detail/buffer_sequence_adapter.hpp"
 #include "asio/detail/memory.hpp"
 #include "asio/detail/reactive_null_buffers_op.hpp"
+#include "asio/detail/reactive_socket_recv_loop_op.hpp"
 #include "asio/detail/reactive_socket_recv_op.hpp"
 #include "asio/detail/reactive_socket_recvmsg_op.hpp"
 #include "asio/detail/reactive_socket_send_op.hpp"
@@ -426,6 +427,47 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start a persistent receive that is re-armed after each completion until
+  // the handler returns false or an error occurs. The buffer provider is
+  // called to obtain the buffer before each read.
+  template <typename BufferProvider, typename Handler, typename IoExecutor>
+  void async_receive_loop(base_implementation_type& impl,
+      BufferProvider& provider, Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      asio_handler_cont_helpers::is_continuation(handler);
+
+    typename associated_cancellation_slot<Handler>::type slot
+      = asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_socket_recv_loop_op<
+        BufferProvider, Handler, IoExecutor> op;
+    typename op::ptr p = { asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, reactor_, impl.socket_,
+        impl.reactor_data_, impl.state_, provider, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<reactor_op_cancellation>(
+            &reactor_, &impl.reactor_data_, impl.socket_, reactor::read_op);
+    }
+
+    ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_receive_loop"));
+
+    if ((impl.state_ & socket_ops::non_blocking)
+        || socket_ops::set_internal_non_blocking(
+          impl.socket_, impl.state_, true, p.p->ec_))
+      p.p->start(is_continuation);
+    else
+      reactor_.post_immediate_completion(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
   // Wait until data can be received without blocking.
   template <typename Handler, typename IoExecutor>
   void async_receive(base_implementation_type& impl,
@@ -599,6 +641,15 @@ protected:
       reactor_op* op, bool is_continuation,
       const socket_addr_type* addr, size_t addrlen);
 
+  // Set the limit on the operations performed each time the socket is ready.
+  ASIO_DECL asio::error_code set_io_quota(base_implementation_type& impl,
+      const void* optval, std::size_t optlen, asio::error_code& ec);
+
+  // Get the limit on the operations performed each time the socket is ready.
+  ASIO_DECL asio::error_code get_io_quota(
+      const base_implementation_type& impl, void* optval,
+      std::size_t* optlen, asio::error_code& ec) const;
+
   // Helper class used to implement per-operation cancellation
   class reactor_op_cancellation
   {
@@ -0,0 +1,59 @@
+//
+// detail/reactor_shard_scope.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_REACTOR_SHARD_SCOPE_HPP
+#define ASIO_DETAIL_REACTOR_SHARD_SCOPE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/call_stack.hpp"
+#include "asio/detail/noncopyable.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// While an object of this class exists, a sharded reactor assigns descriptors
+// registered by the current thread to the shard with the given index, rather
+// than sharing them out in turn. Reactors that are not sharded ignore it.
+class reactor_shard_scope
+  : private noncopyable
+{
+public:
+  // Push the shard index on to the current thread's stack.
+  explicit reactor_shard_scope(std::size_t index)
+    : index_(index),
+      context_(this, index_)
+  {
+  }
+
+  // Get the shard index requested by the current thread, or ~0 if none.
+  static std::size_t current()
+  {
+    std::size_t* index = call_stack<reactor_shard_scope, std::size_t>::top();
+    return index ? *index : ~static_cast<std::size_t>(0);
+  }
+
+private:
+  std::size_t index_;
+  call_stack<reactor_shard_scope, std::size_t>::context context_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_REACTOR_SHARD_SCOPE_HPP
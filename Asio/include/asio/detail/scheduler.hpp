@@ -17,11 +17,14 @@
 
 #include "asio/detail/config.hpp"
 
+#include <vector>
 #include "asio/error_code.hpp"
 #include "asio/execution_context.hpp"
 #include "asio/detail/atomic_count.hpp"
+#include "asio/detail/atomic_op_queue.hpp"
 #include "asio/detail/conditionally_enabled_event.hpp"
 #include "asio/detail/conditionally_enabled_mutex.hpp"
+#include "asio/detail/cstdint.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/scheduler_operation.hpp"
 #include "asio/detail/scheduler_task.hpp"
@@ -30,6 +33,24 @@
 
 #include "asio/detail/push_options.hpp"
 
+// The number of consecutive operations that the scheduler runs from a higher
+// priority queue while operations with a lower priority are waiting.
+#if !defined(ASIO_PRIORITY_QUOTA)
+# define ASIO_PRIORITY_QUOTA 16
+#endif // !defined(ASIO_PRIORITY_QUOTA)
+
+// The default limit on the number of handlers that the scheduler runs between
+// polls of the reactor task. Zero means no limit.
+#if !defined(ASIO_POLL_HANDLER_LIMIT)
+# define ASIO_POLL_HANDLER_LIMIT 0
+#endif // !defined(ASIO_POLL_HANDLER_LIMIT)
+
+// The default limit, in microseconds, on the time that the scheduler spends
+// running handlers between polls of the reactor task. Zero means no limit.
+#if !defined(ASIO_POLL_TIME_LIMIT_USEC)
+# define ASIO_POLL_TIME_LIMIT_USEC 0
+#endif // !defined(ASIO_POLL_TIME_LIMIT_USEC)
+
 namespace asio {
 namespace detail {
 
@@ -61,6 +82,10 @@ public:
   // Initialise the task, if required.
   ASIO_DECL void init_task();
 
+  // Set the task on which threads inside run() wait when idle, in place of
+  // the scheduler's own task. Threads that are already waiting are woken.
+  ASIO_DECL void init_thread_task(scheduler_task* task);
+
   // Run the event loop until interrupted or no more work.
   ASIO_DECL std::size_t run(asio::error_code& ec);
 
@@ -103,6 +128,12 @@ public:
       stop();
   }
 
+  // Get the count of unfinished work.
+  std::size_t outstanding_work() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(outstanding_work_));
+  }
+
   // Return whether a handler can be dispatched immediately.
   ASIO_DECL bool can_dispatch();
 
@@ -131,6 +162,30 @@ public:
   // operation for immediate invocation.
   ASIO_DECL void do_dispatch(operation* op);
 
+  // Request invocation of the given operation by the thread with the given
+  // index among those inside run(), and return immediately. If there is no
+  // such thread, any thread may run the operation. Assumes that work_started()
+  // has not yet been called for the operation.
+  ASIO_DECL void post_to_thread(std::size_t index, operation* op);
+
+  // Request invocation of the given operations by the thread with the given
+  // index among those inside run(), and return immediately. If there is no
+  // such thread, any thread may run the operations. Assumes that work_started()
+  // was previously called for each operation.
+  ASIO_DECL void post_deferred_completions_to_thread(
+      std::size_t index, op_queue<operation>& ops);
+
+  // Get the index of the current thread among those inside run(), or ~0 if
+  // the current thread is not inside run().
+  ASIO_DECL std::size_t this_thread_index();
+
+  // Get one more than the highest index that has been assigned to a thread
+  // inside run().
+  ASIO_DECL std::size_t run_thread_index_limit();
+
+  // Get the number of threads inside run() that are waiting for work.
+  ASIO_DECL std::size_t idle_thread_count();
+
   // Process unfinished operations as part of a shutdownoperation. Assumes that
   // work_started() was previously called for the operations.
   ASIO_DECL void abandon_operations(op_queue<operation>& ops);
@@ -141,6 +196,80 @@ public:
     return concurrency_hint_;
   }
 
+  // Set the longest time, in microseconds, that an idle thread spins before
+  // blocking when busy polling is enabled.
+  ASIO_DECL void set_busy_poll_usec(long usec);
+
+  // Get the number of times that an idle thread found work while spinning.
+  std::size_t busy_poll_hits() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(busy_poll_hits_));
+  }
+
+  // Get the number of times that an idle thread stopped spinning and blocked.
+  std::size_t busy_poll_misses() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(busy_poll_misses_));
+  }
+
+  // Set the largest number of handlers that may run between polls of the task.
+  // Zero means no limit.
+  ASIO_DECL void set_poll_handler_limit(std::size_t n);
+
+  // Set the longest time, in microseconds, that handlers may run between polls
+  // of the task. Zero means no limit.
+  ASIO_DECL void set_poll_time_limit_usec(long usec);
+
+  // Get the number of polls of the task forced by the handler limit.
+  std::size_t handler_limit_polls() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(handler_limit_polls_));
+  }
+
+  // Get the number of polls of the task forced by the time limit.
+  std::size_t time_limit_polls() const
+  {
+    return static_cast<std::size_t>(static_cast<long>(time_limit_polls_));
+  }
+
+#if defined(ASIO_HAS_IO_URING)
+  // Set the idle time, in milliseconds, and the CPU of the submission queue
+  // polling thread used by an io_uring instance created for the scheduler. A
+  // negative CPU leaves the thread's affinity unset.
+  void set_io_uring_sqpoll(long idle_msec, int cpu)
+  {
+    io_uring_sqpoll_idle_msec_ = idle_msec > 0 ? idle_msec : 0;
+    io_uring_sqpoll_cpu_ = cpu;
+  }
+
+  // Get the idle time, in milliseconds, of the submission queue polling
+  // thread.
+  long io_uring_sqpoll_idle_msec() const
+  {
+    return io_uring_sqpoll_idle_msec_;
+  }
+
+  // Get the CPU of the submission queue polling thread, or a negative value if
+  // its affinity is not set.
+  int io_uring_sqpoll_cpu() const
+  {
+    return io_uring_sqpoll_cpu_;
+  }
+
+  // Set the number of submission queue entries in each io_uring instance
+  // created for the scheduler.
+  void set_io_uring_ring_size(std::size_t entries)
+  {
+    io_uring_ring_size_ = entries;
+  }
+
+  // Get the number of submission queue entries in each io_uring instance.
+  std::size_t io_uring_ring_size() const
+  {
+    return io_uring_ring_size_;
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -163,6 +292,221 @@ private:
   ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const asio::error_code& ec);
 
+  // Run operations on a thread that other threads can reach, either to steal
+  // its operations or to target operations at it. Assumes the lock is held.
+  ASIO_DECL std::size_t run_registered(mutex::scoped_lock& lock,
+      thread_info& this_thread, asio::error_code& ec);
+
+  // Run at most one operation when work stealing is enabled. May block. The
+  // lock need not be held on entry, and may or may not be held on return.
+  ASIO_DECL std::size_t do_run_one_stealing(mutex::scoped_lock& lock,
+      thread_info& this_thread, const asio::error_code& ec);
+
+  // Get the current thread's info if it owns a local queue.
+  ASIO_DECL thread_info* current_worker();
+
+  // Add the current thread to the list of workers. Assumes the lock is held.
+  ASIO_DECL void register_worker(thread_info& this_thread);
+
+  // Add operations to a worker's local queue, waking an idle thread so that
+  // it may steal them.
+  ASIO_DECL void post_local(thread_info& this_thread,
+      op_queue<operation>& ops, std::size_t n);
+
+  // Take the operation at the front of a worker's local queue.
+  ASIO_DECL operation* pop_local(thread_info& this_thread);
+
+  // Add the current thread to the list of run threads. Assumes the lock is
+  // held.
+  ASIO_DECL void register_run_thread(thread_info& this_thread);
+
+  // Take the operation at the front of a run thread's targeted queue.
+  operation* pop_targeted(thread_info& this_thread)
+  {
+    return thread_indexes_ && targeted_ops_ != 0
+      ? take_targeted(this_thread) : 0;
+  }
+
+  // Take the operation at the front of a run thread's targeted queue, if the
+  // thread is a run thread and there is one.
+  ASIO_DECL operation* take_targeted(thread_info& this_thread);
+
+  // Add operations to a run thread's targeted queues according to their
+  // priorities. Assumes the thread's local mutex is held.
+  ASIO_DECL void push_targeted(thread_info& target, op_queue<operation>& ops);
+
+  // Wait for the wakeup event to be signalled. A thread inside run() that has
+  // an index waits on its own event instead, so that it can be woken alone.
+  // Assumes the lock is held.
+  ASIO_DECL void wait_for_wakeup(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+  // Take operations from the local queue of another worker. Assumes the lock
+  // is held, and may release it.
+  ASIO_DECL operation* steal(mutex::scoped_lock& lock,
+      thread_info& this_thread);
+
+  // Add an operation to the lock-free queue, waking a thread if the queue was
+  // previously empty.
+  ASIO_DECL void post_injected(operation* op);
+
+  // Add operations to the lock-free queue, waking a thread if the queue was
+  // previously empty.
+  ASIO_DECL void post_injected(op_queue<operation>& ops);
+
+  // Move any operations on the lock-free queue to the shared queue. Assumes
+  // the lock is held.
+  void take_injected()
+  {
+    if (lockfree_post_)
+      injected_ops_.take_all(op_queue_);
+  }
+
+  // Determine whether an idle thread should keep spinning. The idle_start
+  // argument records when the thread ran out of work, and is -1 if the thread
+  // is not yet idle.
+  ASIO_DECL bool busy_poll_spin(int64_t& idle_start);
+
+  // Record that a spinning thread found work, adapting the spin window.
+  ASIO_DECL void busy_poll_hit(int64_t idle_start);
+
+  // Spin without holding the lock until another thread may have added
+  // handlers, or until the spin window has elapsed. The lock is held again on
+  // return.
+  ASIO_DECL void busy_poll_wait(mutex::scoped_lock& lock, int64_t idle_start);
+
+  // Pause between checks in busy_poll_wait, given the number of checks made
+  // so far. Early checks use the processor's spin-wait hint, and later ones
+  // yield the processor to other threads.
+  ASIO_DECL static void busy_poll_pause(int checks);
+
+  // Get the current time in microseconds for measuring idle periods and time
+  // limits.
+  ASIO_DECL static int64_t clock_usec();
+
+  // Move the operations that have a high or low priority from one queue to
+  // another, returning the number of operations moved.
+  ASIO_DECL static std::size_t split_prioritised(
+      op_queue<operation>& ops, op_queue<operation>& prioritised);
+
+  // Add an operation to the queue for its priority and wake a thread.
+  ASIO_DECL void post_prioritised(operation* op);
+
+  // Add operations to the queues for their priorities and wake threads.
+  ASIO_DECL void post_prioritised(op_queue<operation>& ops, std::size_t n);
+
+  // Add operations to the queues for their priorities. Assumes the lock is
+  // held.
+  ASIO_DECL void push_prioritised(op_queue<operation>& ops);
+
+  // Move the next operation to run from the priority queues to the shared
+  // queue, if there is one. Assumes the lock is held.
+  void take_prioritised()
+  {
+    if (high_priority_ops_ != 0 || low_priority_ops_ != 0)
+      promote_prioritised();
+  }
+
+  // Choose whether an operation from the priority queues runs next, and move
+  // it to the shared queue. Assumes the lock is held.
+  ASIO_DECL void promote_prioritised();
+
+  // Check whether a limit on handlers run between polls of the task has been
+  // reached. The argument is the number of handlers run by the caller without
+  // the lock. Assumes the lock is held.
+  void check_poll_limits(std::size_t n = 0)
+  {
+    if (poll_handler_limit_ != 0 || poll_time_limit_usec_ != 0)
+      enforce_poll_limits(n);
+  }
+
+  // Move the task to the front of the shared queue if it has been waiting for
+  // too many handlers, or for too long. Assumes the lock is held.
+  ASIO_DECL void enforce_poll_limits(std::size_t n);
+
+  // Prepare the shared queue for the optional modes that are in use, before
+  // an operation is taken from it. The argument is the number of handlers run
+  // by the caller without the lock. Assumes the lock is held.
+  void prepare_shared_queue(std::size_t n = 0)
+  {
+    if (modes_ != 0)
+    {
+      take_injected();
+      take_prioritised();
+      check_poll_limits(n);
+    }
+  }
+
+  // Get the operation at the front of the shared queue. The task is passed
+  // over while operations that it completed on its previous run are still
+  // queued, as the reactor may not report their descriptors again until then.
+  // Assumes the lock is held.
+  operation* front_shared()
+  {
+    operation* o = op_queue_.front();
+    if (o == &task_operation_ && task_ops_pending_ != 0)
+      o = pass_over_task();
+    return o;
+  }
+
+  // Move the operation behind the task to the front of the shared queue, and
+  // return it. Assumes the lock is held.
+  ASIO_DECL operation* pass_over_task();
+
+  // Mark and count the task's completed operations, which are about to be
+  // queued. Returns the number of operations.
+  ASIO_DECL std::size_t track_task_output(op_queue<operation>& ops);
+
+  // Note that an operation has been taken from a queue. Returns true if it was
+  // the last of the task's completed operations to be taken.
+  bool task_output_dequeued(operation* o)
+  {
+    if ((modes_ & task_output_mode) == 0 || o->task_output_ == 0)
+      return false;
+    o->task_output_ = 0;
+    return --task_ops_pending_ == 0;
+  }
+
+  // Whether there are operations on the shared or priority queues. Assumes the
+  // lock is held.
+  bool handlers_queued() const
+  {
+    return !op_queue_.empty() || ((modes_ & priority_mode) != 0
+        && (high_priority_ops_ != 0 || low_priority_ops_ != 0));
+  }
+
+  // If there are idle threads, unlock the mutex and wake up to n of them,
+  // returning the number woken. Assumes the lock is held.
+  ASIO_DECL std::size_t maybe_wake_idle_threads(
+      mutex::scoped_lock& lock, std::size_t n);
+
+  // If there is an idle thread, unlock the mutex and wake it.
+  bool maybe_wake_idle_thread(mutex::scoped_lock& lock)
+  {
+    if (!thread_indexes_ && !busy_poll_)
+      return wakeup_event_.maybe_unlock_and_signal_one(lock);
+    return maybe_wake_idle_threads(lock, 1) > 0;
+  }
+
+  // Unlock the mutex and wake an idle thread, if there is one.
+  void unlock_and_wake_idle_thread(mutex::scoped_lock& lock)
+  {
+    if (!maybe_wake_idle_thread(lock))
+      lock.unlock();
+  }
+
+  // Take a thread off the list of idle threads. Assumes the lock is held.
+  ASIO_DECL void remove_idle_thread(thread_info& idle_thread);
+
+  // Wake a thread that is waiting on its own event, or on its part of the
+  // task. Assumes the lock is held.
+  ASIO_DECL void wake_idle_thread(mutex::scoped_lock& lock,
+      thread_info& idle_thread);
+
+  // Wake all threads that are waiting on their own events, or on their parts
+  // of the task. Assumes the lock is held.
+  ASIO_DECL void wake_idle_threads(mutex::scoped_lock& lock);
+
   // Stop the task and all idle threads.
   ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -170,6 +514,11 @@ private:
   ASIO_DECL void wake_one_thread_and_unlock(
       mutex::scoped_lock& lock);
 
+  // Wake as many idle threads as there are new operations, or the task if no
+  // threads are idle, and always unlock the mutex.
+  ASIO_DECL void wake_threads_and_unlock(
+      mutex::scoped_lock& lock, std::size_t n);
+
   // Get the default task.
   ASIO_DECL static scheduler_task* get_default_task(
       asio::execution_context& ctx);
@@ -186,6 +535,15 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to remove a thread from the list of workers on block exit.
+  struct worker_cleanup;
+  friend struct worker_cleanup;
+
+  // Helper class to remove a thread from the list of run threads on block
+  // exit.
+  struct run_thread_cleanup;
+  friend struct run_thread_cleanup;
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -198,6 +556,10 @@ private:
   // The task to be run by this service.
   scheduler_task* task_;
 
+  // The task on which threads inside run() wait when idle, or 0 if they wait
+  // on the scheduler's own task.
+  scheduler_task* thread_task_;
+
   // The function used to get the task.
   get_task_func_type get_task_;
 
@@ -210,6 +572,11 @@ private:
   // Whether the task has been interrupted.
   bool task_interrupted_;
 
+  // The number of operations completed by the task that are yet to be taken
+  // from a queue. Only counted for a work stealing scheduler, or when there is
+  // a limit on handlers run between polls of the task.
+  atomic_count task_ops_pending_;
+
   // The count of unfinished work.
   atomic_count outstanding_work_;
 
@@ -225,6 +592,149 @@ private:
   // The concurrency hint used to initialise the scheduler.
   const int concurrency_hint_;
 
+  // Whether threads calling run() keep the handlers they post on a local
+  // queue, from which other threads may steal.
+  const bool work_stealing_;
+
+  // The number of local queue operations between checks of the shared queue.
+  enum { shared_queue_interval = 61 };
+
+  // Whether handlers posted to the shared queue are first added to a lock-free
+  // queue.
+  const bool lockfree_post_;
+
+  // The optional modes that are checked for each time an operation is taken
+  // from the shared queue. A mode is added when the scheduler is constructed
+  // with the hint that enables it, or when the mode is first used, and is not
+  // removed. Protected by mutex_.
+  enum
+  {
+    injection_mode = 1,
+    priority_mode = 2,
+    poll_limit_mode = 4,
+    task_output_mode = 8
+  };
+  unsigned int modes_;
+
+  // Operations that have been posted without acquiring the mutex.
+  atomic_op_queue<operation> injected_ops_;
+
+  // Operations with a high priority, run ahead of those on the shared queue.
+  op_queue<operation> high_priority_queue_;
+
+  // Operations with a low priority, run when the shared queue has no handlers.
+  op_queue<operation> low_priority_queue_;
+
+  // The number of operations on each priority queue. Modified only while the
+  // lock is held, but may be read without it.
+  atomic_count high_priority_ops_;
+  atomic_count low_priority_ops_;
+
+  // The number of high priority operations run in a row while operations with
+  // a lower priority were waiting.
+  std::size_t high_priority_streak_;
+
+  // The number of times an operation was chosen while a low priority operation
+  // was waiting.
+  std::size_t low_priority_wait_;
+
+  // Whether idle threads spin before blocking.
+  const bool busy_poll_;
+
+  // The number of checks that a spinning thread makes before it starts to
+  // yield the processor between them.
+  enum { busy_poll_pause_checks = 128 };
+
+  // The type used to hold the spin window. Busy polling is disabled when
+  // atomic_count does not support assignment.
+#if !defined(ASIO_HAS_THREADS) || defined(ASIO_HAS_STD_ATOMIC)
+  typedef atomic_count busy_poll_window;
+#else // !defined(ASIO_HAS_THREADS) || defined(ASIO_HAS_STD_ATOMIC)
+  typedef long busy_poll_window;
+#endif // !defined(ASIO_HAS_THREADS) || defined(ASIO_HAS_STD_ATOMIC)
+
+  // The longest time, in microseconds, that an idle thread may spin.
+  busy_poll_window busy_poll_max_usec_;
+
+  // The current spin window, in microseconds, adapted to recent idle periods.
+  busy_poll_window busy_poll_usec_;
+
+  // The number of idle periods that ended while spinning.
+  atomic_count busy_poll_hits_;
+
+  // The number of idle periods that outlasted the spin window.
+  atomic_count busy_poll_misses_;
+
+  // Changed whenever a thread is to be woken, so that spinning threads know to
+  // look at the queues again.
+  atomic_count busy_poll_epoch_;
+
+  // The largest number of handlers that may run between polls of the task, or
+  // zero for no limit. Protected by mutex_.
+  std::size_t poll_handler_limit_;
+
+  // The longest time, in microseconds, that handlers may run between polls of
+  // the task, or zero for no limit. Protected by mutex_.
+  long poll_time_limit_usec_;
+
+  // The number of handlers run since the task last returned.
+  std::size_t handlers_since_poll_;
+
+  // The time at which the task last returned, if there is a time limit.
+  int64_t last_poll_usec_;
+
+  // The number of polls of the task forced by the handler limit.
+  atomic_count handler_limit_polls_;
+
+  // The number of polls of the task forced by the time limit.
+  atomic_count time_limit_polls_;
+
+#if defined(ASIO_HAS_IO_URING)
+  // The idle time, in milliseconds, of an io_uring submission queue polling
+  // thread.
+  long io_uring_sqpoll_idle_msec_;
+
+  // The CPU of an io_uring submission queue polling thread, or -1 for none.
+  int io_uring_sqpoll_cpu_;
+
+  // The number of submission queue entries in each io_uring instance.
+  std::size_t io_uring_ring_size_;
+#endif // defined(ASIO_HAS_IO_URING)
+
+  // The threads that own a local queue. Slots are reused as threads come and
+  // go. Protected by mutex_.
+  std::vector<thread_info*> workers_;
+
+  // The threads inside run(), which may be targeted by operations. Slots are
+  // reused as threads come and go. Protected by mutex_.
+  std::vector<thread_info*> run_threads_;
+
+  // The number of operations on the targeted queues of all run threads.
+  atomic_count targeted_ops_;
+
+  // Whether idle threads inside run() wait on their own events, and the most
+  // recently idled thread is woken first.
+  const bool lifo_wake_;
+
+  // Whether threads inside run() are given indexes, by which operations may be
+  // targeted at them. Such threads wait on their own events when idle.
+  const bool thread_indexes_;
+
+  // Whether threads inside run() own part of the task, and wait on it instead
+  // of their events when idle.
+  const bool thread_tasks_;
+
+  // The threads inside run() that are waiting on their own events, with the
+  // most recently idled thread at the back. Protected by mutex_.
+  std::vector<thread_info*> idle_threads_;
+
+  // The number of workers waiting for the wakeup event.
+  atomic_count idle_workers_;
+
+  // A copy of stopped_ that may be read without holding the mutex. Kept only
+  // when work stealing or busy polling, as nothing else reads it.
+  atomic_count stopped_flag_;
+
   // The thread that is running the scheduler.
   asio::detail::thread* thread_;
 };
@@ -44,6 +44,24 @@ public:
     func_(0, this, asio::error_code(), 0);
   }
 
+  // The priorities used to choose a scheduler queue for the operation.
+  enum priority_type
+  {
+    normal_priority = 0,
+    high_priority = 1,
+    low_priority = 2
+  };
+
+  priority_type priority() const
+  {
+    return static_cast<priority_type>(priority_);
+  }
+
+  void set_priority(priority_type p)
+  {
+    priority_ = static_cast<unsigned char>(p);
+  }
+
 protected:
   typedef void (*func_type)(void*,
       scheduler_operation*,
@@ -52,7 +70,9 @@ protected:
   scheduler_operation(func_type func)
     : next_(0),
       func_(func),
-      task_result_(0)
+      task_result_(0),
+      priority_(normal_priority),
+      task_output_(0)
   {
   }
 
@@ -63,11 +83,17 @@ protected:
 
 private:
   friend class op_queue_access;
+  friend class handler_watchdog;
   scheduler_operation* next_;
   func_type func_;
 protected:
   friend class scheduler;
   unsigned int task_result_; // Passed into bytes transferred.
+private:
+  // These occupy the padding that follows task_result_ on targets with 64-bit
+  // pointers, so they do not make the operation any larger.
+  unsigned char priority_;
+  unsigned char task_output_; // Completed by the scheduler's task.
 };
 
 } // namespace detail
@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstddef>
 #include "asio/detail/op_queue.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -34,6 +35,21 @@ public:
   // Interrupt the task.
   virtual void interrupt() = 0;
 
+  // Wait on the part of the task owned by the thread with the given index,
+  // until events are ready to be dispatched by that thread or the wait is
+  // interrupted. Returns false, without waiting, if the thread has nothing of
+  // its own to wait on.
+  virtual bool run_thread(std::size_t /*index*/,
+      op_queue<scheduler_operation>& /*ops*/)
+  {
+    return false;
+  }
+
+  // Interrupt a wait on the part of the task owned by a thread.
+  virtual void interrupt_thread(std::size_t /*index*/)
+  {
+  }
+
 protected:
   // Prevent deletion through this type.
   ~scheduler_task()
@@ -15,6 +15,10 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include "asio/detail/cstdint.hpp"
+#include "asio/detail/mutex.hpp"
 #include "asio/detail/op_queue.hpp"
 #include "asio/detail/thread_info_base.hpp"
 
@@ -23,13 +27,88 @@
 namespace asio {
 namespace detail {
 
+class conditionally_enabled_event;
 class scheduler;
 class scheduler_operation;
 
+// The queues of a thread inside run() that other threads can reach, either to
+// take operations from it when work stealing or to target operations at it.
+// They are created only by such threads, so that other threads do not pay for
+// them.
+struct scheduler_thread_queues
+{
+  // The local queue may be accessed by other threads looking for work, and
+  // the targeted queues by threads adding operations, so they are protected
+  // by their own mutex.
+  mutex local_mutex;
+  op_queue<scheduler_operation> local_op_queue;
+
+  // Operations targeted at the thread. Prioritised operations have their own
+  // queues, so that they run before or after the thread's other operations.
+  op_queue<scheduler_operation> targeted_op_queue;
+  op_queue<scheduler_operation> targeted_high_priority_queue;
+  op_queue<scheduler_operation> targeted_low_priority_queue;
+};
+
 struct scheduler_thread_info : public thread_info_base
 {
+  // Value of worker_index for threads that do not own a local queue.
+  static const std::size_t not_a_worker = ~static_cast<std::size_t>(0);
+
+  // Value of run_index for threads that are not inside run().
+  static const std::size_t not_a_run_thread = ~static_cast<std::size_t>(0);
+
+  // What a thread inside run() is doing, so that a thread adding a targeted
+  // operation knows how to wake it.
+  enum run_state_type
+  {
+    running,
+    waiting,
+    running_task,
+    waiting_in_task
+  };
+
+  scheduler_thread_info()
+    : queues(0),
+      local_op_count(0),
+      local_tick(0),
+      worker_index(not_a_worker),
+      run_index(not_a_run_thread),
+      run_state(running),
+      wakeup_event(0),
+      idle_since_usec(0)
+  {
+  }
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+
+  // The thread's queues, if other threads can reach it.
+  scheduler_thread_queues* queues;
+
+  // The following members are used only when the scheduler performs work
+  // stealing.
+  std::size_t local_op_count;
+
+  // The number of handlers taken from the local queue since the scheduler's
+  // shared queue was last checked.
+  std::size_t local_tick;
+
+  // The position of this thread in the scheduler's list of workers.
+  std::size_t worker_index;
+
+  // The following members are used only by threads inside run().
+
+  // The position of this thread in the scheduler's list of run threads.
+  std::size_t run_index;
+
+  // What the thread is doing. Protected by the scheduler's mutex.
+  run_state_type run_state;
+
+  // The event on which the thread waits when idle threads are woken in LIFO
+  // order, and the time at which it last became idle.
+  conditionally_enabled_event* wakeup_event;
+  int64_t idle_since_usec;
 };
 
 } // namespace detail
@@ -21,6 +21,7 @@
 #include "asio/detail/handler_alloc_helpers.hpp"
 #include "asio/detail/handler_work.hpp"
 #include "asio/detail/memory.hpp"
+#include "asio/detail/operation_priority.hpp"
 #include "asio/detail/signal_op.hpp"
 
 #include "asio/detail/push_options.hpp"
@@ -39,6 +40,7 @@ public:
       handler_(ASIO_MOVE_CAST(Handler)(h)),
       work_(handler_, io_ex)
   {
+    inherit_operation_priority(*this, handler_, io_ex);
   }
 
   static void do_complete(void* owner, operation* base,
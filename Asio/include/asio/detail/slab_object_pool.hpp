@@ -0,0 +1,221 @@
+//
+// detail/slab_object_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_DETAIL_SLAB_OBJECT_POOL_HPP
+#define ASIO_DETAIL_SLAB_OBJECT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <cstddef>
+#include <new>
+#include "asio/detail/memory.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/object_pool.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+// This #define may be overridden at compile time to specify the size, in
+// bytes, of a cache line. Objects allocated from a slab object pool start on,
+// and are padded to, a multiple of this size.
+#if !defined(ASIO_CACHE_LINE_SIZE)
+# define ASIO_CACHE_LINE_SIZE 64
+#endif // !defined(ASIO_CACHE_LINE_SIZE)
+
+// This #define may be overridden at compile time to specify the number of
+// objects in each chunk of memory allocated by a slab object pool.
+#if !defined(ASIO_SLAB_OBJECT_POOL_CHUNK_SIZE)
+# define ASIO_SLAB_OBJECT_POOL_CHUNK_SIZE 128
+#endif // !defined(ASIO_SLAB_OBJECT_POOL_CHUNK_SIZE)
+
+namespace asio {
+namespace detail {
+
+// An object pool with the same interface as object_pool, but which constructs
+// its objects in contiguous chunks of memory. Each object occupies whole cache
+// lines, so that objects used by different threads do not share a line. Freed
+// objects are reused most recently freed first, and the memory is returned
+// only when the pool is destroyed.
+template <typename Object>
+class slab_object_pool
+  : private noncopyable
+{
+public:
+  // Constructor.
+  slab_object_pool()
+    : live_list_(0),
+      free_list_(0),
+      chunks_(0),
+      next_slot_(0),
+      end_slot_(0)
+  {
+  }
+
+  // Destructor destroys all objects and frees the chunks.
+  ~slab_object_pool()
+  {
+    destroy_list(live_list_);
+    destroy_list(free_list_);
+    while (chunks_)
+    {
+      chunk* c = chunks_;
+      chunks_ = c->next_;
+      aligned_delete(c);
+    }
+  }
+
+  // Get the object at the start of the live list.
+  Object* first()
+  {
+    return live_list_;
+  }
+
+  // Allocate a new object.
+  Object* alloc()
+  {
+    Object* o = free_list_;
+    if (o)
+      free_list_ = object_pool_access::next(free_list_);
+    else
+    {
+      o = object_pool_access::construct<Object>(next_slot());
+      next_slot_ += slot_size;
+    }
+
+    link(o);
+    return o;
+  }
+
+  // Allocate a new object with an argument.
+  template <typename Arg>
+  Object* alloc(Arg arg)
+  {
+    Object* o = free_list_;
+    if (o)
+      free_list_ = object_pool_access::next(free_list_);
+    else
+    {
+      o = object_pool_access::construct<Object>(next_slot(), arg);
+      next_slot_ += slot_size;
+    }
+
+    link(o);
+    return o;
+  }
+
+  // Free an object. Moves it to the free list. No destructors are run.
+  void free(Object* o)
+  {
+    if (live_list_ == o)
+      live_list_ = object_pool_access::next(o);
+
+    if (object_pool_access::prev(o))
+    {
+      object_pool_access::next(object_pool_access::prev(o))
+        = object_pool_access::next(o);
+    }
+
+    if (object_pool_access::next(o))
+    {
+      object_pool_access::prev(object_pool_access::next(o))
+        = object_pool_access::prev(o);
+    }
+
+    object_pool_access::next(o) = free_list_;
+    object_pool_access::prev(o) = 0;
+    free_list_ = o;
+  }
+
+private:
+  // The header at the start of each chunk. The slots follow it, starting at
+  // the next cache line boundary.
+  struct chunk
+  {
+    chunk* next_;
+  };
+
+  enum
+  {
+    // The size of each object's slot, rounded up to whole cache lines.
+    slot_size = (sizeof(Object) + ASIO_CACHE_LINE_SIZE - 1)
+      / ASIO_CACHE_LINE_SIZE * ASIO_CACHE_LINE_SIZE,
+
+    // The size of each chunk, including its header and enough space to align
+    // the slots when the memory itself is not aligned to a cache line.
+    chunk_size = slot_size * ASIO_SLAB_OBJECT_POOL_CHUNK_SIZE
+      + sizeof(chunk) + ASIO_CACHE_LINE_SIZE - 1
+  };
+
+  // Get memory for a new object, allocating a new chunk if required. The slot
+  // is only taken once the object has been constructed in it, so that it is
+  // used again if the constructor throws.
+  void* next_slot()
+  {
+    if (next_slot_ == end_slot_)
+    {
+      chunk* c = static_cast<chunk*>(
+          aligned_new(ASIO_CACHE_LINE_SIZE, chunk_size));
+      c->next_ = chunks_;
+      chunks_ = c;
+      char* first = reinterpret_cast<char*>(c) + sizeof(chunk);
+      first += (ASIO_CACHE_LINE_SIZE - reinterpret_cast<std::size_t>(first)
+          % ASIO_CACHE_LINE_SIZE) % ASIO_CACHE_LINE_SIZE;
+      next_slot_ = first;
+      end_slot_ = first + slot_size * ASIO_SLAB_OBJECT_POOL_CHUNK_SIZE;
+    }
+
+    return next_slot_;
+  }
+
+  // Add an object to the start of the live list.
+  void link(Object* o)
+  {
+    object_pool_access::next(o) = live_list_;
+    object_pool_access::prev(o) = 0;
+    if (live_list_)
+      object_pool_access::prev(live_list_) = o;
+    live_list_ = o;
+  }
+
+  // Helper function to destroy all elements in a list.
+  void destroy_list(Object* list)
+  {
+    while (list)
+    {
+      Object* o = list;
+      list = object_pool_access::next(o);
+      object_pool_access::destruct(o);
+    }
+  }
+
+  // The list of live objects.
+  Object* live_list_;
+
+  // The free list.
+  Object* free_list_;
+
+  // The chunks that have been allocated, most recent first.
+  chunk* chunks_;
+
+  // The next unused slot in the most recent chunk.
+  char* next_slot_;
+
+  // The end of the most recent chunk.
+  char* end_slot_;
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_DETAIL_SLAB_OBJECT_POOL_HPP
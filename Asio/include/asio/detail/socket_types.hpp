@@ -362,6 +362,9 @@ typedef int signed_size_type; //
 # define ASIO_OS_DEF_SO_SNDLOWAT SO_SNDLOWAT
 # define ASIO_OS_DEF_SO_RCVLOWAT SO_RCVLOWAT
 # define ASIO_OS_DEF_SO_REUSEADDR SO_REUSEADDR
+# if defined(SO_REUSEPORT)
+#  define ASIO_OS_DEF_SO_REUSEPORT SO_REUSEPORT
+# endif // defined(SO_REUSEPORT)
 # define ASIO_OS_DEF_TCP_NODELAY TCP_NODELAY
 # define ASIO_OS_DEF_IP_MULTICAST_IF IP_MULTICAST_IF
 # define ASIO_OS_DEF_IP_MULTICAST_TTL IP_MULTICAST_TTL
@@ -410,6 +413,7 @@ const int max_iov_len = 16;
 const int custom_socket_option_level = 0xA5100000;
 const int enable_connection_aborted_option = 1;
 const int always_fail_option = 2;
+const int io_quota_option = 3;
 
 } // namespace detail
 } // namespace asio
@@ -103,6 +103,24 @@ public:
     return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them. Returns
+  // the number of waiters signalled.
+  template <typename Lock>
+  std::size_t maybe_unlock_and_signal_some(Lock& lock, std::size_t n)
+  {
+    ASIO_ASSERT(lock.locked());
+    state_ |= 1;
+    std::size_t waiters = state_ >> 1;
+    std::size_t count = waiters < n ? waiters : n;
+    if (count > 0)
+    {
+      lock.unlock();
+      for (std::size_t i = 0; i < count; ++i)
+        cond_.notify_one();
+    }
+    return count;
+  }
+
   // Reset the event.   ¼
   template <typename Lock>
   void clear(Lock& lock)
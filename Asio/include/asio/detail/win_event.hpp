@@ -19,6 +19,7 @@
 
 #if defined(ASIO_WINDOWS)
 
+#include <climits>
 #include <cstddef>
 #include "asio/detail/assert.hpp"
 #include "asio/detail/noncopyable.hpp"
@@ -95,6 +96,27 @@ public:
     return false;
   }
 
+  // If there are waiters, unlock the mutex and signal up to n of them. Returns
+  // the number of waiters signalled.
+  template <typename Lock>
+  std::size_t maybe_unlock_and_signal_some(Lock& lock, std::size_t n)
+  {
+    ASIO_ASSERT(lock.locked());
+    state_ |= 1;
+    std::size_t waiters = state_ >> 1;
+    std::size_t count = waiters < n ? waiters : n;
+    if (count > 0)
+    {
+      lock.unlock();
+      // An auto-reset event wakes at most one waiter however many times it is
+      // set, so the waiters are released through the semaphore instead.
+      if (count > static_cast<std::size_t>(LONG_MAX))
+        count = static_cast<std::size_t>(LONG_MAX);
+      ::ReleaseSemaphore(events_[2], static_cast<LONG>(count), 0);
+    }
+    return count;
+  }
+
   // Reset the event.
   template <typename Lock>
   void clear(Lock& lock)
@@ -115,9 +137,9 @@ public:
       state_ += 2;
       lock.unlock();
 #if defined(ASIO_WINDOWS_APP)
-      ::WaitForMultipleObjectsEx(2, events_, false, INFINITE, false);
+      ::WaitForMultipleObjectsEx(3, events_, false, INFINITE, false);
 #else // defined(ASIO_WINDOWS_APP)
-      ::WaitForMultipleObjects(2, events_, false, INFINITE);
+      ::WaitForMultipleObjects(3, events_, false, INFINITE);
 #endif // defined(ASIO_WINDOWS_APP)
       lock.lock();
       state_ -= 2;
@@ -135,9 +157,9 @@ public:
       lock.unlock();
       DWORD msec = usec > 0 ? (usec < 1000 ? 1 : usec / 1000) : 0;
 #if defined(ASIO_WINDOWS_APP)
-      ::WaitForMultipleObjectsEx(2, events_, false, msec, false);
+      ::WaitForMultipleObjectsEx(3, events_, false, msec, false);
 #else // defined(ASIO_WINDOWS_APP)
-      ::WaitForMultipleObjects(2, events_, false, msec);
+      ::WaitForMultipleObjects(3, events_, false, msec);
 #endif // defined(ASIO_WINDOWS_APP)
       lock.lock();
       state_ -= 2;
@@ -146,7 +168,9 @@ public:
   }
 
 private:
-  HANDLE events_[2];
+  // A manual-reset event to signal all waiters, an auto-reset event to signal
+  // one, and a semaphore to signal several.
+  HANDLE events_[3];
   std::size_t state_;
 };
 
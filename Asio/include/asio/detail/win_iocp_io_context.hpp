@@ -108,6 +108,12 @@ public:
       stop();
   }
 
+  // Get the count of unfinished work.
+  std::size_t outstanding_work() const
+  {
+    return static_cast<std::size_t>(outstanding_work_);
+  }
+
   // Return whether a handler can be dispatched immediately.
   ASIO_DECL bool can_dispatch();
 
@@ -122,6 +128,30 @@ public:
     post_deferred_completion(op);
   }
 
+  // Request invocation of the given operation by a particular thread. Threads
+  // waiting on the completion port are not distinguished, so any thread may
+  // run the operation.
+  void post_to_thread(std::size_t, win_iocp_operation* op)
+  {
+    post_immediate_completion(op, false);
+  }
+
+  // Get the index of the current thread among those inside run(). Threads are
+  // not distinguished, so there is no index.
+  std::size_t this_thread_index()
+  {
+    return ~static_cast<std::size_t>(0);
+  }
+
+  // Request invocation of the given operations and return immediately.
+  // Assumes that work_started() has not yet been called for the operations.
+  void post_immediate_completions(std::size_t n,
+      op_queue<win_iocp_operation>& ops, bool)
+  {
+    ::InterlockedExchangeAdd(&outstanding_work_, static_cast<long>(n));
+    post_deferred_completions(ops);
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   ASIO_DECL void post_deferred_completion(win_iocp_operation* op);
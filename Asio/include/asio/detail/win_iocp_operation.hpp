@@ -81,6 +81,7 @@ protected:
 
 private:
   friend class op_queue_access;
+  friend class handler_watchdog;
   friend class win_iocp_io_context;
   win_iocp_operation* next_;
   func_type func_;
@@ -33,6 +33,7 @@
 #include "asio/execution/operation_state.hpp"
 #include "asio/execution/outstanding_work.hpp"
 #include "asio/execution/prefer_only.hpp"
+#include "asio/execution/priority.hpp"
 #include "asio/execution/receiver.hpp"
 #include "asio/execution/receiver_invocation_error.hpp"
 #include "asio/execution/relationship.hpp"
@@ -0,0 +1,1117 @@
+//
+// execution/priority.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_EXECUTION_PRIORITY_HPP
+#define ASIO_EXECUTION_PRIORITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution/scheduler.hpp"
+#include "asio/execution/sender.hpp"
+#include "asio/is_applicable_property.hpp"
+#include "asio/query.hpp"
+#include "asio/traits/query_free.hpp"
+#include "asio/traits/query_member.hpp"
+#include "asio/traits/query_static_constexpr_member.hpp"
+#include "asio/traits/static_query.hpp"
+#include "asio/traits/static_require.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+#if defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+
+/// A property to describe the priority with which an executor runs submitted
+/// function objects, relative to other function objects that are ready to run
+/// in the same execution context.
+struct priority_t
+{
+  /// The priority_t property applies to executors, senders, and schedulers.
+  template <typename T>
+  static constexpr bool is_applicable_property_v =
+    is_executor_v<T> || is_sender_v<T> || is_scheduler_v<T>;
+
+  /// The top-level priority_t property cannot be required.
+  static constexpr bool is_requirable = false;
+
+  /// The top-level priority_t property cannot be preferred.
+  static constexpr bool is_preferable = false;
+
+  /// The type returned by queries against an @c any_executor.
+  typedef priority_t polymorphic_query_result_type;
+
+  /// A sub-property that indicates that submitted function objects run with
+  /// the default priority.
+  struct normal_t
+  {
+    /// The priority_t::normal_t property applies to executors, senders, and
+    /// schedulers.
+    template <typename T>
+    static constexpr bool is_applicable_property_v =
+      is_executor_v<T> || is_sender_v<T> || is_scheduler_v<T>;
+
+    /// The priority_t::normal_t property can be required.
+    static constexpr bool is_requirable = true;
+
+    /// The priority_t::normal_t property can be preferred.
+    static constexpr bool is_preferable = true;
+
+    /// The type returned by queries against an @c any_executor.
+    typedef priority_t polymorphic_query_result_type;
+
+    /// Default constructor.
+    constexpr normal_t();
+
+    /// Get the value associated with a property object.
+    /**
+     * @returns normal_t();
+     */
+    static constexpr priority_t value();
+  };
+
+  /// A sub-property that indicates that submitted function objects run before
+  /// those with normal or low priority.
+  struct high_t
+  {
+    /// The priority_t::high_t property applies to executors, senders, and
+    /// schedulers.
+    template <typename T>
+    static constexpr bool is_applicable_property_v =
+      is_executor_v<T> || is_sender_v<T> || is_scheduler_v<T>;
+
+    /// The priority_t::high_t property can be required.
+    static constexpr bool is_requirable = true;
+
+    /// The priority_t::high_t property can be preferred.
+    static constexpr bool is_preferable = true;
+
+    /// The type returned by queries against an @c any_executor.
+    typedef priority_t polymorphic_query_result_type;
+
+    /// Default constructor.
+    constexpr high_t();
+
+    /// Get the value associated with a property object.
+    /**
+     * @returns high_t();
+     */
+    static constexpr priority_t value();
+  };
+
+  /// A sub-property that indicates that submitted function objects run after
+  /// those with normal or high priority.
+  struct low_t
+  {
+    /// The priority_t::low_t property applies to executors, senders, and
+    /// schedulers.
+    template <typename T>
+    static constexpr bool is_applicable_property_v =
+      is_executor_v<T> || is_sender_v<T> || is_scheduler_v<T>;
+
+    /// The priority_t::low_t property can be required.
+    static constexpr bool is_requirable = true;
+
+    /// The priority_t::low_t property can be preferred.
+    static constexpr bool is_preferable = true;
+
+    /// The type returned by queries against an @c any_executor.
+    typedef priority_t polymorphic_query_result_type;
+
+    /// Default constructor.
+    constexpr low_t();
+
+    /// Get the value associated with a property object.
+    /**
+     * @returns low_t();
+     */
+    static constexpr priority_t value();
+  };
+
+  /// A special value used for accessing the priority_t::normal_t property.
+  static constexpr normal_t normal;
+
+  /// A special value used for accessing the priority_t::high_t property.
+  static constexpr high_t high;
+
+  /// A special value used for accessing the priority_t::low_t property.
+  static constexpr low_t low;
+
+  /// Default constructor.
+  constexpr priority_t();
+
+  /// Construct from a sub-property value.
+  constexpr priority_t(normal_t);
+
+  /// Construct from a sub-property value.
+  constexpr priority_t(high_t);
+
+  /// Construct from a sub-property value.
+  constexpr priority_t(low_t);
+
+  /// Compare property values for equality.
+  friend constexpr bool operator==(
+      const priority_t& a, const priority_t& b) noexcept;
+
+  /// Compare property values for inequality.
+  friend constexpr bool operator!=(
+      const priority_t& a, const priority_t& b) noexcept;
+};
+
+/// A special value used for accessing the priority_t property.
+constexpr priority_t priority;
+
+} // namespace execution
+
+#else // defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+namespace detail {
+namespace priority {
+
+template <int I> struct normal_t;
+template <int I> struct high_t;
+template <int I> struct low_t;
+
+} // namespace priority
+
+template <int I = 0>
+struct priority_t
+{
+#if defined(ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  ASIO_STATIC_CONSTEXPR(bool,
+    is_applicable_property_v = (
+      is_executor<T>::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_sender<T>
+          >::type::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_scheduler<T>
+          >::type::value));
+#endif // defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+  ASIO_STATIC_CONSTEXPR(bool, is_requirable = false);
+  ASIO_STATIC_CONSTEXPR(bool, is_preferable = false);
+  typedef priority_t polymorphic_query_result_type;
+
+  typedef detail::priority::normal_t<I> normal_t;
+  typedef detail::priority::high_t<I> high_t;
+  typedef detail::priority::low_t<I> low_t;
+
+  ASIO_CONSTEXPR priority_t()
+    : value_(-1)
+  {
+  }
+
+  ASIO_CONSTEXPR priority_t(normal_t)
+    : value_(0)
+  {
+  }
+
+  ASIO_CONSTEXPR priority_t(high_t)
+    : value_(1)
+  {
+  }
+
+  ASIO_CONSTEXPR priority_t(low_t)
+    : value_(2)
+  {
+  }
+
+  template <typename T>
+  struct proxy
+  {
+#if defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+    struct type
+    {
+      template <typename P>
+      auto query(ASIO_MOVE_ARG(P) p) const
+        noexcept(
+          noexcept(
+            declval<typename conditional<true, T, P>::type>().query(
+              ASIO_MOVE_CAST(P)(p))
+          )
+        )
+        -> decltype(
+          declval<typename conditional<true, T, P>::type>().query(
+            ASIO_MOVE_CAST(P)(p))
+        );
+    };
+#else // defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+    typedef T type;
+#endif // defined(ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+  };
+
+  template <typename T>
+  struct static_proxy
+  {
+#if defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+    struct type
+    {
+      template <typename P>
+      static constexpr auto query(ASIO_MOVE_ARG(P) p)
+        noexcept(
+          noexcept(
+            conditional<true, T, P>::type::query(ASIO_MOVE_CAST(P)(p))
+          )
+        )
+        -> decltype(
+          conditional<true, T, P>::type::query(ASIO_MOVE_CAST(P)(p))
+        )
+      {
+        return T::query(ASIO_MOVE_CAST(P)(p));
+      }
+    };
+#else // defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+    typedef T type;
+#endif // defined(ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+  };
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<typename proxy<T>::type, priority_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename static_proxy<T>::type, priority_t> {};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    ASIO_NOEXCEPT_IF((
+      query_static_constexpr_member<T>::is_noexcept))
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename traits::static_query<T, normal_t>::result_type
+  static_query(
+      typename enable_if<
+        !query_static_constexpr_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !query_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        traits::static_query<T, normal_t>::is_valid
+      >::type* = 0) ASIO_NOEXCEPT
+  {
+    return traits::static_query<T, normal_t>::value();
+  }
+
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename traits::static_query<T, high_t>::result_type
+  static_query(
+      typename enable_if<
+        !query_static_constexpr_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !query_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !traits::static_query<T, normal_t>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        traits::static_query<T, high_t>::is_valid
+      >::type* = 0) ASIO_NOEXCEPT
+  {
+    return traits::static_query<T, high_t>::value();
+  }
+
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename traits::static_query<T, low_t>::result_type
+  static_query(
+      typename enable_if<
+        !query_static_constexpr_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !query_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !traits::static_query<T, normal_t>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !traits::static_query<T, high_t>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        traits::static_query<T, low_t>::is_valid
+      >::type* = 0) ASIO_NOEXCEPT
+  {
+    return traits::static_query<T, low_t>::value();
+  }
+
+  template <typename E, typename T = decltype(priority_t::static_query<E>())>
+  static ASIO_CONSTEXPR const T static_query_v
+    = priority_t::static_query<E>();
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  friend ASIO_CONSTEXPR bool operator==(
+      const priority_t& a, const priority_t& b)
+  {
+    return a.value_ == b.value_;
+  }
+
+  friend ASIO_CONSTEXPR bool operator!=(
+      const priority_t& a, const priority_t& b)
+  {
+    return a.value_ != b.value_;
+  }
+
+  struct convertible_from_priority_t
+  {
+    ASIO_CONSTEXPR convertible_from_priority_t(priority_t) {}
+  };
+
+  template <typename Executor>
+  friend ASIO_CONSTEXPR priority_t query(
+      const Executor& ex, convertible_from_priority_t,
+      typename enable_if<
+        can_query<const Executor&, normal_t>::value
+      >::type* = 0)
+#if !defined(__clang__) // Clang crashes if noexcept is used here.
+#if defined(ASIO_MSVC) // Visual C++ wants the type to be qualified.
+    ASIO_NOEXCEPT_IF((
+      is_nothrow_query<const Executor&, priority_t<>::normal_t>::value))
+#else // defined(ASIO_MSVC)
+    ASIO_NOEXCEPT_IF((
+      is_nothrow_query<const Executor&, normal_t>::value))
+#endif // defined(ASIO_MSVC)
+#endif // !defined(__clang__)
+  {
+    return asio::query(ex, normal_t());
+  }
+
+  template <typename Executor>
+  friend ASIO_CONSTEXPR priority_t query(
+      const Executor& ex, convertible_from_priority_t,
+      typename enable_if<
+        !can_query<const Executor&, normal_t>::value
+      >::type* = 0,
+      typename enable_if<
+        can_query<const Executor&, high_t>::value
+      >::type* = 0)
+#if !defined(__clang__) // Clang crashes if noexcept is used here.
+#if defined(ASIO_MSVC) // Visual C++ wants the type to be qualified.
+    ASIO_NOEXCEPT_IF((
+      is_nothrow_query<const Executor&, priority_t<>::high_t>::value))
+#else // defined(ASIO_MSVC)
+    ASIO_NOEXCEPT_IF((
+      is_nothrow_query<const Executor&, high_t>::value))
+#endif // defined(ASIO_MSVC)
+#endif // !defined(__clang__)
+  {
+    return asio::query(ex, high_t());
+  }
+
+  template <typename Executor>
+  friend ASIO_CONSTEXPR priority_t query(
+      const Executor& ex, convertible_from_priority_t,
+      typename enable_if<
+        !can_query<const Executor&, normal_t>::value
+      >::type* = 0,
+      typename enable_if<
+        !can_query<const Executor&, high_t>::value
+      >::type* = 0,
+      typename enable_if<
+        can_query<const Executor&, low_t>::value
+      >::type* = 0)
+#if !defined(__clang__) // Clang crashes if noexcept is used here.
+#if defined(ASIO_MSVC) // Visual C++ wants the type to be qualified.
+    ASIO_NOEXCEPT_IF((
+      is_nothrow_query<const Executor&, priority_t<>::low_t>::value))
+#else // defined(ASIO_MSVC)
+    ASIO_NOEXCEPT_IF((
+      is_nothrow_query<const Executor&, low_t>::value))
+#endif // defined(ASIO_MSVC)
+#endif // !defined(__clang__)
+  {
+    return asio::query(ex, low_t());
+  }
+
+  ASIO_STATIC_CONSTEXPR_DEFAULT_INIT(normal_t, normal);
+  ASIO_STATIC_CONSTEXPR_DEFAULT_INIT(high_t, high);
+  ASIO_STATIC_CONSTEXPR_DEFAULT_INIT(low_t, low);
+
+#if !defined(ASIO_HAS_CONSTEXPR)
+  static const priority_t instance;
+#endif // !defined(ASIO_HAS_CONSTEXPR)
+
+private:
+  int value_;
+};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T priority_t<I>::static_query_v;
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+#if !defined(ASIO_HAS_CONSTEXPR)
+template <int I>
+const priority_t<I> priority_t<I>::instance;
+#endif
+
+template <int I>
+const typename priority_t<I>::normal_t priority_t<I>::normal;
+
+template <int I>
+const typename priority_t<I>::high_t priority_t<I>::high;
+
+template <int I>
+const typename priority_t<I>::low_t priority_t<I>::low;
+
+namespace priority {
+
+template <int I = 0>
+struct normal_t
+{
+#if defined(ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  ASIO_STATIC_CONSTEXPR(bool,
+    is_applicable_property_v = (
+      is_executor<T>::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_sender<T>
+          >::type::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_scheduler<T>
+          >::type::value));
+#endif // defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+  ASIO_STATIC_CONSTEXPR(bool, is_requirable = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_preferable = true);
+  typedef priority_t<I> polymorphic_query_result_type;
+
+  ASIO_CONSTEXPR normal_t()
+  {
+  }
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<
+      typename priority_t<I>::template proxy<T>::type, normal_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename priority_t<I>::template static_proxy<T>::type, normal_t> {};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    ASIO_NOEXCEPT_IF((
+      query_static_constexpr_member<T>::is_noexcept))
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename T>
+  static ASIO_CONSTEXPR normal_t static_query(
+      typename enable_if<
+        !query_static_constexpr_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !query_member<T>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !traits::query_free<T, normal_t>::is_valid
+      >::type* = 0,
+      typename enable_if<
+        !can_query<T, high_t<I> >::value
+      >::type* = 0,
+      typename enable_if<
+        !can_query<T, low_t<I> >::value
+      >::type* = 0) ASIO_NOEXCEPT
+  {
+    return normal_t();
+  }
+
+  template <typename E, typename T = decltype(normal_t::static_query<E>())>
+  static ASIO_CONSTEXPR const T static_query_v
+    = normal_t::static_query<E>();
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  static ASIO_CONSTEXPR priority_t<I> value()
+  {
+    return normal_t();
+  }
+
+  friend ASIO_CONSTEXPR bool operator==(
+      const normal_t&, const normal_t&)
+  {
+    return true;
+  }
+
+  friend ASIO_CONSTEXPR bool operator!=(
+      const normal_t&, const normal_t&)
+  {
+    return false;
+  }
+};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T normal_t<I>::static_query_v;
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <int I = 0>
+struct high_t
+{
+#if defined(ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  ASIO_STATIC_CONSTEXPR(bool,
+    is_applicable_property_v = (
+      is_executor<T>::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_sender<T>
+          >::type::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_scheduler<T>
+          >::type::value));
+#endif // defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+  ASIO_STATIC_CONSTEXPR(bool, is_requirable = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_preferable = true);
+  typedef priority_t<I> polymorphic_query_result_type;
+
+  ASIO_CONSTEXPR high_t()
+  {
+  }
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<
+      typename priority_t<I>::template proxy<T>::type, high_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename priority_t<I>::template static_proxy<T>::type, high_t> {};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    ASIO_NOEXCEPT_IF((
+      query_static_constexpr_member<T>::is_noexcept))
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename E, typename T = decltype(high_t::static_query<E>())>
+  static ASIO_CONSTEXPR const T static_query_v
+    = high_t::static_query<E>();
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  static ASIO_CONSTEXPR priority_t<I> value()
+  {
+    return high_t();
+  }
+
+  friend ASIO_CONSTEXPR bool operator==(
+      const high_t&, const high_t&)
+  {
+    return true;
+  }
+
+  friend ASIO_CONSTEXPR bool operator!=(
+      const high_t&, const high_t&)
+  {
+    return false;
+  }
+};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T high_t<I>::static_query_v;
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <int I>
+struct low_t
+{
+#if defined(ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  ASIO_STATIC_CONSTEXPR(bool,
+    is_applicable_property_v = (
+      is_executor<T>::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_sender<T>
+          >::type::value
+        || conditional<
+            is_executor<T>::value,
+            false_type,
+            is_scheduler<T>
+          >::type::value));
+#endif // defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+  ASIO_STATIC_CONSTEXPR(bool, is_requirable = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_preferable = true);
+  typedef priority_t<I> polymorphic_query_result_type;
+
+  ASIO_CONSTEXPR low_t()
+  {
+  }
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<
+      typename priority_t<I>::template proxy<T>::type, low_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename priority_t<I>::template static_proxy<T>::type, low_t> {};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static ASIO_CONSTEXPR
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    ASIO_NOEXCEPT_IF((
+      query_static_constexpr_member<T>::is_noexcept))
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename E, typename T = decltype(low_t::static_query<E>())>
+  static ASIO_CONSTEXPR const T static_query_v
+    = low_t::static_query<E>();
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  static ASIO_CONSTEXPR priority_t<I> value()
+  {
+    return low_t();
+  }
+
+  friend ASIO_CONSTEXPR bool operator==(
+      const low_t&, const low_t&)
+  {
+    return true;
+  }
+
+  friend ASIO_CONSTEXPR bool operator!=(
+      const low_t&, const low_t&)
+  {
+    return false;
+  }
+};
+
+#if defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T low_t<I>::static_query_v;
+#endif // defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+} // namespace priority
+} // namespace detail
+
+typedef detail::priority_t<> priority_t;
+
+#if defined(ASIO_HAS_CONSTEXPR) || defined(GENERATING_DOCUMENTATION)
+constexpr priority_t priority;
+#else // defined(ASIO_HAS_CONSTEXPR) || defined(GENERATING_DOCUMENTATION)
+namespace { static const priority_t& priority = priority_t::instance; }
+#endif
+
+} // namespace execution
+
+#if !defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t>
+  : integral_constant<bool,
+      execution::is_executor<T>::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_sender<T>
+          >::type::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_scheduler<T>
+          >::type::value>
+{
+};
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t::normal_t>
+  : integral_constant<bool,
+      execution::is_executor<T>::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_sender<T>
+          >::type::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_scheduler<T>
+          >::type::value>
+{
+};
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t::high_t>
+  : integral_constant<bool,
+      execution::is_executor<T>::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_sender<T>
+          >::type::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_scheduler<T>
+          >::type::value>
+{
+};
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t::low_t>
+  : integral_constant<bool,
+      execution::is_executor<T>::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_sender<T>
+          >::type::value
+        || conditional<
+            execution::is_executor<T>::value,
+            false_type,
+            execution::is_scheduler<T>
+          >::type::value>
+{
+};
+
+#endif // !defined(ASIO_HAS_VARIABLE_TEMPLATES)
+
+namespace traits {
+
+#if !defined(ASIO_HAS_DEDUCED_QUERY_FREE_TRAIT)
+
+template <typename T>
+struct query_free_default<T, execution::priority_t,
+  typename enable_if<
+    can_query<T, execution::priority_t::normal_t>::value
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept =
+    (is_nothrow_query<T, execution::priority_t::normal_t>::value));
+
+  typedef execution::priority_t result_type;
+};
+
+template <typename T>
+struct query_free_default<T, execution::priority_t,
+  typename enable_if<
+    !can_query<T, execution::priority_t::normal_t>::value
+      && can_query<T, execution::priority_t::high_t>::value
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept =
+    (is_nothrow_query<T, execution::priority_t::high_t>::value));
+
+  typedef execution::priority_t result_type;
+};
+
+template <typename T>
+struct query_free_default<T, execution::priority_t,
+  typename enable_if<
+    !can_query<T, execution::priority_t::normal_t>::value
+      && !can_query<T, execution::priority_t::high_t>::value
+      && can_query<T, execution::priority_t::low_t>::value
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept =
+    (is_nothrow_query<T, execution::priority_t::low_t>::value));
+
+  typedef execution::priority_t result_type;
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_QUERY_FREE_TRAIT)
+
+#if !defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  || !defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  typename enable_if<
+    execution::detail::priority_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename execution::detail::priority_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return execution::detail::priority_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  typename enable_if<
+    !execution::detail::priority_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority_t<0>::
+        query_member<T>::is_valid
+      && traits::static_query<T, execution::priority_t::normal_t>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename traits::static_query<T,
+    execution::priority_t::normal_t>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return traits::static_query<T, execution::priority_t::normal_t>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  typename enable_if<
+    !execution::detail::priority_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority_t<0>::
+        query_member<T>::is_valid
+      && !traits::static_query<T, execution::priority_t::normal_t>::is_valid
+      && traits::static_query<T, execution::priority_t::high_t>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename traits::static_query<T,
+    execution::priority_t::high_t>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return traits::static_query<T, execution::priority_t::high_t>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  typename enable_if<
+    !execution::detail::priority_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority_t<0>::
+        query_member<T>::is_valid
+      && !traits::static_query<T, execution::priority_t::normal_t>::is_valid
+      && !traits::static_query<T, execution::priority_t::high_t>::is_valid
+      && traits::static_query<T, execution::priority_t::low_t>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename traits::static_query<T,
+    execution::priority_t::low_t>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return traits::static_query<T, execution::priority_t::low_t>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::normal_t,
+  typename enable_if<
+    execution::detail::priority::normal_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename execution::detail::priority::normal_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return execution::detail::priority::normal_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::normal_t,
+  typename enable_if<
+    !execution::detail::priority::normal_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority::normal_t<0>::
+        query_member<T>::is_valid
+      && !traits::query_free<T, execution::priority_t::normal_t>::is_valid
+      && !can_query<T, execution::priority_t::high_t>::value
+      && !can_query<T, execution::priority_t::low_t>::value
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef execution::priority_t::normal_t result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return result_type();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::high_t,
+  typename enable_if<
+    execution::detail::priority::high_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename execution::detail::priority::high_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return execution::detail::priority::high_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::low_t,
+  typename enable_if<
+    execution::detail::priority::low_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+
+  typedef typename execution::detail::priority::low_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static ASIO_CONSTEXPR result_type value()
+  {
+    return execution::detail::priority::low_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   || !defined(ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+#if !defined(ASIO_HAS_DEDUCED_STATIC_REQUIRE_TRAIT)
+
+template <typename T>
+struct static_require<T, execution::priority_t::normal_t,
+  typename enable_if<
+    static_query<T, execution::priority_t::normal_t>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid =
+    (is_same<typename static_query<T,
+      execution::priority_t::normal_t>::result_type,
+        execution::priority_t::normal_t>::value));
+};
+
+template <typename T>
+struct static_require<T, execution::priority_t::high_t,
+  typename enable_if<
+    static_query<T, execution::priority_t::high_t>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid =
+    (is_same<typename static_query<T,
+      execution::priority_t::high_t>::result_type,
+        execution::priority_t::high_t>::value));
+};
+
+template <typename T>
+struct static_require<T, execution::priority_t::low_t,
+  typename enable_if<
+    static_query<T, execution::priority_t::low_t>::is_valid
+  >::type>
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid =
+    (is_same<typename static_query<T,
+      execution::priority_t::low_t>::result_type,
+        execution::priority_t::low_t>::value));
+};
+
+#endif // !defined(ASIO_HAS_DEDUCED_STATIC_REQUIRE_TRAIT)
+
+} // namespace traits
+
+#endif // defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_EXECUTION_PRIORITY_HPP
@@ -15,11 +15,13 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <iterator>
 #include "asio/detail/completion_handler.hpp"
 #include "asio/detail/executor_op.hpp"
 #include "asio/detail/fenced_block.hpp"
 #include "asio/detail/handler_type_requirements.hpp"
 #include "asio/detail/non_const_lvalue.hpp"
+#include "asio/detail/operation_priority.hpp"
 #include "asio/detail/service_registry.hpp"
 #include "asio/detail/throw_error.hpp"
 #include "asio/detail/type_traits.hpp"
@@ -55,6 +57,17 @@ io_context::get_executor() ASIO_NOEXCEPT
   return executor_type(*this);
 }
 
+inline io_context::thread_executor_type
+io_context::get_thread_executor(std::size_t index) ASIO_NOEXCEPT
+{
+  return thread_executor_type(*this, index);
+}
+
+inline std::size_t io_context::this_thread_index() ASIO_NOEXCEPT
+{
+  return impl_.this_thread_index();
+}
+
 #if defined(ASIO_HAS_CHRONO)
 
 template <typename Rep, typename Period>
@@ -108,6 +121,38 @@ std::size_t io_context::run_one_until(
   return 0;
 }
 
+#if !defined(ASIO_HAS_IOCP)
+
+template <typename Rep, typename Period>
+void io_context::set_busy_poll_duration(
+    const chrono::duration<Rep, Period>& max_spin)
+{
+  impl_.set_busy_poll_usec(static_cast<long>(
+        chrono::duration_cast<chrono::microseconds>(max_spin).count()));
+}
+
+template <typename Rep, typename Period>
+void io_context::set_poll_time_limit(
+    const chrono::duration<Rep, Period>& max_time)
+{
+  impl_.set_poll_time_limit_usec(static_cast<long>(
+        chrono::duration_cast<chrono::microseconds>(max_time).count()));
+}
+
+#endif // !defined(ASIO_HAS_IOCP)
+
+#if defined(ASIO_HAS_IO_URING)
+
+template <typename Rep, typename Period>
+void io_context::set_io_uring_sqpoll(
+    const chrono::duration<Rep, Period>& idle_time, int cpu)
+{
+  impl_.set_io_uring_sqpoll(static_cast<long>(
+        chrono::duration_cast<chrono::milliseconds>(idle_time).count()), cpu);
+}
+
+#endif // defined(ASIO_HAS_IO_URING)
+
 #endif // defined(ASIO_HAS_CHRONO)
 
 #if !defined(ASIO_NO_DEPRECATED)
@@ -221,6 +266,7 @@ io_context::basic_executor_type<Allocator, Bits>::operator=(
   if (this != &other)
   {
     static_cast<Allocator&>(*this) = static_cast<const Allocator&>(other);
+    static_cast<thread_target_base&>(*this) = other;
     io_context* old_io_context = context_ptr();
     target_ = other.target_;
     if (Bits & outstanding_work_tracked)
@@ -243,6 +289,7 @@ io_context::basic_executor_type<Allocator, Bits>::operator=(
   if (this != &other)
   {
     static_cast<Allocator&>(*this) = static_cast<Allocator&&>(other);
+    static_cast<thread_target_base&>(*this) = other;
     io_context* old_io_context = context_ptr();
     target_ = other.target_;
     if (Bits & outstanding_work_tracked)
@@ -260,7 +307,7 @@ template <typename Allocator, uintptr_t Bits>
 inline bool io_context::basic_executor_type<Allocator,
     Bits>::running_in_this_thread() const ASIO_NOEXCEPT
 {
-  return context_ptr()->impl_.can_dispatch();
+  return can_dispatch();
 }
 
 template <typename Allocator, uintptr_t Bits>
@@ -271,8 +318,8 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
   typedef typename decay<Function>::type function_type;
 
   // Invoke immediately if the blocking.possibly property is enabled and we are
-  // already inside the thread pool.
-  if ((bits() & blocking_never) == 0 && context_ptr()->impl_.can_dispatch())
+  // already inside the thread pool, or on the target thread.
+  if ((bits() & blocking_never) == 0 && can_dispatch())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(ASIO_MOVE_CAST(Function)(f));
@@ -305,15 +352,62 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
       op::ptr::allocate(static_cast<const Allocator&>(*this)), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f),
       static_cast<const Allocator&>(*this));
+  if (Bits & priority_bits)
+    detail::set_operation_priority(*p.p, *this);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "execute"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p,
-      (bits() & relationship_continuation) != 0);
+  post_operation(p.p, (bits() & relationship_continuation) != 0);
   p.v = p.p = 0;
 }
 
+template <typename Allocator, uintptr_t Bits>
+template <typename InputIterator>
+void io_context::basic_executor_type<Allocator, Bits>::post_batch(
+    InputIterator first, InputIterator last) const
+{
+  typedef typename decay<
+      typename std::iterator_traits<InputIterator>::value_type>::type
+        function_type;
+
+  // Allocate and construct an operation to wrap each function. If an exception
+  // is thrown, the operations that have already been constructed are destroyed
+  // with the queue.
+  typedef detail::executor_op<function_type, Allocator, detail::operation> op;
+  detail::op_queue<detail::operation> ops;
+  std::size_t n = 0;
+  for (; first != last; ++first, ++n)
+  {
+    typename op::ptr p = {
+        detail::addressof(static_cast<const Allocator&>(*this)),
+        op::ptr::allocate(static_cast<const Allocator&>(*this)), 0 };
+    p.p = new (p.v) op(*first, static_cast<const Allocator&>(*this));
+    if (Bits & priority_bits)
+      detail::set_operation_priority(*p.p, *this);
+
+    ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
+          "io_context", context_ptr(), 0, "post_batch"));
+
+    ops.push(p.p);
+    p.v = p.p = 0;
+  }
+
+  if (Bits & thread_targeted)
+  {
+    while (detail::operation* o = ops.front())
+    {
+      ops.pop();
+      post_operation(o, false);
+    }
+  }
+  else if (n > 0)
+  {
+    context_ptr()->impl_.post_immediate_completions(n, ops,
+        (bits() & relationship_continuation) != 0);
+  }
+}
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 template <typename Allocator, uintptr_t Bits>
 inline io_context& io_context::basic_executor_type<
@@ -343,8 +437,9 @@ void io_context::basic_executor_type<Allocator, Bits>::dispatch(
 {
   typedef typename decay<Function>::type function_type;
 
-  // Invoke immediately if we are already inside the thread pool.
-  if (context_ptr()->impl_.can_dispatch())
+  // Invoke immediately if we are already inside the thread pool, or on the
+  // target thread.
+  if (can_dispatch())
   {
     // Make a local, non-const copy of the function.
     function_type tmp(ASIO_MOVE_CAST(Function)(f));
@@ -359,11 +454,13 @@ void io_context::basic_executor_type<Allocator, Bits>::dispatch(
       OtherAllocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), a);
+  if (Bits & priority_bits)
+    detail::set_operation_priority(*p.p, *this);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "dispatch"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, false);
+  post_operation(p.p, false);
   p.v = p.p = 0;
 }
 
@@ -379,11 +476,13 @@ void io_context::basic_executor_type<Allocator, Bits>::post(
       OtherAllocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), a);
+  if (Bits & priority_bits)
+    detail::set_operation_priority(*p.p, *this);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "post"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, false);
+  post_operation(p.p, false);
   p.v = p.p = 0;
 }
 
@@ -399,11 +498,13 @@ void io_context::basic_executor_type<Allocator, Bits>::defer(
       OtherAllocator, detail::operation> op;
   typename op::ptr p = { detail::addressof(a), op::ptr::allocate(a), 0 };
   p.p = new (p.v) op(ASIO_MOVE_CAST(Function)(f), a);
+  if (Bits & priority_bits)
+    detail::set_operation_priority(*p.p, *this);
 
   ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "defer"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, true);
+  post_operation(p.p, true);
   p.v = p.p = 0;
 }
 #endif // !defined(ASIO_NO_TS_EXECUTORS)
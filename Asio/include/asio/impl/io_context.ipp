@@ -19,6 +19,7 @@
 #include "asio/io_context.hpp"
 #include "asio/detail/concurrency_hint.hpp"
 #include "asio/detail/limits.hpp"
+#include "asio/detail/reactor.hpp"
 #include "asio/detail/scoped_ptr.hpp"
 #include "asio/detail/service_registry.hpp"
 #include "asio/detail/throw_error.hpp"
@@ -131,6 +132,97 @@ void io_context::restart()
   impl_.restart();
 }
 
+#if !defined(ASIO_HAS_IOCP)
+io_context::count_type io_context::busy_poll_hits() const
+{
+  return impl_.busy_poll_hits();
+}
+
+io_context::count_type io_context::busy_poll_misses() const
+{
+  return impl_.busy_poll_misses();
+}
+
+void io_context::set_poll_handler_limit(count_type max_handlers)
+{
+  impl_.set_poll_handler_limit(max_handlers);
+}
+
+io_context::count_type io_context::handler_limit_polls() const
+{
+  return impl_.handler_limit_polls();
+}
+
+io_context::count_type io_context::time_limit_polls() const
+{
+  return impl_.time_limit_polls();
+}
+#endif // !defined(ASIO_HAS_IOCP)
+
+#if defined(ASIO_HAS_IO_URING)
+void io_context::set_io_uring_ring_size(std::size_t entries)
+{
+  impl_.set_io_uring_ring_size(entries);
+}
+#endif // defined(ASIO_HAS_IO_URING)
+
+#if defined(ASIO_HAS_EPOLL) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+io_context::count_type io_context::reactor_waits() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).waits() : 0;
+}
+
+io_context::count_type io_context::reactor_empty_waits() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).empty_waits() : 0;
+}
+
+io_context::count_type io_context::reactor_full_waits() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).full_waits() : 0;
+}
+
+io_context::count_type io_context::reactor_events() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).events() : 0;
+}
+
+uint64_t io_context::reactor_wait_usec() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).wait_usec() : 0;
+}
+
+io_context::count_type io_context::reactor_dispatch_samples() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).dispatch_samples() : 0;
+}
+
+uint64_t io_context::reactor_dispatch_delay_usec() const
+{
+  io_context& ctx = const_cast<io_context&>(*this);
+  return has_service<detail::epoll_reactor>(ctx)
+    ? use_service<detail::epoll_reactor>(ctx).dispatch_delay_usec() : 0;
+}
+#endif // defined(ASIO_HAS_EPOLL)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
 io_context::service::service(asio::io_context& owner)
   : execution_context::service(owner)
 {
@@ -0,0 +1,237 @@
+//
+// impl/io_context_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IMPL_IO_CONTEXT_POOL_IPP
+#define ASIO_IMPL_IO_CONTEXT_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <exception>
+#include <stdexcept>
+#include "asio/io_context_pool.hpp"
+#include "asio/detail/throw_exception.hpp"
+
+#if defined(ASIO_HAS_PTHREADS) && defined(__linux__)
+# include <pthread.h>
+# include <sched.h>
+#elif defined(ASIO_WINDOWS) && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+# include "asio/detail/socket_types.hpp"
+#endif
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+// Bind the calling thread to a single CPU, if supported.
+inline void bind_current_thread_to_cpu(std::size_t cpu)
+{
+#if defined(ASIO_HAS_PTHREADS) && defined(__linux__) && defined(CPU_SETSIZE)
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu % CPU_SETSIZE, &cpus);
+  ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus);
+#elif defined(ASIO_WINDOWS) && !defined(ASIO_WINDOWS_APP) \
+  && !defined(UNDER_CE)
+  ::SetThreadAffinityMask(::GetCurrentThread(),
+      static_cast<DWORD_PTR>(1) << (cpu % (sizeof(DWORD_PTR) * 8)));
+#else
+  (void)cpu;
+#endif
+}
+
+} // namespace detail
+
+struct io_context_pool::shard
+{
+  explicit shard(int concurrency_hint)
+    : io_context_(concurrency_hint),
+      impl_(asio::use_service<detail::io_context_impl>(io_context_)),
+      work_(io_context_.get_executor()),
+      selections_(0)
+  {
+  }
+
+  io_context io_context_;
+  detail::io_context_impl& impl_;
+  executor_work_guard<executor_type> work_;
+  detail::atomic_count selections_;
+};
+
+struct io_context_pool::thread_function
+{
+  io_context* io_context_;
+  std::size_t cpu_;
+  bool pin_;
+
+  void operator()()
+  {
+    if (pin_)
+      detail::bind_current_thread_to_cpu(cpu_);
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+      io_context_->run();
+#if !defined(ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+  }
+};
+
+io_context_pool::io_context_pool(std::size_t pool_size,
+    bool pin_threads, int concurrency_hint)
+  : next_(0)
+{
+  if (pool_size == 0)
+  {
+    std::out_of_range ex("io_context_pool size");
+    asio::detail::throw_exception(ex);
+  }
+
+  std::size_t num_cpus = detail::thread::hardware_concurrency();
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  try
+  {
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+    shards_.reserve(pool_size);
+    for (std::size_t i = 0; i < pool_size; ++i)
+      shards_.push_back(new shard(concurrency_hint));
+
+    for (std::size_t i = 0; i < pool_size; ++i)
+    {
+      thread_function f = { &shards_[i]->io_context_,
+        num_cpus > 0 ? i % num_cpus : 0, pin_threads && num_cpus > 0 };
+      threads_.create_thread(f);
+    }
+#if !defined(ASIO_NO_EXCEPTIONS)
+  }
+  catch (...)
+  {
+    stop();
+    join();
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+      delete shards_[i];
+    throw;
+  }
+#endif// !defined(ASIO_NO_EXCEPTIONS)
+}
+
+io_context_pool::~io_context_pool()
+{
+  stop();
+  join();
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+    delete shards_[i];
+}
+
+io_context& io_context_pool::get_io_context(selection s)
+{
+  return shards_[choose(s)]->io_context_;
+}
+
+io_context& io_context_pool::get_io_context_at(std::size_t index)
+{
+  if (index >= shards_.size())
+  {
+    std::out_of_range ex("io_context_pool index");
+    asio::detail::throw_exception(ex);
+  }
+
+  return shards_[index]->io_context_;
+}
+
+io_context_pool::executor_type io_context_pool::get_executor(selection s)
+{
+  return shards_[choose(s)]->io_context_.get_executor();
+}
+
+std::size_t io_context_pool::load(std::size_t index) const
+{
+  if (index >= shards_.size())
+  {
+    std::out_of_range ex("io_context_pool index");
+    asio::detail::throw_exception(ex);
+  }
+
+  // Discount the work that keeps the io_context running until join().
+  const shard* s = shards_[index];
+  std::size_t work = s->impl_.outstanding_work();
+  return s->work_.owns_work() && work > 0 ? work - 1 : work;
+}
+
+std::size_t io_context_pool::selections(std::size_t index) const
+{
+  if (index >= shards_.size())
+  {
+    std::out_of_range ex("io_context_pool index");
+    asio::detail::throw_exception(ex);
+  }
+
+  return static_cast<std::size_t>(
+      static_cast<long>(shards_[index]->selections_));
+}
+
+void io_context_pool::stop()
+{
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+    shards_[i]->io_context_.stop();
+}
+
+void io_context_pool::join()
+{
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+    shards_[i]->work_.reset();
+  threads_.join();
+}
+
+std::size_t io_context_pool::choose(selection s)
+{
+  std::size_t n = shards_.size();
+  std::size_t start = static_cast<std::size_t>(
+      static_cast<unsigned long>(++next_ - 1)) % n;
+
+  std::size_t index = start;
+  if (s == least_loaded)
+  {
+    // Start the search at the round-robin position, so that ties are broken
+    // by spreading work over the pool.
+    std::size_t min_load = load(start);
+    for (std::size_t i = 1; i < n && min_load > 0; ++i)
+    {
+      std::size_t candidate = (start + i) % n;
+      std::size_t candidate_load = load(candidate);
+      if (candidate_load < min_load)
+      {
+        index = candidate;
+        min_load = candidate_load;
+      }
+    }
+  }
+
+  ++shards_[index]->selections_;
+  return index;
+}
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // ASIO_IMPL_IO_CONTEXT_POOL_IPP
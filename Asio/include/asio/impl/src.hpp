@@ -28,6 +28,7 @@
 #include "asio/impl/executor.ipp"
 #include "asio/impl/handler_alloc_hook.ipp"
 #include "asio/impl/io_context.ipp"
+#include "asio/impl/io_context_pool.ipp"
 #include "asio/impl/multiple_exceptions.ipp"
 #include "asio/impl/serial_port_base.ipp"
 #include "asio/impl/system_context.ipp"
@@ -38,6 +39,9 @@
 #include "asio/detail/impl/epoll_reactor.ipp"
 #include "asio/detail/impl/eventfd_select_interrupter.ipp"
 #include "asio/detail/impl/handler_tracking.ipp"
+#include "asio/detail/impl/handler_watchdog.ipp"
+#include "asio/detail/impl/io_backend_selector.ipp"
+#include "asio/detail/impl/io_uring_buffer_ring.ipp"
 #include "asio/detail/impl/io_uring_descriptor_service.ipp"
 #include "asio/detail/impl/io_uring_file_service.ipp"
 #include "asio/detail/impl/io_uring_socket_service_base.ipp"
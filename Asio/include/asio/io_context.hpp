@@ -61,8 +61,46 @@ namespace detail {
     ASIO_STATIC_CONSTEXPR(uintptr_t, blocking_never = 1);
     ASIO_STATIC_CONSTEXPR(uintptr_t, relationship_continuation = 2);
     ASIO_STATIC_CONSTEXPR(uintptr_t, outstanding_work_tracked = 4);
+    ASIO_STATIC_CONSTEXPR(uintptr_t, priority_high = 8);
+    ASIO_STATIC_CONSTEXPR(uintptr_t, priority_low = 16);
+    ASIO_STATIC_CONSTEXPR(uintptr_t, priority_bits = 24);
+    ASIO_STATIC_CONSTEXPR(uintptr_t, thread_targeted = 32);
     ASIO_STATIC_CONSTEXPR(uintptr_t, runtime_bits = 3);
   };
+
+  // Holds the index of the thread that an executor submits functions to. The
+  // index is stored only by executors that have the thread_targeted bit.
+  template <bool Targeted>
+  class io_context_thread_target
+  {
+  protected:
+    explicit io_context_thread_target(std::size_t) ASIO_NOEXCEPT
+    {
+    }
+
+    std::size_t target_thread() const ASIO_NOEXCEPT
+    {
+      return ~static_cast<std::size_t>(0);
+    }
+  };
+
+  template <>
+  class io_context_thread_target<true>
+  {
+  protected:
+    explicit io_context_thread_target(std::size_t index) ASIO_NOEXCEPT
+      : target_thread_(index)
+    {
+    }
+
+    std::size_t target_thread() const ASIO_NOEXCEPT
+    {
+      return target_thread_;
+    }
+
+  private:
+    std::size_t target_thread_;
+  };
 } // namespace detail
 
 /// Provides core I/O functionality.
@@ -230,6 +268,11 @@ public:
   /// Executor used to submit functions to an io_context.
   typedef basic_executor_type<std::allocator<void>, 0> executor_type;
 
+  /// Executor used to submit functions to a particular thread of an
+  /// io_context.
+  typedef basic_executor_type<std::allocator<void>,
+      detail::io_context_bits::thread_targeted> thread_executor_type;
+
 #if !defined(ASIO_NO_DEPRECATED)
   class work;
   friend class work;
@@ -295,6 +338,36 @@ public:
   /// Obtains the executor associated with the io_context.
   executor_type get_executor() ASIO_NOEXCEPT;
 
+  /// Obtains an executor that submits functions to one thread of the
+  /// io_context.
+  /**
+   * When the io_context is constructed with the
+   * ASIO_CONCURRENCY_HINT_THREAD_TARGETING hint, each thread that calls run()
+   * is given an index, which is the smallest not in use by another thread
+   * inside run(). Functions submitted through the returned executor are run
+   * only by the thread with the given index, ahead of other handlers. This
+   * keeps related handlers on a single thread without the cost of a strand.
+   * If no thread inside run() has the index, as is always the case without the
+   * hint, any thread may run the functions.
+   *
+   * Handlers for asynchronous operations whose associated executor is a thread
+   * executor are first completed by any thread, and then submitted to the
+   * target thread.
+   *
+   * @param index The index of the thread, as returned by this_thread_index()
+   * when called from that thread.
+   */
+  thread_executor_type get_thread_executor(std::size_t index) ASIO_NOEXCEPT;
+
+  /// Get the index of the calling thread among the threads inside run().
+  /**
+   * @returns The index of the calling thread, or <tt>~std::size_t(0)</tt> if
+   * the calling thread is not inside run(), or if threads are not given
+   * indexes. The index of a thread does not change until it returns from
+   * run().
+   */
+  std::size_t this_thread_index() ASIO_NOEXCEPT;
+
   /// Run the io_context object's event processing loop.
   /**
    * The run() function blocks until all work has finished and there are no
@@ -538,6 +611,161 @@ public:
    */
   ASIO_DECL void restart();
 
+#if (defined(ASIO_HAS_CHRONO) && !defined(ASIO_HAS_IOCP)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Set the longest time that an idle thread will spin before blocking.
+  /**
+   * This function limits the time for which a thread that has run out of
+   * handlers keeps polling for more work, when the io_context was constructed
+   * with the ASIO_CONCURRENCY_HINT_BUSY_POLL concurrency hint. Within this
+   * limit, the time spent spinning adapts to recent idle periods. A duration of
+   * zero disables spinning. The default is given by ASIO_BUSY_POLL_USEC.
+   *
+   * @param max_spin The longest time for which an idle thread may spin.
+   */
+  template <typename Rep, typename Period>
+  void set_busy_poll_duration(const chrono::duration<Rep, Period>& max_spin);
+#endif // (defined(ASIO_HAS_CHRONO) && !defined(ASIO_HAS_IOCP))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if !defined(ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+  /// Get the number of times an idle thread found work while spinning.
+  /**
+   * This count is only incremented when the io_context was constructed with
+   * the ASIO_CONCURRENCY_HINT_BUSY_POLL concurrency hint.
+   */
+  ASIO_DECL count_type busy_poll_hits() const;
+
+  /// Get the number of times an idle thread stopped spinning and blocked.
+  /**
+   * This count is only incremented when the io_context was constructed with
+   * the ASIO_CONCURRENCY_HINT_BUSY_POLL concurrency hint.
+   */
+  ASIO_DECL count_type busy_poll_misses() const;
+
+  /// Set the largest number of handlers that may run between reactor polls.
+  /**
+   * When a stream of handlers keeps the io_context busy, the reactor is only
+   * polled for new I/O readiness once the handlers ahead of it in the queue
+   * have run. This function limits the number of handlers that may run before
+   * a non-blocking reactor poll is forced. A value of zero means no limit. The
+   * default is given by ASIO_POLL_HANDLER_LIMIT.
+   *
+   * @param max_handlers The largest number of handlers that may run between
+   * reactor polls.
+   */
+  ASIO_DECL void set_poll_handler_limit(count_type max_handlers);
+
+  /// Get the number of reactor polls forced by the handler limit.
+  ASIO_DECL count_type handler_limit_polls() const;
+
+  /// Get the number of reactor polls forced by the time limit.
+  ASIO_DECL count_type time_limit_polls() const;
+#endif // !defined(ASIO_HAS_IOCP) || defined(GENERATING_DOCUMENTATION)
+
+#if (defined(ASIO_HAS_EPOLL) \
+    && !defined(ASIO_HAS_IOCP) \
+    && !defined(ASIO_WINDOWS_RUNTIME) \
+    && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Get the number of times the reactor has waited for I/O readiness.
+  /**
+   * The reactor collects up to a batch of ready events in each wait. The batch
+   * grows when a wait fills it, up to ASIO_EPOLL_MAX_EVENTS, and shrinks when
+   * waits leave most of it unused. Together with reactor_events() and the
+   * other reactor counters, this shows how busy the reactor is. The waits of
+   * a sharded reactor's shards are included.
+   *
+   * The reactor counters are kept only for an io_context constructed with a
+   * concurrency hint that includes ASIO_CONCURRENCY_HINT_REACTOR_STATISTICS.
+   * Otherwise, or if no I/O object has used the reactor, they are all zero.
+   */
+  ASIO_DECL count_type reactor_waits() const;
+
+  /// Get the number of reactor waits that found no ready events.
+  ASIO_DECL count_type reactor_empty_waits() const;
+
+  /// Get the number of reactor waits that filled the event batch.
+  ASIO_DECL count_type reactor_full_waits() const;
+
+  /// Get the total number of ready events found by the reactor's waits.
+  ASIO_DECL count_type reactor_events() const;
+
+  /// Get the total time, in microseconds, spent in the reactor's waits.
+  ASIO_DECL uint64_t reactor_wait_usec() const;
+
+  /// Get the number of ready descriptors whose dispatch delay was measured.
+  /**
+   * The last descriptor found ready by each reactor wait is measured, from
+   * the end of the wait until a thread starts to perform its operations.
+   */
+  ASIO_DECL count_type reactor_dispatch_samples() const;
+
+  /// Get the total dispatch delay, in microseconds, of the measured
+  /// descriptors.
+  ASIO_DECL uint64_t reactor_dispatch_delay_usec() const;
+#endif // (defined(ASIO_HAS_EPOLL)
+       //     && !defined(ASIO_HAS_IOCP)
+       //     && !defined(ASIO_WINDOWS_RUNTIME)
+       //     && !defined(ASIO_HAS_IO_URING_AS_DEFAULT))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if (defined(ASIO_HAS_CHRONO) && !defined(ASIO_HAS_IOCP)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Set the longest time that handlers may run between reactor polls.
+  /**
+   * This function limits the time for which handlers may run before a
+   * non-blocking reactor poll is forced. The limit is checked before each
+   * handler is taken from the shared queue, so a single long-running handler
+   * may exceed it. A duration of zero means no limit. The default, in
+   * microseconds, is given by ASIO_POLL_TIME_LIMIT_USEC.
+   *
+   * @param max_time The longest time that handlers may run between reactor
+   * polls.
+   */
+  template <typename Rep, typename Period>
+  void set_poll_time_limit(const chrono::duration<Rep, Period>& max_time);
+#endif // (defined(ASIO_HAS_CHRONO) && !defined(ASIO_HAS_IOCP))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if (defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_IO_URING)) \
+  || defined(GENERATING_DOCUMENTATION)
+  /// Configure the kernel thread that polls the io_uring submission queue.
+  /**
+   * The polling thread is only used when the io_context was constructed with
+   * the ASIO_CONCURRENCY_HINT_IO_URING_SQPOLL concurrency hint. The settings
+   * apply to the io_uring instance that the io_context creates when an I/O
+   * object first uses io_uring, so this function must be called before any
+   * such I/O objects are created. It has no effect afterwards.
+   *
+   * @param idle_time How long the thread keeps polling after the last
+   * submission, before it sleeps. The default, in milliseconds, is given by
+   * ASIO_IO_URING_SQPOLL_IDLE_MSEC.
+   *
+   * @param cpu The CPU to which the thread is bound, or -1 to leave it
+   * unbound.
+   */
+  template <typename Rep, typename Period>
+  void set_io_uring_sqpoll(const chrono::duration<Rep, Period>& idle_time,
+      int cpu = -1);
+#endif // (defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_IO_URING))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#if defined(ASIO_HAS_IO_URING) || defined(GENERATING_DOCUMENTATION)
+  /// Set the number of submission queue entries in each io_uring instance.
+  /**
+   * The size applies to the io_uring instance that the io_context creates when
+   * an I/O object first uses io_uring, and to each per-thread instance created
+   * when the io_context was constructed with the
+   * ASIO_CONCURRENCY_HINT_SHARDED_IO_URING concurrency hint. It has no effect
+   * on instances that have already been created. The kernel rounds the size
+   * up to a power of two. The default is given by ASIO_IO_URING_RING_SIZE.
+   *
+   * @param entries The number of submission queue entries.
+   */
+  ASIO_DECL void set_io_uring_ring_size(std::size_t entries);
+#endif // defined(ASIO_HAS_IO_URING) || defined(GENERATING_DOCUMENTATION)
+
 #if !defined(ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
@@ -672,13 +900,19 @@ namespace detail {
 /// Executor implementation type used to submit functions to an io_context.
 template <typename Allocator, uintptr_t Bits>
 class io_context::basic_executor_type :
-  detail::io_context_bits, Allocator
+  detail::io_context_bits, Allocator,
+  detail::io_context_thread_target<
+    (Bits & detail::io_context_bits::thread_targeted) != 0>
 {
+  typedef detail::io_context_thread_target<
+    (Bits & detail::io_context_bits::thread_targeted) != 0> thread_target_base;
+
 public:
   /// Copy constructor.
   basic_executor_type(
       const basic_executor_type& other) ASIO_NOEXCEPT
     : Allocator(static_cast<const Allocator&>(other)),
+      thread_target_base(other),
       target_(other.target_)
   {
     if (Bits & outstanding_work_tracked)
@@ -690,6 +924,7 @@ public:
   /// Move constructor.
   basic_executor_type(basic_executor_type&& other) ASIO_NOEXCEPT
     : Allocator(ASIO_MOVE_CAST(Allocator)(other)),
+      thread_target_base(other),
       target_(other.target_)
   {
     if (Bits & outstanding_work_tracked)
@@ -735,7 +970,8 @@ private:
       execution::blocking_t::possibly_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() & ~blocking_never);
+        *this, bits() & ~blocking_never,
+        this->target_thread());
   }
 
   /// Obtain an executor with the @c blocking.never property.
@@ -752,7 +988,8 @@ private:
       execution::blocking_t::never_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() | blocking_never);
+        *this, bits() | blocking_never,
+        this->target_thread());
   }
 
   /// Obtain an executor with the @c relationship.fork property.
@@ -769,7 +1006,8 @@ private:
       execution::relationship_t::fork_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() & ~relationship_continuation);
+        *this, bits() & ~relationship_continuation,
+        this->target_thread());
   }
 
   /// Obtain an executor with the @c relationship.continuation property.
@@ -786,7 +1024,8 @@ private:
       execution::relationship_t::continuation_t) const
   {
     return basic_executor_type(context_ptr(),
-        *this, bits() | relationship_continuation);
+        *this, bits() | relationship_continuation,
+        this->target_thread());
   }
 
   /// Obtain an executor with the @c outstanding_work.tracked property.
@@ -804,7 +1043,8 @@ private:
   require(execution::outstanding_work_t::tracked_t) const
   {
     return basic_executor_type<Allocator, Bits | outstanding_work_tracked>(
-        context_ptr(), *this, bits());
+        context_ptr(), *this, bits(),
+        this->target_thread());
   }
 
   /// Obtain an executor with the @c outstanding_work.untracked property.
@@ -822,7 +1062,73 @@ private:
   require(execution::outstanding_work_t::untracked_t) const
   {
     return basic_executor_type<Allocator, Bits & ~outstanding_work_tracked>(
-        context_ptr(), *this, bits());
+        context_ptr(), *this, bits(),
+        this->target_thread());
+  }
+
+  /// Obtain an executor with the @c priority.normal property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::priority.normal); @endcode
+   */
+  ASIO_CONSTEXPR basic_executor_type<Allocator,
+      ASIO_UNSPECIFIED(Bits & ~priority_bits)>
+  require(execution::priority_t::normal_t) const
+  {
+    return basic_executor_type<Allocator, Bits & ~priority_bits>(
+        context_ptr(), *this, bits(),
+        this->target_thread());
+  }
+
+  /// Obtain an executor with the @c priority.high property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * Function objects submitted through the resulting executor, and the
+   * completion handlers of asynchronous operations that use it, are run
+   * before those with normal or low priority. To prevent starvation, a
+   * function object with a lower priority is run after every
+   * ASIO_PRIORITY_QUOTA consecutive higher priority ones.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::priority.high); @endcode
+   */
+  ASIO_CONSTEXPR basic_executor_type<Allocator,
+      ASIO_UNSPECIFIED((Bits & ~priority_bits) | priority_high)>
+  require(execution::priority_t::high_t) const
+  {
+    return basic_executor_type<Allocator,
+        (Bits & ~priority_bits) | priority_high>(
+          context_ptr(), *this, bits(),
+        this->target_thread());
+  }
+
+  /// Obtain an executor with the @c priority.low property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::require customisation point.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = asio::require(ex1,
+   *     asio::execution::priority.low); @endcode
+   */
+  ASIO_CONSTEXPR basic_executor_type<Allocator,
+      ASIO_UNSPECIFIED((Bits & ~priority_bits) | priority_low)>
+  require(execution::priority_t::low_t) const
+  {
+    return basic_executor_type<Allocator,
+        (Bits & ~priority_bits) | priority_low>(
+          context_ptr(), *this, bits(),
+        this->target_thread());
   }
 
   /// Obtain an executor with the specified @c allocator property.
@@ -840,7 +1146,8 @@ private:
   require(execution::allocator_t<OtherAllocator> a) const
   {
     return basic_executor_type<OtherAllocator, Bits>(
-        context_ptr(), a.value(), bits());
+        context_ptr(), a.value(), bits(),
+        this->target_thread());
   }
 
   /// Obtain an executor with the default @c allocator property.
@@ -857,7 +1164,8 @@ private:
   require(execution::allocator_t<void>) const
   {
     return basic_executor_type<std::allocator<void>, Bits>(
-        context_ptr(), std::allocator<void>(), bits());
+        context_ptr(), std::allocator<void>(), bits(),
+        this->target_thread());
   }
 
 #if !defined(GENERATING_DOCUMENTATION)
@@ -865,6 +1173,7 @@ private:
   friend struct asio_query_fn::impl;
   friend struct asio::execution::detail::mapping_t<0>;
   friend struct asio::execution::detail::outstanding_work_t<0>;
+  friend struct asio::execution::detail::priority_t<0>;
 #endif // !defined(GENERATING_DOCUMENTATION)
 
   /// Query the current value of the @c mapping property.
@@ -956,6 +1265,27 @@ private:
       : execution::outstanding_work_t(execution::outstanding_work.untracked);
   }
 
+  /// Query the current value of the @c priority property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * asio::query customisation point.
+   *
+   * For example:
+   * @code auto ex = my_io_context.get_executor();
+   * if (asio::query(ex, asio::execution::priority)
+   *       == asio::execution::priority.high)
+   *   ... @endcode
+   */
+  static ASIO_CONSTEXPR execution::priority_t query(
+      execution::priority_t) ASIO_NOEXCEPT
+  {
+    return (Bits & priority_high)
+      ? execution::priority_t(execution::priority.high)
+      : (Bits & priority_low)
+        ? execution::priority_t(execution::priority.low)
+        : execution::priority_t(execution::priority.normal);
+  }
+
   /// Query the current value of the @c allocator property.
   /**
    * Do not call this function directly. It is intended for use with the
@@ -1005,6 +1335,7 @@ public:
       const basic_executor_type& b) ASIO_NOEXCEPT
   {
     return a.target_ == b.target_
+      && a.target_thread() == b.target_thread()
       && static_cast<const Allocator&>(a) == static_cast<const Allocator&>(b);
   }
 
@@ -1016,6 +1347,7 @@ public:
       const basic_executor_type& b) ASIO_NOEXCEPT
   {
     return a.target_ != b.target_
+      || a.target_thread() != b.target_thread()
       || static_cast<const Allocator&>(a) != static_cast<const Allocator&>(b);
   }
 
@@ -1036,6 +1368,27 @@ private:
   template <typename Function>
   void execute(ASIO_MOVE_ARG(Function) f) const;
 
+public:
+  /// Request the io_context to invoke a range of function objects.
+  /**
+   * This function submits a copy of each function object in the range
+   * <tt>[first, last)</tt> for execution, in order. None of the function
+   * objects is called from the current thread prior to returning from
+   * <tt>post_batch()</tt>. Use @c std::make_move_iterator to move the function
+   * objects instead of copying them.
+   *
+   * The function objects are added to the io_context's queue together, under a
+   * single acquisition of its lock, and at most as many idle threads are woken
+   * as there are function objects.
+   *
+   * @param first An iterator to the first function object in the range. The
+   * function signature of each function object must be: @code void f(); @endcode
+   *
+   * @param last An iterator one past the last function object in the range.
+   */
+  template <typename InputIterator>
+  void post_batch(InputIterator first, InputIterator last) const;
+
 #if !defined(ASIO_NO_TS_EXECUTORS)
 public:
   /// Obtain the underlying execution context.
@@ -1118,9 +1471,12 @@ private:
   friend class io_context;
   template <typename, uintptr_t> friend class basic_executor_type;
 
-  // Constructor used by io_context::get_executor().
-  explicit basic_executor_type(io_context& i) ASIO_NOEXCEPT
+  // Constructor used by io_context::get_executor() and
+  // io_context::get_thread_executor().
+  explicit basic_executor_type(io_context& i,
+      std::size_t thread = ~static_cast<std::size_t>(0)) ASIO_NOEXCEPT
     : Allocator(),
+      thread_target_base(thread),
       target_(reinterpret_cast<uintptr_t>(&i))
   {
     if (Bits & outstanding_work_tracked)
@@ -1128,9 +1484,10 @@ private:
   }
 
   // Constructor used by require().
-  basic_executor_type(io_context* i,
-      const Allocator& a, uintptr_t bits) ASIO_NOEXCEPT
+  basic_executor_type(io_context* i, const Allocator& a,
+      uintptr_t bits, std::size_t thread) ASIO_NOEXCEPT
     : Allocator(a),
+      thread_target_base(thread),
       target_(reinterpret_cast<uintptr_t>(i) | bits)
   {
     if (Bits & outstanding_work_tracked)
@@ -1148,6 +1505,25 @@ private:
     return target_ & runtime_bits;
   }
 
+  // Determine whether functions may be invoked in the current thread.
+  bool can_dispatch() const ASIO_NOEXCEPT
+  {
+    return (Bits & thread_targeted)
+      ? context_ptr()->impl_.this_thread_index() == this->target_thread()
+      : context_ptr()->impl_.can_dispatch();
+  }
+
+  // Submit an operation to the target thread, if there is one, or to the
+  // io_context.
+  template <typename Operation>
+  void post_operation(Operation* op, bool is_continuation) const
+  {
+    if (Bits & thread_targeted)
+      context_ptr()->impl_.post_to_thread(this->target_thread(), op);
+    else
+      context_ptr()->impl_.post_immediate_completion(op, is_continuation);
+  }
+
   // The underlying io_context and runtime bits.
   uintptr_t target_;
 };
@@ -1380,6 +1756,42 @@ struct require_member<
       Allocator, Bits & ~outstanding_work_tracked> result_type;
 };
 
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t::normal_t
+  > : asio::detail::io_context_bits
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = false);
+  typedef asio::io_context::basic_executor_type<
+      Allocator, Bits & ~priority_bits> result_type;
+};
+
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t::high_t
+  > : asio::detail::io_context_bits
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = false);
+  typedef asio::io_context::basic_executor_type<
+      Allocator, (Bits & ~priority_bits) | priority_high> result_type;
+};
+
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    asio::execution::priority_t::low_t
+  > : asio::detail::io_context_bits
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = false);
+  typedef asio::io_context::basic_executor_type<
+      Allocator, (Bits & ~priority_bits) | priority_low> result_type;
+};
+
 template <typename Allocator, uintptr_t Bits>
 struct require_member<
     asio::io_context::basic_executor_type<Allocator, Bits>,
@@ -1433,6 +1845,32 @@ struct query_static_constexpr_member<
   }
 };
 
+template <typename Allocator, uintptr_t Bits, typename Property>
+struct query_static_constexpr_member<
+    asio::io_context::basic_executor_type<Allocator, Bits>,
+    Property,
+    typename asio::enable_if<
+      asio::is_convertible<
+        Property,
+        asio::execution::priority_t
+      >::value
+    >::type
+  > : asio::detail::io_context_bits
+{
+  ASIO_STATIC_CONSTEXPR(bool, is_valid = true);
+  ASIO_STATIC_CONSTEXPR(bool, is_noexcept = true);
+  typedef asio::execution::priority_t result_type;
+
+  static ASIO_CONSTEXPR result_type value() ASIO_NOEXCEPT
+  {
+    return (Bits & priority_high)
+      ? execution::priority_t(execution::priority.high)
+      : (Bits & priority_low)
+        ? execution::priority_t(execution::priority.low)
+        : execution::priority_t(execution::priority.normal);
+  }
+};
+
 template <typename Allocator, uintptr_t Bits, typename Property>
 struct query_static_constexpr_member<
     asio::io_context::basic_executor_type<Allocator, Bits>,
@@ -0,0 +1,170 @@
+//
+// io_context_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_IO_CONTEXT_POOL_HPP
+#define ASIO_IO_CONTEXT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+#include <vector>
+#include "asio/detail/atomic_count.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/thread_group.hpp"
+#include "asio/executor_work_guard.hpp"
+#include "asio/io_context.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+
+/// A fixed-size pool of io_context objects, each run by its own thread.
+/**
+ * The io_context_pool class owns a number of io_context objects and runs each
+ * of them on a single thread, which may be pinned to a CPU. Objects that are
+ * created using an executor from the pool, such as sockets, are served by a
+ * single io_context for their whole lifetime, so that handlers for unrelated
+ * objects run without contending on a shared scheduler.
+ *
+ * @par Distributing work
+ *
+ * The get_executor() and get_io_context() functions choose an io_context from
+ * the pool either in turn or by picking the one with the least outstanding
+ * work. The load() function may be used to inspect each io_context.
+ *
+ * For example:
+ *
+ * @code asio::io_context_pool pool(4);
+ *
+ * // Create a socket on the least busy io_context.
+ * asio::ip::tcp::socket socket(
+ *     pool.get_executor(asio::io_context_pool::least_loaded));
+ *
+ * ...
+ *
+ * // Wait for all outstanding work in the pool to complete.
+ * pool.join(); @endcode
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe, except that join() must not be called
+ * concurrently with any other member function.
+ */
+class io_context_pool
+  : private noncopyable
+{
+public:
+  /// The executor type of the io_context objects in the pool.
+  typedef io_context::executor_type executor_type;
+
+  /// Strategies for choosing an io_context from the pool.
+  enum selection
+  {
+    /// Choose each io_context in turn.
+    round_robin,
+
+    /// Choose the io_context with the least outstanding work.
+    least_loaded
+  };
+
+  /// Constructs a pool with a specified number of io_context objects.
+  /**
+   * Creates @c pool_size io_context objects and starts a thread to run each of
+   * them.
+   *
+   * @param pool_size The number of io_context objects in the pool.
+   *
+   * @param pin_threads If @c true, the thread that runs the io_context at index
+   * @c i is bound to CPU <tt>i % N</tt>, where @c N is the number of hardware
+   * threads. Pinning is performed only where supported by the operating
+   * system, and a failure to pin a thread is ignored.
+   *
+   * @param concurrency_hint The concurrency hint passed to the constructor of
+   * each io_context. As each io_context is run by a single thread, this
+   * defaults to 1.
+   */
+  ASIO_DECL explicit io_context_pool(std::size_t pool_size,
+      bool pin_threads = true, int concurrency_hint = 1);
+
+  /// Destructor.
+  /**
+   * Automatically stops and joins the pool, if not explicitly done beforehand.
+   */
+  ASIO_DECL ~io_context_pool();
+
+  /// Get the number of io_context objects in the pool.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return shards_.size();
+  }
+
+  /// Choose an io_context from the pool.
+  ASIO_DECL io_context& get_io_context(selection s = round_robin);
+
+  /// Get the io_context at the specified index.
+  ASIO_DECL io_context& get_io_context_at(std::size_t index);
+
+  /// Choose an io_context from the pool and obtain its executor.
+  ASIO_DECL executor_type get_executor(selection s = round_robin);
+
+  /// Get the outstanding work of the io_context at the specified index.
+  /**
+   * @returns The number of handlers and asynchronous operations that have not
+   * yet completed on the io_context.
+   */
+  ASIO_DECL std::size_t load(std::size_t index) const;
+
+  /// Get the number of times the io_context at the specified index has been
+  /// chosen by get_executor() or get_io_context().
+  ASIO_DECL std::size_t selections(std::size_t index) const;
+
+  /// Stops the threads.
+  /**
+   * This function stops every io_context in the pool as soon as possible. As a
+   * result of calling @c stop(), pending handlers may never be invoked.
+   */
+  ASIO_DECL void stop();
+
+  /// Joins the threads.
+  /**
+   * This function blocks until the threads in the pool have completed. If @c
+   * stop() is not called prior to @c join(), the @c join() call will wait
+   * until every io_context in the pool has no more outstanding work.
+   */
+  ASIO_DECL void join();
+
+private:
+  struct shard;
+  struct thread_function;
+
+  // Choose the index of an io_context from the pool.
+  ASIO_DECL std::size_t choose(selection s);
+
+  // The io_context objects in the pool.
+  std::vector<shard*> shards_;
+
+  // The threads that run the io_context objects.
+  detail::thread_group threads_;
+
+  // The next index to be chosen in round-robin order.
+  detail::atomic_count next_;
+};
+
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#if defined(ASIO_HEADER_ONLY)
+# include "asio/impl/io_context_pool.ipp"
+#endif // defined(ASIO_HEADER_ONLY)
+
+#endif // ASIO_IO_CONTEXT_POOL_HPP
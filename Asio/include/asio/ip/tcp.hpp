@@ -17,6 +17,7 @@
 
 #include "asio/detail/config.hpp"
 #include "asio/basic_socket_acceptor.hpp"
+#include "asio/basic_socket_acceptor_group.hpp"
 #include "asio/basic_socket_iostream.hpp"
 #include "asio/basic_stream_socket.hpp"
 #include "asio/detail/socket_option.hpp" //socket
@@ -85,6 +86,9 @@ public:
   /// The TCP acceptor type.
   typedef basic_socket_acceptor<tcp> acceptor;
 
+  /// The TCP acceptor group type.
+  typedef basic_socket_acceptor_group<tcp> acceptor_group;
+
   /// The TCP resolver type.
   typedef basic_resolver<tcp> resolver;
 
@@ -0,0 +1,275 @@
+//
+// provided_buffer_ring.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef ASIO_PROVIDED_BUFFER_RING_HPP
+#define ASIO_PROVIDED_BUFFER_RING_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include "asio/detail/config.hpp"
+
+#if (defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)) \
+  || defined(GENERATING_DOCUMENTATION)
+
+#include <cstddef>
+#include "asio/buffer.hpp"
+#include "asio/execution/context.hpp"
+#include "asio/execution/executor.hpp"
+#include "asio/execution_context.hpp"
+#include "asio/is_executor.hpp"
+#include "asio/query.hpp"
+#include "asio/detail/noncopyable.hpp"
+#include "asio/detail/type_traits.hpp"
+#include "asio/detail/scheduler.hpp"
+#include "asio/detail/io_uring_buffer_ring.hpp"
+
+#include "asio/detail/push_options.hpp"
+
+namespace asio {
+namespace detail {
+
+class provided_buffer_access;
+
+} // namespace detail
+
+/// A buffer borrowed from a provided_buffer_ring.
+/**
+ * A provided_buffer holds data that the kernel received directly into one of
+ * the buffers of a provided_buffer_ring. The buffer is returned to the ring,
+ * so that the kernel can use it again, when the provided_buffer is destroyed
+ * or reset. A default-constructed provided_buffer is empty.
+ *
+ * The provided_buffer_ring from which the buffer was borrowed must outlive
+ * the provided_buffer.
+ */
+class provided_buffer
+{
+public:
+  /// Construct an empty buffer.
+  provided_buffer() ASIO_NOEXCEPT
+    : ring_(0),
+      id_(0),
+      size_(0)
+  {
+  }
+
+  /// Move constructor.
+  provided_buffer(provided_buffer&& other) ASIO_NOEXCEPT
+    : ring_(other.ring_),
+      id_(other.id_),
+      size_(other.size_)
+  {
+    other.ring_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Move assignment. Returns any buffer currently held to its ring.
+  provided_buffer& operator=(provided_buffer&& other) ASIO_NOEXCEPT
+  {
+    if (this != &other)
+    {
+      reset();
+      ring_ = other.ring_;
+      id_ = other.id_;
+      size_ = other.size_;
+      other.ring_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// Destructor. Returns the buffer to its ring.
+  ~provided_buffer()
+  {
+    reset();
+  }
+
+  /// Get a pointer to the received data.
+  void* data() const ASIO_NOEXCEPT
+  {
+    return ring_ ? ring_->buffer(id_) : 0;
+  }
+
+  /// Get the number of bytes of received data.
+  std::size_t size() const ASIO_NOEXCEPT
+  {
+    return size_;
+  }
+
+  /// Get the received data as a buffer.
+  mutable_buffer buffer() const ASIO_NOEXCEPT
+  {
+    return mutable_buffer(data(), size_);
+  }
+
+  /// Return the buffer to its ring now, leaving this object empty.
+  void reset() ASIO_NOEXCEPT
+  {
+    if (ring_)
+    {
+      ring_->recycle(id_);
+      ring_ = 0;
+      size_ = 0;
+    }
+  }
+
+private:
+  friend class detail::provided_buffer_access;
+
+  provided_buffer(detail::io_uring_buffer_ring* ring,
+      unsigned short id, std::size_t size) ASIO_NOEXCEPT
+    : ring_(ring),
+      id_(id),
+      size_(size)
+  {
+  }
+
+  // Disallow copying and assignment.
+  provided_buffer(const provided_buffer&) ASIO_DELETED;
+  provided_buffer& operator=(const provided_buffer&) ASIO_DELETED;
+
+  detail::io_uring_buffer_ring* ring_;
+  unsigned short id_;
+  std::size_t size_;
+};
+
+/// A pool of buffers from which io_uring selects when data arrives.
+/**
+ * A provided_buffer_ring registers a pool of equally sized buffers with the
+ * io_uring instance of an execution context. A receive that selects from the
+ * ring, such as basic_stream_socket::async_read_loop(), does not pin a buffer
+ * while it waits. Instead, the kernel takes a buffer from the ring only when
+ * data arrives, and the data is delivered as a provided_buffer. This allows a
+ * large number of mostly idle connections to share a small amount of memory.
+ *
+ * When all buffers are in use, a receive that selects from the ring fails
+ * with asio::error::no_buffer_space.
+ *
+ * The ring must outlive all operations that select from it, and all
+ * provided_buffer objects borrowed from it.
+ */
+class provided_buffer_ring
+  : private detail::noncopyable
+{
+public:
+  /// Register a ring of buffers with an executor's execution context.
+  /**
+   * @param ex The executor whose execution context will select from the
+   * ring.
+   *
+   * @param buffer_count The number of buffers in the ring. This must be a
+   * power of two no greater than 32768.
+   *
+   * @param buffer_size The size of each buffer in the ring.
+   *
+   * @throws asio::system_error Thrown on failure. The error is
+   * asio::error::invalid_argument if the number or size of the buffers is
+   * not valid.
+   */
+  template <typename Executor>
+  provided_buffer_ring(const Executor& ex,
+      std::size_t buffer_count, std::size_t buffer_size,
+      typename constraint<
+        is_executor<Executor>::value || execution::is_executor<Executor>::value
+      >::type = 0)
+    : impl_(use_service<detail::io_uring_service>(
+          provided_buffer_ring::get_context(ex)),
+        buffer_count, buffer_size)
+  {
+  }
+
+  /// Register a ring of buffers with an execution context.
+  /**
+   * @param ctx The execution context that will select from the ring.
+   *
+   * @param buffer_count The number of buffers in the ring. This must be a
+   * power of two no greater than 32768.
+   *
+   * @param buffer_size The size of each buffer in the ring.
+   *
+   * @throws asio::system_error Thrown on failure. The error is
+   * asio::error::invalid_argument if the number or size of the buffers is
+   * not valid.
+   */
+  template <typename ExecutionContext>
+  provided_buffer_ring(ExecutionContext& ctx,
+      std::size_t buffer_count, std::size_t buffer_size,
+      typename constraint<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      >::type = 0)
+    : impl_(use_service<detail::io_uring_service>(ctx),
+        buffer_count, buffer_size)
+  {
+  }
+
+  /// Get the number of buffers in the ring.
+  std::size_t buffer_count() const ASIO_NOEXCEPT
+  {
+    return impl_.buffer_count();
+  }
+
+  /// Get the size of each buffer in the ring.
+  std::size_t buffer_size() const ASIO_NOEXCEPT
+  {
+    return impl_.buffer_size();
+  }
+
+#if !defined(GENERATING_DOCUMENTATION)
+  // Get the underlying implementation.
+  detail::io_uring_buffer_ring& get_implementation() ASIO_NOEXCEPT
+  {
+    return impl_;
+  }
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+private:
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<execution::is_executor<T>::value>::type* = 0)
+  {
+    return asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      typename enable_if<!execution::is_executor<T>::value>::type* = 0)
+  {
+    return t.context();
+  }
+
+  detail::io_uring_buffer_ring impl_;
+};
+
+namespace detail {
+
+// Allows operations to lend buffers from a ring to their handlers.
+class provided_buffer_access
+{
+public:
+  static provided_buffer make_buffer(io_uring_buffer_ring& ring,
+      unsigned short id, std::size_t size) ASIO_NOEXCEPT
+  {
+    return provided_buffer(&ring, id, size);
+  }
+};
+
+} // namespace detail
+} // namespace asio
+
+#include "asio/detail/pop_options.hpp"
+
+#endif // (defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE))
+       //   || defined(GENERATING_DOCUMENTATION)
+
+#endif // ASIO_PROVIDED_BUFFER_RING_HPP
@@ -396,6 +396,42 @@ public:
       reuse_address;
 #endif
 
+  /// Socket option to allow several sockets to be bound to the same address,
+  /// with incoming connections or datagrams shared out among them.
+  /**
+   * Implements the SOL_SOCKET/SO_REUSEPORT socket option. This option is only
+   * available on platforms that support SO_REUSEPORT.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::reuse_port option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * asio::socket_base::reuse_port option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined reuse_port;
+#elif defined(ASIO_OS_DEF_SO_REUSEPORT)
+  typedef asio::detail::socket_option::boolean<
+    ASIO_OS_DEF(SOL_SOCKET), ASIO_OS_DEF(SO_REUSEPORT)>
+      reuse_port;
+#endif
+
   /// Socket option to specify whether the socket lingers on close if unsent
   /// data is present.
   /**
@@ -503,6 +539,54 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to limit the operations performed each time the socket is
+  /// found to be ready.
+  /**
+   * Implements a custom socket option that sets the maximum number of
+   * asynchronous operations that are performed on the socket each time the
+   * reactor finds it ready. Once the limit is reached, the remaining
+   * operations wait behind the other ready sockets until the reactor next
+   * runs. This prevents a socket that always has data available from
+   * monopolising a thread. The limit also applies to operations that would
+   * otherwise complete immediately when started. A value of zero, the
+   * default, means that there is no limit.
+   *
+   * The option is supported only when epoll is used as the reactor. It is not
+   * supported for sockets that use lock-free operation slots or that belong
+   * to a reactor shard, and setting it fails with
+   * asio::error::operation_not_supported in these cases.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::io_quota option(16);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * asio::ip::tcp::socket socket(my_context);
+   * ...
+   * asio::socket_base::io_quota option;
+   * socket.get_option(option);
+   * int operations = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined io_quota;
+#else
+  typedef asio::detail::socket_option::integer<
+    asio::detail::custom_socket_option_level,
+    asio::detail::io_quota_option>
+    io_quota;
+#endif
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
@@ -0,0 +1,178 @@
+//
+// accept_rate.cpp
+// ~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// A number of client threads connect to a single acceptor as fast as they can,
+// closing each connection with a reset so that no TIME_WAIT state builds up.
+// The server runs on one thread and either accepts one connection per handler
+// or drains the listen queue with async_accept_many. The connection rate and
+// the average number of connections delivered to each handler are reported.
+struct result
+{
+  double connections_per_sec;
+  double connections_per_handler;
+};
+
+class server
+{
+public:
+  server(asio::io_context& ioc, std::size_t batch_size, long total)
+    : acceptor_(ioc, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(),
+          0), true),
+      batch_size_(batch_size),
+      total_(total),
+      accepted_(0),
+      handlers_(0)
+  {
+    acceptor_.listen(asio::socket_base::max_listen_connections);
+  }
+
+  asio::ip::tcp::endpoint endpoint() const
+  {
+    return acceptor_.local_endpoint();
+  }
+
+  void start()
+  {
+    if (accepted_ >= total_)
+      return;
+
+    if (batch_size_ == 1)
+    {
+      acceptor_.async_accept(
+          [this](const asio::error_code& error, asio::ip::tcp::socket)
+          {
+            handle_accept(error, 1);
+          });
+    }
+    else
+    {
+      acceptor_.async_accept_many(batch_size_,
+          [this](const asio::error_code& error,
+            std::vector<asio::ip::tcp::socket> peers)
+          {
+            handle_accept(error, static_cast<long>(peers.size()));
+          });
+    }
+  }
+
+  long handlers() const
+  {
+    return handlers_;
+  }
+
+private:
+  void handle_accept(const asio::error_code& error, long count)
+  {
+    if (error)
+    {
+      std::fprintf(stderr, "accept failed: %s\n", error.message().c_str());
+      return;
+    }
+
+    accepted_ += count;
+    ++handlers_;
+    start();
+  }
+
+  asio::ip::tcp::acceptor acceptor_;
+  std::size_t batch_size_;
+  long total_;
+  long accepted_;
+  long handlers_;
+};
+
+result run_test(std::size_t batch_size, int client_count, long total)
+{
+  asio::io_context ioc(1);
+  server s(ioc, batch_size, total);
+  asio::ip::tcp::endpoint endpoint = s.endpoint();
+
+  std::atomic<long> remaining(total);
+  std::vector<std::thread> clients;
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  for (int i = 0; i < client_count; ++i)
+  {
+    clients.emplace_back([&remaining, endpoint]
+        {
+          asio::io_context client_ioc(1);
+          while (remaining.fetch_sub(1, std::memory_order_relaxed) > 0)
+          {
+            asio::ip::tcp::socket socket(client_ioc);
+            asio::error_code ec;
+            socket.connect(endpoint, ec);
+            if (ec)
+            {
+              std::fprintf(stderr, "connect failed: %s\n",
+                  ec.message().c_str());
+              remaining.fetch_add(1, std::memory_order_relaxed);
+              continue;
+            }
+            socket.set_option(asio::socket_base::linger(true, 0), ec);
+          }
+        });
+  }
+
+  s.start();
+  ioc.run();
+
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+
+  for (std::size_t i = 0; i < clients.size(); ++i)
+    clients[i].join();
+
+  result r;
+  r.connections_per_sec = total / seconds;
+  r.connections_per_handler =
+    static_cast<double>(total) / (s.handlers() ? s.handlers() : 1);
+  return r;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 1 && argc != 3)
+  {
+    std::fprintf(stderr, "Usage: accept_rate [<connections> <clients>]\n");
+    return 1;
+  }
+
+  long total = argc == 3 ? std::atol(argv[1]) : 20000;
+  int client_count = argc == 3 ? std::atoi(argv[2]) : 8;
+  static const std::size_t batch_sizes[] = { 1, 16, 64, 256 };
+
+  std::printf("%-16s %14s %14s\n", "mode", "conns/sec", "conns/handler");
+
+  for (std::size_t i = 0; i < sizeof(batch_sizes) / sizeof(batch_sizes[0]); ++i)
+  {
+    char mode[32];
+    if (batch_sizes[i] == 1)
+      std::snprintf(mode, sizeof(mode), "accept");
+    else
+      std::snprintf(mode, sizeof(mode), "accept_many(%d)",
+          static_cast<int>(batch_sizes[i]));
+
+    result r = run_test(batch_sizes[i], client_count, total);
+    std::printf("%-16s %14.0f %14.2f\n", mode,
+        r.connections_per_sec, r.connections_per_handler);
+    std::fflush(stdout);
+  }
+
+  return 0;
+}
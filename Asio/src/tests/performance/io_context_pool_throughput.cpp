@@ -0,0 +1,153 @@
+//
+// io_context_pool_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Each chain runs a handler that performs a little work and then posts its
+// continuation to the same executor, so that a chain stays on one io_context.
+class chain
+{
+public:
+  chain(asio::io_context::executor_type ex, std::atomic<long>& remaining)
+    : executor_(ex),
+      remaining_(remaining)
+  {
+  }
+
+  void start()
+  {
+    asio::post(executor_, [this]{ step(1); });
+  }
+
+private:
+  void step(unsigned value)
+  {
+    // Simulate a small amount of per-handler work.
+    for (int i = 0; i < 64; ++i)
+      value = value * 1664525u + 1013904223u;
+    sink_ = value;
+
+    if (remaining_.fetch_sub(1, std::memory_order_relaxed) > 0)
+      asio::post(executor_, [this, value]{ step(value); });
+  }
+
+  asio::io_context::executor_type executor_;
+  std::atomic<long>& remaining_;
+  unsigned sink_;
+};
+
+template <typename Function>
+double measure(long handler_count, Function f)
+{
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  f();
+
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  return handler_count / elapsed.count();
+}
+
+// All threads run a single shared io_context.
+double run_shared(int thread_count, int chain_count, long handler_count)
+{
+  asio::io_context ioc(thread_count);
+  std::atomic<long> remaining(handler_count);
+
+  std::vector<chain*> chains;
+  for (int i = 0; i < chain_count; ++i)
+  {
+    chains.push_back(new chain(ioc.get_executor(), remaining));
+    chains.back()->start();
+  }
+
+  double rate = measure(handler_count, [&]
+      {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_count; ++i)
+          threads.emplace_back([&ioc]{ ioc.run(); });
+        for (std::size_t i = 0; i < threads.size(); ++i)
+          threads[i].join();
+      });
+
+  for (std::size_t i = 0; i < chains.size(); ++i)
+    delete chains[i];
+
+  return rate;
+}
+
+// Each thread runs its own io_context, and chains are spread over the pool.
+double run_pool(int thread_count, int chain_count,
+    long handler_count, bool pin_threads)
+{
+  std::atomic<long> remaining(handler_count);
+  std::vector<chain*> chains;
+  double rate;
+
+  {
+    asio::io_context_pool pool(thread_count, pin_threads);
+    rate = measure(handler_count, [&]
+        {
+          for (int i = 0; i < chain_count; ++i)
+          {
+            chains.push_back(new chain(pool.get_executor(), remaining));
+            chains.back()->start();
+          }
+          pool.join();
+        });
+  }
+
+  for (std::size_t i = 0; i < chains.size(); ++i)
+    delete chains[i];
+
+  return rate;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 1 && argc != 3)
+  {
+    std::fprintf(stderr,
+        "Usage: io_context_pool_throughput [<chains> <handlers>]\n");
+    return 1;
+  }
+
+  int chain_count = argc == 3 ? std::atoi(argv[1]) : 256;
+  long handler_count = argc == 3 ? std::atol(argv[2]) : 4000000;
+  static const int thread_counts[] = { 1, 2, 4, 8, 16 };
+
+  std::printf("%-8s %16s %16s %16s   (handlers/sec)\n",
+      "threads", "shared", "pool", "pool_pinned");
+
+  for (std::size_t t = 0; t < sizeof(thread_counts) / sizeof(int); ++t)
+  {
+    int thread_count = thread_counts[t];
+    std::printf("%-8d", thread_count);
+    std::printf(" %16.0f",
+        run_shared(thread_count, chain_count, handler_count));
+    std::fflush(stdout);
+    std::printf(" %16.0f",
+        run_pool(thread_count, chain_count, handler_count, false));
+    std::fflush(stdout);
+    std::printf(" %16.0f",
+        run_pool(thread_count, chain_count, handler_count, true));
+    std::printf("\n");
+  }
+
+  return 0;
+}
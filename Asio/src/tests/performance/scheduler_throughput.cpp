@@ -0,0 +1,131 @@
+//
+// scheduler_throughput.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Each chain runs a handler that performs a little work and then posts its
+// continuation from inside the io_context. With many chains in flight, every
+// handler passes through the scheduler's queues.
+class chain
+{
+public:
+  chain(asio::io_context& ioc, std::atomic<long>& remaining)
+    : io_context_(ioc),
+      remaining_(remaining)
+  {
+  }
+
+  void start()
+  {
+    asio::post(io_context_, [this]{ step(1); });
+  }
+
+private:
+  void step(unsigned value)
+  {
+    // Simulate a small amount of per-handler work.
+    for (int i = 0; i < 64; ++i)
+      value = value * 1664525u + 1013904223u;
+    sink_ = value;
+
+    if (remaining_.fetch_sub(1, std::memory_order_relaxed) > 0)
+      asio::post(io_context_, [this, value]{ step(value); });
+  }
+
+  asio::io_context& io_context_;
+  std::atomic<long>& remaining_;
+  unsigned sink_;
+};
+
+struct scheduler_mode
+{
+  const char* name;
+  int concurrency_hint;
+};
+
+static const scheduler_mode modes[] =
+{
+  { "default", ASIO_CONCURRENCY_HINT_SAFE },
+  { "work_stealing", ASIO_CONCURRENCY_HINT_WORK_STEALING },
+  { "lockfree_post", ASIO_CONCURRENCY_HINT_LOCKFREE_POST },
+  { "busy_poll", ASIO_CONCURRENCY_HINT_BUSY_POLL },
+  { "lifo_wake", ASIO_CONCURRENCY_HINT_LIFO_WAKE }
+};
+
+double run_test(const scheduler_mode& mode,
+    int thread_count, int chain_count, long handler_count)
+{
+  asio::io_context ioc(mode.concurrency_hint);
+  std::atomic<long> remaining(handler_count);
+
+  std::vector<chain*> chains;
+  for (int i = 0; i < chain_count; ++i)
+  {
+    chains.push_back(new chain(ioc, remaining));
+    chains.back()->start();
+  }
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_count; ++i)
+    threads.emplace_back([&ioc]{ ioc.run(); });
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  for (std::size_t i = 0; i < chains.size(); ++i)
+    delete chains[i];
+
+  return handler_count / elapsed.count();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 1 && argc != 3)
+  {
+    std::fprintf(stderr,
+        "Usage: scheduler_throughput [<chains> <handlers>]\n");
+    return 1;
+  }
+
+  int chain_count = argc == 3 ? std::atoi(argv[1]) : 256;
+  long handler_count = argc == 3 ? std::atol(argv[2]) : 4000000;
+  static const int thread_counts[] = { 1, 4, 16, 64 };
+
+  std::printf("%-8s", "threads");
+  for (std::size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    std::printf(" %16s", modes[m].name);
+  std::printf("   (handlers/sec)\n");
+
+  for (std::size_t t = 0; t < sizeof(thread_counts) / sizeof(int); ++t)
+  {
+    std::printf("%-8d", thread_counts[t]);
+    for (std::size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    {
+      double rate = run_test(modes[m],
+          thread_counts[t], chain_count, handler_count);
+      std::printf(" %16.0f", rate);
+      std::fflush(stdout);
+    }
+    std::printf("\n");
+  }
+
+  return 0;
+}
@@ -0,0 +1,170 @@
+//
+// scheduler_wakeup_latency.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Handlers are posted from outside the io_context at a fixed rate that keeps
+// only a few of the threads busy. For each handler, the time from post to the
+// start of the handler and the thread that ran it are recorded. A handler that
+// runs on a different thread from the one before it is counted as a migration.
+struct sample
+{
+  long latency_ns;
+  std::size_t thread_index;
+};
+
+struct scheduler_mode
+{
+  const char* name;
+  int concurrency_hint;
+};
+
+static const scheduler_mode modes[] =
+{
+  { "default", ASIO_CONCURRENCY_HINT_SAFE },
+  { "lifo_wake", ASIO_CONCURRENCY_HINT_LIFO_WAKE }
+};
+
+// The index of the calling thread among those running the io_context. Threads
+// are only given indexes by the io_context under some hints, so the test keeps
+// its own.
+static thread_local std::size_t this_thread_index = ~std::size_t(0);
+
+struct result
+{
+  double p50_us;
+  double p99_us;
+  double migrations;
+  std::size_t threads_used;
+};
+
+// Simulate a small amount of per-handler work.
+void spin_for(std::chrono::nanoseconds duration)
+{
+  std::chrono::steady_clock::time_point end =
+    std::chrono::steady_clock::now() + duration;
+  while (std::chrono::steady_clock::now() < end)
+  {
+  }
+}
+
+result run_test(const scheduler_mode& mode, int thread_count,
+    long handler_count, std::chrono::microseconds interval,
+    std::chrono::microseconds work)
+{
+  asio::io_context ioc(mode.concurrency_hint);
+  asio::executor_work_guard<asio::io_context::executor_type> guard =
+    asio::make_work_guard(ioc);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < thread_count; ++i)
+  {
+    threads.emplace_back([&ioc, i]
+        {
+          this_thread_index = i;
+          ioc.run();
+        });
+  }
+
+  // Let the threads become idle before the first handler is posted.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::vector<sample> samples(handler_count);
+  std::atomic<long> completed(0);
+
+  std::chrono::steady_clock::time_point next =
+    std::chrono::steady_clock::now();
+  for (long i = 0; i < handler_count; ++i)
+  {
+    while (std::chrono::steady_clock::now() < next)
+    {
+    }
+    next += interval;
+
+    std::chrono::steady_clock::time_point posted =
+      std::chrono::steady_clock::now();
+    asio::post(ioc, [&, i, posted]
+        {
+          sample& s = samples[i];
+          s.latency_ns = static_cast<long>(
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - posted).count());
+          s.thread_index = this_thread_index;
+          spin_for(work);
+          completed.fetch_add(1, std::memory_order_release);
+        });
+  }
+
+  while (completed.load(std::memory_order_acquire) != handler_count)
+    std::this_thread::yield();
+
+  guard.reset();
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  result r;
+  long migrations = 0;
+  std::vector<bool> used(thread_count, false);
+  std::vector<long> latencies;
+  for (long i = 0; i < handler_count; ++i)
+  {
+    latencies.push_back(samples[i].latency_ns);
+    if (i > 0 && samples[i].thread_index != samples[i - 1].thread_index)
+      ++migrations;
+    if (samples[i].thread_index < used.size())
+      used[samples[i].thread_index] = true;
+  }
+  std::sort(latencies.begin(), latencies.end());
+  r.p50_us = latencies[latencies.size() / 2] / 1000.0;
+  r.p99_us = latencies[latencies.size() * 99 / 100] / 1000.0;
+  r.migrations = 100.0 * migrations / handler_count;
+  r.threads_used = std::count(used.begin(), used.end(), true);
+  return r;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 1 && argc != 4)
+  {
+    std::fprintf(stderr, "Usage: scheduler_wakeup_latency"
+        " [<handlers> <interval_usec> <work_usec>]\n");
+    return 1;
+  }
+
+  long handler_count = argc == 4 ? std::atol(argv[1]) : 20000;
+  std::chrono::microseconds interval(argc == 4 ? std::atol(argv[2]) : 20);
+  std::chrono::microseconds work(argc == 4 ? std::atol(argv[3]) : 5);
+  static const int thread_counts[] = { 4, 16, 32 };
+
+  std::printf("%-8s %-10s %10s %10s %12s %8s\n", "threads", "mode",
+      "p50 (us)", "p99 (us)", "migrations", "used");
+
+  for (std::size_t t = 0; t < sizeof(thread_counts) / sizeof(int); ++t)
+  {
+    for (std::size_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m)
+    {
+      result r = run_test(modes[m],
+          thread_counts[t], handler_count, interval, work);
+      std::printf("%-8d %-10s %10.1f %10.1f %11.1f%% %8d\n",
+          thread_counts[t], modes[m].name, r.p50_us, r.p99_us,
+          r.migrations, static_cast<int>(r.threads_used));
+      std::fflush(stdout);
+    }
+  }
+
+  return 0;
+}
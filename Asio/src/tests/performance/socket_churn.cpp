@@ -0,0 +1,116 @@
+//
+// socket_churn.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "asio.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#if !defined(ASIO_WINDOWS)
+# include <sys/resource.h>
+#endif // !defined(ASIO_WINDOWS)
+
+// Opens and closes a large number of sockets, keeping a fixed number of them
+// open at a time, so that the reactor's per-descriptor state is allocated and
+// recycled many times over. The test is run with one thread and then with a
+// number of threads sharing one io_context. To compare descriptor state
+// allocation strategies, build once as is and once with
+// ASIO_DISABLE_DESCRIPTOR_STATE_SLAB defined.
+void churn(asio::io_context& ioc, std::atomic<long>& remaining, long live)
+{
+  std::vector<asio::ip::udp::socket> sockets;
+  sockets.reserve(live);
+  for (;;)
+  {
+    long batch = remaining.fetch_sub(live, std::memory_order_relaxed);
+    if (batch <= 0)
+      break;
+    if (batch > live)
+      batch = live;
+
+    for (long i = 0; i < batch; ++i)
+    {
+      sockets.emplace_back(ioc);
+      sockets.back().open(asio::ip::udp::v4());
+    }
+
+    sockets.clear();
+  }
+}
+
+double run_test(long total, long live, int thread_count)
+{
+  asio::io_context ioc;
+  std::atomic<long> remaining(total);
+  std::vector<std::thread> threads;
+
+  std::chrono::steady_clock::time_point start =
+    std::chrono::steady_clock::now();
+
+  for (int i = 1; i < thread_count; ++i)
+    threads.emplace_back([&]{ churn(ioc, remaining, live); });
+  churn(ioc, remaining, live);
+  for (std::size_t i = 0; i < threads.size(); ++i)
+    threads[i].join();
+
+  double seconds = std::chrono::duration<double>(
+      std::chrono::steady_clock::now() - start).count();
+  return total / seconds;
+}
+
+long max_rss_kb()
+{
+#if !defined(ASIO_WINDOWS)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+    return usage.ru_maxrss;
+#endif // !defined(ASIO_WINDOWS)
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 1 && argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: socket_churn [<sockets> <live sockets> <threads>]\n");
+    return 1;
+  }
+
+  long total = argc == 4 ? std::atol(argv[1]) : 1000000;
+  long live = argc == 4 ? std::atol(argv[2]) : 1000;
+  int thread_count = argc == 4 ? std::atoi(argv[3])
+    : static_cast<int>(std::thread::hardware_concurrency());
+  if (thread_count < 1)
+    thread_count = 1;
+
+#if defined(ASIO_DISABLE_DESCRIPTOR_STATE_SLAB)
+  const char* pool = "object_pool";
+#else // defined(ASIO_DISABLE_DESCRIPTOR_STATE_SLAB)
+  const char* pool = "slab";
+#endif // defined(ASIO_DISABLE_DESCRIPTOR_STATE_SLAB)
+
+  std::printf("%-12s %8s %10s %14s %12s\n",
+      "pool", "threads", "live", "sockets/sec", "max rss kB");
+
+  int counts[] = { 1, thread_count };
+  for (int i = 0; i < (thread_count > 1 ? 2 : 1); ++i)
+  {
+    double rate = run_test(total, live, counts[i]);
+    std::printf("%-12s %8d %10ld %14.0f %12ld\n",
+        pool, counts[i], live, rate, max_rss_kb());
+    std::fflush(stdout);
+  }
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+//
+// slab_object_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/detail/slab_object_pool.hpp"
+
+#include <stdexcept>
+#include "../unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// detail_slab_object_pool_test test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the placement and reuse of objects allocated from
+// the pool.
+
+namespace detail_slab_object_pool_test {
+
+class test_object
+{
+public:
+  explicit test_object(bool fail)
+    : next_(0),
+      prev_(0)
+  {
+    if (fail)
+      throw std::runtime_error("test_object");
+  }
+
+private:
+  friend class asio::detail::object_pool_access;
+  test_object* next_;
+  test_object* prev_;
+};
+
+void slab_object_pool_test()
+{
+  using asio::detail::slab_object_pool;
+
+  slab_object_pool<test_object> pool;
+
+  // Objects are constructed in consecutive cache lines.
+  test_object* o1 = pool.alloc(false);
+  test_object* o2 = pool.alloc(false);
+  std::size_t line = ASIO_CACHE_LINE_SIZE;
+  ASIO_CHECK(reinterpret_cast<std::size_t>(o1) % line == 0);
+  ASIO_CHECK(reinterpret_cast<char*>(o2) - reinterpret_cast<char*>(o1)
+      == static_cast<std::ptrdiff_t>(line));
+  ASIO_CHECK(pool.first() == o2);
+
+  // A freed object is reused before new memory.
+  pool.free(o1);
+  ASIO_CHECK(pool.first() == o2);
+  test_object* o3 = pool.alloc(false);
+  ASIO_CHECK(o3 == o1);
+
+  // A constructor that throws leaves its slot for the next object.
+  bool caught = false;
+  try
+  {
+    pool.alloc(true);
+  }
+  catch (std::runtime_error&)
+  {
+    caught = true;
+  }
+  ASIO_CHECK(caught);
+  test_object* o4 = pool.alloc(false);
+  ASIO_CHECK(reinterpret_cast<char*>(o4) - reinterpret_cast<char*>(o2)
+      == static_cast<std::ptrdiff_t>(line));
+  ASIO_CHECK(pool.first() == o4);
+
+  // Allocation continues into further chunks.
+  for (int i = 0; i < ASIO_SLAB_OBJECT_POOL_CHUNK_SIZE * 2; ++i)
+    ASIO_CHECK(pool.alloc(false) != 0);
+}
+
+} // namespace detail_slab_object_pool_test
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "detail/slab_object_pool",
+  ASIO_TEST_CASE(detail_slab_object_pool_test::slab_object_pool_test)
+)
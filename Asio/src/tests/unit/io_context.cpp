@@ -16,11 +16,19 @@
 // Test that header file is self-contained.
 #include "asio/io_context.hpp"
 
+#include <fstream>
 #include <sstream>
+#include <vector>
 #include "asio/bind_executor.hpp"
+#include "asio/connect_pipe.hpp"
 #include "asio/dispatch.hpp"
+#include "asio/local/connect_pair.hpp"
+#include "asio/local/stream_protocol.hpp"
 #include "asio/post.hpp"
+#include "asio/readable_pipe.hpp"
 #include "asio/thread.hpp"
+#include "asio/writable_pipe.hpp"
+#include "asio/write.hpp"
 #include "unit_test.hpp"
 
 #if defined(ASIO_HAS_BOOST_DATE_TIME)
@@ -284,6 +292,1446 @@ void io_context_test()
   ASIO_CHECK(exception_count == 2);
 }
 
+void atomic_increment(asio::detail::atomic_count* count)
+{
+  ++(*count);
+}
+
+void fan_out(io_context* ioc, int depth, asio::detail::atomic_count* count)
+{
+  ++(*count);
+  if (depth > 0)
+  {
+    asio::post(*ioc, bindns::bind(fan_out, ioc, depth - 1, count));
+    asio::post(*ioc, bindns::bind(fan_out, ioc, depth - 1, count));
+  }
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void stress_read(const asio::error_code& ec, std::size_t n,
+    local::stream_protocol::socket* socket, char* buf,
+    std::size_t* remaining, asio::detail::atomic_count* done)
+{
+  if (ec)
+    return;
+
+  *remaining -= n;
+  if (*remaining > 0)
+  {
+    socket->async_read_some(asio::buffer(buf, 1024),
+        bindns::bind(stress_read, bindns::placeholders::_1,
+          bindns::placeholders::_2, socket, buf, remaining, done));
+  }
+  else
+    ++(*done);
+}
+
+void stress_write(local::stream_protocol::socket** sockets,
+    int pairs, std::size_t total)
+{
+  char data[100] = "";
+  for (std::size_t sent = 0; sent < total; sent += sizeof(data))
+  {
+    std::size_t n = total - sent < sizeof(data) ? total - sent : sizeof(data);
+    for (int i = 0; i < pairs; ++i)
+      asio::write(*sockets[i * 2 + 1], asio::buffer(data, n));
+  }
+}
+
+// Reads from many connections with several threads inside run(), while
+// another thread writes to them, so that the reactor keeps finding the same
+// descriptors ready.
+void run_socket_stress(io_context& ioc)
+{
+  const int pairs = 16;
+  const std::size_t total = 64 * 1024;
+  local::stream_protocol::socket* sockets[pairs * 2];
+  char bufs[pairs][1024];
+  std::size_t remaining[pairs];
+  asio::detail::atomic_count done(0);
+  for (int i = 0; i < pairs * 2; ++i)
+    sockets[i] = new local::stream_protocol::socket(ioc);
+  for (int i = 0; i < pairs; ++i)
+  {
+    local::connect_pair(*sockets[i * 2], *sockets[i * 2 + 1]);
+    remaining[i] = total;
+    sockets[i * 2]->async_read_some(asio::buffer(bufs[i]),
+        bindns::bind(stress_read, bindns::placeholders::_1,
+          bindns::placeholders::_2, sockets[i * 2], bufs[i],
+          &remaining[i], &done));
+  }
+
+  thread writer(bindns::bind(stress_write, sockets, pairs, total));
+  std::vector<thread*> run_threads;
+  for (int i = 0; i < 4; ++i)
+    run_threads.push_back(new thread(bindns::bind(io_context_run, &ioc)));
+  for (std::size_t i = 0; i < run_threads.size(); ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+  }
+  writer.join();
+
+  ASIO_CHECK(done == pairs);
+  for (int i = 0; i < pairs * 2; ++i)
+    delete sockets[i];
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void io_context_work_stealing_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_WORK_STEALING);
+  int count = 0;
+
+  asio::post(ioc, bindns::bind(increment, &count));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+  count = 10;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(decrement_to_zero, &ioc, &count));
+  ioc.run();
+
+  // Handlers posted from within the io_context are run by the same thread.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  ioc.run();
+
+  // The only operation executed should have been to stop run().
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 0);
+  w.reset();
+
+  // Handlers posted by each thread are shared with the other threads, and all
+  // of them run before the run() calls return.
+  asio::detail::atomic_count atomic_count(0);
+  ioc.restart();
+  for (int i = 0; i < 8; ++i)
+    asio::post(ioc, bindns::bind(fan_out, &ioc, 10, &atomic_count));
+  std::vector<thread*> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.push_back(new thread(bindns::bind(io_context_run, &ioc)));
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(atomic_count == 8 * 2047);
+
+  // Exceptions propagate out of run() without losing queued handlers.
+  count = 0;
+  int exception_count = 0;
+  ioc.restart();
+  asio::post(ioc, &throw_exception);
+  asio::post(ioc, bindns::bind(increment, &count));
+  asio::post(ioc, &throw_exception);
+  asio::post(ioc, bindns::bind(increment, &count));
+
+  for (;;)
+  {
+    try
+    {
+      ioc.run();
+      break;
+    }
+    catch (int)
+    {
+      ++exception_count;
+    }
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(exception_count == 2);
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  // The reactor is not run again while descriptors that it found ready on its
+  // previous run are still on a thread's local queue.
+  io_context ioc2(ASIO_CONCURRENCY_HINT_WORK_STEALING);
+  run_socket_stress(ioc2);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void post_atomic_increments(io_context* ioc,
+    int n, asio::detail::atomic_count* count)
+{
+  for (int i = 0; i < n; ++i)
+    asio::post(*ioc, bindns::bind(atomic_increment, count));
+}
+
+void check_sequence(int expected, int* next)
+{
+  ASIO_CHECK(*next == expected);
+  *next = expected + 1;
+}
+
+void io_context_lockfree_post_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_LOCKFREE_POST);
+  int count = 0;
+
+  asio::post(ioc, bindns::bind(increment, &count));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+  // Handlers posted from a single thread are run in the order they were
+  // posted.
+  count = 0;
+  ioc.restart();
+  for (int i = 0; i < 100; ++i)
+    asio::post(ioc, bindns::bind(check_sequence, i, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 100);
+
+  // Handlers posted from other threads while run() is blocked are all run.
+  asio::detail::atomic_count atomic_count(0);
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  thread runner(bindns::bind(io_context_run, &ioc));
+  std::vector<thread*> threads;
+  for (int i = 0; i < 4; ++i)
+  {
+    threads.push_back(new thread(
+          bindns::bind(post_atomic_increments, &ioc, 10000, &atomic_count)));
+  }
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+  threads.clear();
+  w.reset();
+  runner.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(atomic_count == 40000);
+
+  // Handlers may be polled.
+  count = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(increment, &count));
+  asio::post(ioc, bindns::bind(increment, &count));
+  ASIO_CHECK(ioc.poll_one() == 1);
+  ASIO_CHECK(count == 1);
+  ASIO_CHECK(ioc.poll() == 1);
+  ASIO_CHECK(count == 2);
+
+  // The lock-free queue may be combined with work stealing.
+  io_context ioc2(ASIO_CONCURRENCY_HINT_WORK_STEALING
+      | ASIO_CONCURRENCY_HINT_LOCKFREE_POST);
+  asio::detail::atomic_count atomic_count2(0);
+  for (int i = 0; i < 8; ++i)
+    asio::post(ioc2, bindns::bind(fan_out, &ioc2, 10, &atomic_count2));
+  for (int i = 0; i < 4; ++i)
+    threads.push_back(new thread(bindns::bind(io_context_run, &ioc2)));
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  ASIO_CHECK(ioc2.stopped());
+  ASIO_CHECK(atomic_count2 == 8 * 2047);
+
+  // Handlers that are never run are destroyed with the io_context.
+  io_context ioc3(ASIO_CONCURRENCY_HINT_LOCKFREE_POST);
+  asio::post(ioc3, bindns::bind(increment, &count));
+}
+
+void timer_increment(const asio::error_code&, int* count)
+{
+  ++(*count);
+}
+
+void io_context_busy_poll_test()
+{
+#if defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_STD_ATOMIC)
+  io_context ioc(ASIO_CONCURRENCY_HINT_BUSY_POLL);
+  int count = 0;
+
+  asio::post(ioc, bindns::bind(increment, &count));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+  // A thread that waits on the reactor for longer than the spin window stops
+  // spinning and blocks.
+  ioc.restart();
+  ioc.set_busy_poll_duration(asio::chrono::microseconds(1));
+  timer t(ioc, chronons::milliseconds(10));
+  t.async_wait(bindns::bind(timer_increment,
+        bindns::placeholders::_1, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(ioc.busy_poll_misses() > 0);
+
+  // Handlers posted from another thread while run() is spinning are picked
+  // up without the thread blocking.
+  asio::detail::atomic_count atomic_count(0);
+  ioc.restart();
+  ioc.set_busy_poll_duration(asio::chrono::seconds(10));
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  thread runner(bindns::bind(io_context_run, &ioc));
+  io_context ioc2;
+  for (int i = 0; i < 100 && ioc.busy_poll_hits() == 0; ++i)
+  {
+    timer t2(ioc2, chronons::milliseconds(1));
+    t2.wait();
+    asio::post(ioc, bindns::bind(atomic_increment, &atomic_count));
+    while (atomic_count != i + 1)
+    {
+      timer t3(ioc2, chronons::milliseconds(1));
+      t3.wait();
+    }
+  }
+  w.reset();
+  runner.join();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(ioc.busy_poll_hits() > 0);
+#endif // defined(ASIO_HAS_CHRONO) && defined(ASIO_HAS_STD_ATOMIC)
+}
+
+struct sequence_handler
+{
+  int expected_;
+  int* next_;
+
+  void operator()()
+  {
+    check_sequence(expected_, next_);
+  }
+};
+
+struct atomic_increment_handler
+{
+  asio::detail::atomic_count* count_;
+
+  void operator()()
+  {
+    atomic_increment(count_);
+  }
+};
+
+void io_context_post_batch_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  std::vector<sequence_handler> handlers;
+  for (int i = 0; i < 100; ++i)
+  {
+    sequence_handler h = { i, &count };
+    handlers.push_back(h);
+  }
+
+  // An empty batch is accepted, and adds no work.
+  ioc.get_executor().post_batch(handlers.begin(), handlers.begin());
+  ASIO_CHECK(ioc.run() == 0);
+  ASIO_CHECK(count == 0);
+
+  ioc.restart();
+  ioc.get_executor().post_batch(handlers.begin(), handlers.end());
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The handlers are run in order.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 100);
+
+  // A batch posted while threads are waiting is shared between them.
+  io_context ioc2(ASIO_CONCURRENCY_HINT_SAFE);
+  asio::detail::atomic_count atomic_count(0);
+  atomic_increment_handler h2 = { &atomic_count };
+  std::vector<atomic_increment_handler> handlers2(1000, h2);
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc2);
+  std::vector<thread*> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.push_back(new thread(bindns::bind(io_context_run, &ioc2)));
+  ioc2.get_executor().post_batch(handlers2.begin(), handlers2.end());
+  w.reset();
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  ASIO_CHECK(ioc2.stopped());
+  ASIO_CHECK(atomic_count == 1000);
+}
+
+void record(int id, std::vector<int>* order)
+{
+  order->push_back(id);
+}
+
+void record_wait(const asio::error_code&, int id, std::vector<int>* order)
+{
+  order->push_back(id);
+}
+
+void record_io(const asio::error_code&, std::size_t,
+    int id, std::vector<int>* order)
+{
+  order->push_back(id);
+}
+
+void io_context_priority_test()
+{
+  io_context ioc;
+  std::vector<int> order;
+
+  io_context::executor_type normal_ex = ioc.get_executor();
+  ASIO_CHECK(asio::query(normal_ex, execution::priority)
+      == execution::priority.normal);
+
+  typedef asio::decay<asio::require_result<io_context::executor_type,
+      execution::priority_t::high_t>::type>::type high_executor_type;
+  high_executor_type high_ex = asio::require(normal_ex,
+      execution::priority.high);
+  ASIO_CHECK(asio::query(high_ex, execution::priority)
+      == execution::priority.high);
+  ASIO_CHECK(asio::query(asio::require(high_ex, execution::priority.normal),
+        execution::priority) == execution::priority.normal);
+
+  typedef asio::decay<asio::require_result<io_context::executor_type,
+      execution::priority_t::low_t>::type>::type low_executor_type;
+  low_executor_type low_ex = asio::require(normal_ex,
+      execution::priority.low);
+  ASIO_CHECK(asio::query(low_ex, execution::priority)
+      == execution::priority.low);
+
+  // High priority handlers run first, and low priority handlers last.
+  for (int i = 0; i < 3; ++i)
+  {
+    asio::post(low_ex, bindns::bind(record, 200 + i, &order));
+    asio::post(normal_ex, bindns::bind(record, 100 + i, &order));
+    asio::post(high_ex, bindns::bind(record, i, &order));
+  }
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 9);
+  for (int i = 0; i < 3 && order.size() == 9; ++i)
+  {
+    ASIO_CHECK(order[i] == i);
+    ASIO_CHECK(order[3 + i] == 100 + i);
+    ASIO_CHECK(order[6 + i] == 200 + i);
+  }
+
+  // A waiting lower priority handler gets a turn after a run of high priority
+  // handlers.
+  order.clear();
+  ioc.restart();
+  asio::post(normal_ex, bindns::bind(record, 100, &order));
+  for (int i = 0; i < ASIO_PRIORITY_QUOTA * 2; ++i)
+    asio::post(high_ex, bindns::bind(record, i, &order));
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == ASIO_PRIORITY_QUOTA * 2 + 1);
+  if (order.size() == ASIO_PRIORITY_QUOTA * 2 + 1)
+  {
+    ASIO_CHECK(order[ASIO_PRIORITY_QUOTA - 1] == ASIO_PRIORITY_QUOTA - 1);
+    ASIO_CHECK(order[ASIO_PRIORITY_QUOTA] == 100);
+  }
+
+#if defined(ASIO_HAS_BOOST_DATE_TIME) || defined(ASIO_HAS_CHRONO)
+  // The completion of an asynchronous operation inherits the priority of the
+  // handler's associated executor.
+  order.clear();
+  ioc.restart();
+  timer t(ioc, chronons::seconds(0));
+  for (int i = 0; i < 3; ++i)
+    asio::post(normal_ex, bindns::bind(record, 100 + i, &order));
+  t.async_wait(asio::bind_executor(high_ex,
+        bindns::bind(record_wait, bindns::placeholders::_1, 0, &order)));
+  t.cancel();
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 4);
+  if (order.size() == 4)
+  {
+    ASIO_CHECK(order[0] == 0);
+    ASIO_CHECK(order[1] == 100);
+    ASIO_CHECK(order[2] == 101);
+    ASIO_CHECK(order[3] == 102);
+  }
+
+#if !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The same holds for an operation completed by the reactor. (The io_uring
+  // backend submits the wait from a queued operation, and so cannot see the
+  // expiry before the handlers that were already queued have run.)
+  order.clear();
+  ioc.restart();
+  timer t3(ioc, chronons::seconds(0));
+  for (int i = 0; i < 3; ++i)
+    asio::post(normal_ex, bindns::bind(record, 100 + i, &order));
+  t3.async_wait(asio::bind_executor(high_ex,
+        bindns::bind(record_wait, bindns::placeholders::_1, 0, &order)));
+
+  // Make sure that the timer has expired before the reactor is first run.
+  io_context ioc2;
+  timer t2(ioc2, chronons::milliseconds(5));
+  t2.wait();
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 4);
+  if (order.size() == 4)
+  {
+    ASIO_CHECK(order[0] == 0);
+    ASIO_CHECK(order[1] == 100);
+    ASIO_CHECK(order[2] == 101);
+    ASIO_CHECK(order[3] == 102);
+  }
+#endif // !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+#endif // defined(ASIO_HAS_BOOST_DATE_TIME) || defined(ASIO_HAS_CHRONO)
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_EPOLL) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // A prioritised operation is not completed inline by the reactor ahead of
+  // the other operations that become ready on the same descriptor.
+  order.clear();
+  ioc.restart();
+  local::stream_protocol::socket s1(ioc);
+  local::stream_protocol::socket s2(ioc);
+  local::connect_pair(s1, s2);
+  s1.non_blocking(true);
+  s2.non_blocking(true);
+  char data[4096] = "";
+  asio::error_code ec;
+  while (!ec)
+    s1.write_some(asio::buffer(data), ec);
+  char read_data[1] = "";
+  s1.async_read_some(asio::buffer(read_data),
+      bindns::bind(record_io, bindns::placeholders::_1,
+        bindns::placeholders::_2, 0, &order));
+  s1.async_write_some(asio::buffer(data, 1),
+      asio::bind_executor(low_ex, bindns::bind(record_io,
+          bindns::placeholders::_1, bindns::placeholders::_2, 1, &order)));
+  ioc.poll();
+  ASIO_CHECK(order.empty());
+
+  // Make the socket both readable and writable before the reactor next runs.
+  asio::write(s2, asio::buffer(data, 1));
+  ec = asio::error_code();
+  while (!ec)
+    s2.read_some(asio::buffer(data), ec);
+
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 2);
+  if (order.size() == 2)
+  {
+    ASIO_CHECK(order[0] == 0);
+    ASIO_CHECK(order[1] == 1);
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS) && defined(ASIO_HAS_EPOLL)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // Prioritised handlers are shared between threads that steal work.
+  io_context ioc3(ASIO_CONCURRENCY_HINT_WORK_STEALING);
+  asio::detail::atomic_count atomic_count(0);
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc3);
+  std::vector<thread*> threads;
+  for (int i = 0; i < 4; ++i)
+    threads.push_back(new thread(bindns::bind(io_context_run, &ioc3)));
+  for (int i = 0; i < 100; ++i)
+  {
+    asio::post(asio::require(ioc3.get_executor(), execution::priority.high),
+        bindns::bind(atomic_increment, &atomic_count));
+    asio::post(ioc3.get_executor(),
+        bindns::bind(atomic_increment, &atomic_count));
+    asio::post(asio::require(ioc3.get_executor(), execution::priority.low),
+        bindns::bind(atomic_increment, &atomic_count));
+  }
+  w.reset();
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  ASIO_CHECK(ioc3.stopped());
+  ASIO_CHECK(atomic_count == 300);
+}
+
+void repost_until(io_context* ioc, int* count, int limit)
+{
+  if (*count < limit)
+  {
+    ++(*count);
+    asio::post(*ioc, bindns::bind(repost_until, ioc, count, limit));
+  }
+}
+
+void record_count(const asio::error_code&, int* count, int* recorded)
+{
+  *recorded = *count;
+}
+
+void spin_for_usec(int usec)
+{
+#if defined(ASIO_HAS_CHRONO)
+  asio::chrono::steady_clock::time_point end =
+    asio::chrono::steady_clock::now() + asio::chrono::microseconds(usec);
+  while (asio::chrono::steady_clock::now() < end)
+  {
+  }
+#else // defined(ASIO_HAS_CHRONO)
+  (void)usec;
+#endif // defined(ASIO_HAS_CHRONO)
+}
+
+void io_context_poll_limit_test()
+{
+  const int chains = 100;
+
+  // Without a limit, an expired timer is only noticed once the handlers queued
+  // ahead of the reactor have run, and its handler runs after those that they
+  // posted.
+  io_context ioc;
+  int count = 0;
+  for (int i = 0; i < chains; ++i)
+    asio::post(ioc, bindns::bind(repost_until, &ioc, &count, 10 * chains));
+  int timer_count = -1;
+  timer t(ioc, chronons::milliseconds(0));
+  t.async_wait(bindns::bind(record_count,
+        bindns::placeholders::_1, &count, &timer_count));
+  ioc.run();
+
+  ASIO_CHECK(count == 10 * chains);
+  ASIO_CHECK(timer_count >= 2 * chains);
+  ASIO_CHECK(ioc.handler_limit_polls() == 0);
+  ASIO_CHECK(ioc.time_limit_polls() == 0);
+
+  // With a handler limit, the reactor is polled early.
+  io_context ioc2;
+  ioc2.set_poll_handler_limit(8);
+  count = 0;
+  for (int i = 0; i < chains; ++i)
+    asio::post(ioc2, bindns::bind(repost_until, &ioc2, &count, 10 * chains));
+  timer_count = -1;
+  timer t2(ioc2, chronons::milliseconds(0));
+  t2.async_wait(bindns::bind(record_count,
+        bindns::placeholders::_1, &count, &timer_count));
+  ioc2.run();
+
+  ASIO_CHECK(count == 10 * chains);
+  ASIO_CHECK(timer_count != -1);
+  ASIO_CHECK(timer_count < 2 * chains);
+  ASIO_CHECK(ioc2.handler_limit_polls() > 0);
+  ASIO_CHECK(ioc2.time_limit_polls() == 0);
+
+#if defined(ASIO_HAS_CHRONO)
+  // With a time limit, the reactor is polled once handlers have run for long
+  // enough.
+  io_context ioc3;
+  ioc3.set_poll_time_limit(asio::chrono::milliseconds(1));
+  timer t3(ioc3, chronons::milliseconds(0));
+  t3.async_wait(bindns::bind(record_count,
+        bindns::placeholders::_1, &count, &timer_count));
+  for (int i = 0; i < 20; ++i)
+    asio::post(ioc3, bindns::bind(spin_for_usec, 500));
+  ioc3.run();
+
+  ASIO_CHECK(ioc3.time_limit_polls() > 0);
+  ASIO_CHECK(ioc3.handler_limit_polls() == 0);
+#endif // defined(ASIO_HAS_CHRONO)
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  // The reactor is not polled early while descriptors that it found ready on
+  // its previous pass are still queued.
+  io_context ioc4;
+  ioc4.set_poll_handler_limit(1);
+  run_socket_stress(ioc4);
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void check_thread(io_context* ioc, std::size_t index,
+    asio::detail::atomic_count* mismatches, asio::detail::atomic_count* count)
+{
+  if (ioc->this_thread_index() != index
+      || !ioc->get_thread_executor(index).running_in_this_thread())
+    ++(*mismatches);
+  ++(*count);
+}
+
+void post_to_each_thread(io_context* ioc, long threads,
+    asio::detail::atomic_count* arrived,
+    asio::detail::atomic_count* mismatches, asio::detail::atomic_count* count)
+{
+  // Wait until every thread is inside run(), so that each index is in use.
+  ++(*arrived);
+  while (*arrived < threads)
+    spin_for_usec(100);
+
+  if (ioc->this_thread_index() >= static_cast<std::size_t>(threads))
+    ++(*mismatches);
+
+  for (long i = 0; i < threads; ++i)
+    for (int j = 0; j < 10; ++j)
+      asio::post(ioc->get_thread_executor(i),
+          bindns::bind(check_thread, ioc, i, mismatches, count));
+}
+
+void dispatch_increment_to_current_thread(io_context* ioc, int* count)
+{
+  asio::dispatch(ioc->get_thread_executor(ioc->this_thread_index()),
+      bindns::bind(increment, count));
+  if (*count == 1)
+    ++(*count);
+}
+
+void post_prioritised_to_current_thread(io_context* ioc,
+    std::vector<int>* order)
+{
+  io_context::thread_executor_type ex =
+    ioc->get_thread_executor(ioc->this_thread_index());
+  asio::post(asio::require(ex, execution::priority.low),
+      bindns::bind(record, 0, order));
+  asio::post(ex, bindns::bind(record, 1, order));
+  asio::post(asio::require(ex, execution::priority.high),
+      bindns::bind(record, 2, order));
+}
+
+void record_thread_index(io_context* ioc,
+    std::vector<std::size_t>* indexes, asio::detail::atomic_count* count)
+{
+  indexes->push_back(ioc->this_thread_index());
+  ++(*count);
+}
+
+void io_context_thread_executor_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_THREAD_TARGETING);
+  const long threads = 4;
+
+  // A thread that is not inside run() has no index.
+  ASIO_CHECK(ioc.this_thread_index() == ~static_cast<std::size_t>(0));
+  ASIO_CHECK(ioc.get_thread_executor(0) == ioc.get_thread_executor(0));
+  ASIO_CHECK(ioc.get_thread_executor(0) != ioc.get_thread_executor(1));
+  ASIO_CHECK(!ioc.get_thread_executor(0).running_in_this_thread());
+
+  // Functions submitted to a thread are run by that thread.
+  asio::detail::atomic_count arrived(0);
+  asio::detail::atomic_count mismatches(0);
+  asio::detail::atomic_count count(0);
+  for (long i = 0; i < threads; ++i)
+    asio::post(ioc, bindns::bind(post_to_each_thread,
+          &ioc, threads, &arrived, &mismatches, &count));
+  std::vector<thread*> run_threads;
+  for (long i = 0; i < threads; ++i)
+    run_threads.push_back(new thread(bindns::bind(io_context_run, &ioc)));
+  for (std::size_t i = 0; i < run_threads.size(); ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == threads * threads * 10);
+  ASIO_CHECK(mismatches == 0);
+
+  // Functions submitted to a thread index that is not in use may be run by
+  // any thread.
+  int count2 = 0;
+  ioc.restart();
+  asio::post(ioc.get_thread_executor(7), bindns::bind(increment, &count2));
+  ioc.run();
+
+  ASIO_CHECK(count2 == 1);
+
+  // Dispatching to the current thread invokes the function immediately.
+  count2 = 0;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(dispatch_increment_to_current_thread,
+        &ioc, &count2));
+  ioc.run();
+
+  ASIO_CHECK(count2 == 2);
+
+  // Functions submitted to a thread keep their priorities.
+  std::vector<int> order;
+  ioc.restart();
+  asio::post(ioc, bindns::bind(post_prioritised_to_current_thread,
+        &ioc, &order));
+  ioc.run();
+
+  ASIO_CHECK(order.size() == 3);
+  if (order.size() == 3)
+  {
+    ASIO_CHECK(order[0] == 2);
+    ASIO_CHECK(order[1] == 1);
+    ASIO_CHECK(order[2] == 0);
+  }
+
+  // Without the hint, threads inside run() have no index, and functions
+  // submitted to a thread may be run by any thread.
+  io_context ioc2;
+  std::vector<std::size_t> indexes;
+  asio::detail::atomic_count count3(0);
+  asio::post(ioc2, bindns::bind(record_thread_index, &ioc2, &indexes, &count3));
+  asio::post(ioc2.get_thread_executor(0),
+      bindns::bind(record_thread_index, &ioc2, &indexes, &count3));
+  ioc2.run();
+
+  ASIO_CHECK(count3 == 2);
+  ASIO_CHECK(indexes.size() == 2);
+  ASIO_CHECK(indexes[0] == ~static_cast<std::size_t>(0));
+  ASIO_CHECK(indexes[1] == ~static_cast<std::size_t>(0));
+}
+
+#if !defined(ASIO_HAS_IOCP)
+
+void sleep_for_msec(int msec)
+{
+  io_context ioc;
+  timer t(ioc, chronons::milliseconds(msec));
+  t.wait();
+}
+
+void wait_for_idle_threads(asio::detail::scheduler* sched, std::size_t n)
+{
+  while (sched->idle_thread_count() != n)
+    sleep_for_msec(1);
+}
+
+void wait_for_records(asio::detail::atomic_count* count, long n)
+{
+  while (*count != n)
+    sleep_for_msec(1);
+}
+
+#endif // !defined(ASIO_HAS_IOCP)
+
+void io_context_lifo_wake_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_LIFO_WAKE);
+  int count = 0;
+
+  asio::post(ioc, bindns::bind(increment, &count));
+
+  // No handlers can be called until run() is called.
+  ASIO_CHECK(!ioc.stopped());
+  ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  // The run() call will not return until all work has finished.
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+#if !defined(ASIO_HAS_IOCP)
+  // A handler posted to a pool of idle threads is run by the thread that most
+  // recently ran out of work. The threads are made idle in a known order by
+  // giving each one a function in turn.
+  const int threads = 4;
+  std::vector<std::size_t> indexes;
+  asio::detail::atomic_count record_count(0);
+  asio::detail::scheduler& sched =
+    asio::use_service<asio::detail::scheduler>(ioc);
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  std::vector<thread*> run_threads;
+  for (int i = 0; i < threads; ++i)
+    run_threads.push_back(new thread(bindns::bind(io_context_run, &ioc)));
+  wait_for_idle_threads(&sched, threads);
+
+  const int order[] = { 2, 0, 3, 1 };
+  for (int i = 0; i < threads; ++i)
+  {
+    asio::post(ioc.get_thread_executor(order[i]),
+        bindns::bind(record_thread_index, &ioc, &indexes, &record_count));
+    wait_for_records(&record_count, i + 1);
+    wait_for_idle_threads(&sched, threads);
+  }
+
+  for (int i = 0; i < 3; ++i)
+  {
+    asio::post(ioc, bindns::bind(record_thread_index,
+          &ioc, &indexes, &record_count));
+    wait_for_records(&record_count, threads + i + 1);
+    wait_for_idle_threads(&sched, threads);
+  }
+
+  asio::post(ioc.get_thread_executor(order[0]),
+      bindns::bind(record_thread_index, &ioc, &indexes, &record_count));
+  wait_for_records(&record_count, threads + 4);
+  wait_for_idle_threads(&sched, threads);
+  asio::post(ioc, bindns::bind(record_thread_index,
+        &ioc, &indexes, &record_count));
+  wait_for_records(&record_count, threads + 5);
+
+  ASIO_CHECK(indexes.size() == static_cast<std::size_t>(threads + 5));
+  if (indexes.size() == static_cast<std::size_t>(threads + 5))
+  {
+    for (int i = 0; i < threads; ++i)
+      ASIO_CHECK(indexes[i] == static_cast<std::size_t>(order[i]));
+
+    // The last thread to become idle is woken each time.
+    for (int i = threads; i < threads + 3; ++i)
+      ASIO_CHECK(indexes[i] == static_cast<std::size_t>(order[threads - 1]));
+
+    // Waking a thread for a function moves it to the top of the stack.
+    ASIO_CHECK(indexes[threads + 3] == static_cast<std::size_t>(order[0]));
+    ASIO_CHECK(indexes[threads + 4] == static_cast<std::size_t>(order[0]));
+  }
+
+  // Functions submitted to a thread still run on that thread.
+  asio::detail::atomic_count arrived(0);
+  asio::detail::atomic_count mismatches(0);
+  asio::detail::atomic_count targeted_count(0);
+  for (int i = 0; i < threads; ++i)
+    asio::post(ioc, bindns::bind(post_to_each_thread, &ioc,
+          static_cast<long>(threads), &arrived, &mismatches, &targeted_count));
+
+  w.reset();
+  for (std::size_t i = 0; i < run_threads.size(); ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(targeted_count == threads * threads * 10);
+  ASIO_CHECK(mismatches == 0);
+#endif // !defined(ASIO_HAS_IOCP)
+}
+
+#if defined(ASIO_HAS_PIPE)
+
+void wait_for_arrivals(long threads, asio::detail::atomic_count* arrived)
+{
+  ++(*arrived);
+  while (*arrived < threads)
+    spin_for_usec(100);
+}
+
+void read_on_owner(const asio::error_code& ec, io_context* ioc,
+    readable_pipe* pipe, char* data, std::size_t* owner,
+    asio::detail::atomic_count* mismatches, asio::detail::atomic_count* count)
+{
+  if (ec)
+    return;
+
+  if (*owner == ~static_cast<std::size_t>(0))
+    *owner = ioc->this_thread_index();
+  else if (*owner != ioc->this_thread_index())
+    ++(*mismatches);
+
+  pipe->async_read_some(asio::buffer(data, 1),
+      bindns::bind(read_on_owner, bindns::placeholders::_1,
+        ioc, pipe, data, owner, mismatches, count));
+  ++(*count);
+}
+
+#endif // defined(ASIO_HAS_PIPE)
+
+void io_context_sharded_reactor_test()
+{
+  io_context ioc(ASIO_CONCURRENCY_HINT_SHARDED_REACTOR);
+  int count = 0;
+
+  asio::post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(count == 1);
+
+#if defined(ASIO_HAS_PIPE) && defined(ASIO_HAS_EPOLL) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Wait until every thread is inside run(), so that the pipes opened below
+  // are shared out among the threads' shards.
+  const long threads = 4;
+  asio::detail::atomic_count arrived(0);
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  std::vector<thread*> run_threads;
+  for (long i = 0; i < threads; ++i)
+  {
+    asio::post(ioc, bindns::bind(wait_for_arrivals, threads, &arrived));
+    run_threads.push_back(new thread(bindns::bind(io_context_run, &ioc)));
+  }
+  while (arrived < threads)
+    spin_for_usec(100);
+
+  // Each read completes on the thread that owns the pipe's shard.
+  const int pipes = 8;
+  const int writes = 10;
+  readable_pipe* readers[pipes];
+  writable_pipe* writers[pipes];
+  char data[pipes];
+  std::size_t owners[pipes];
+  asio::detail::atomic_count mismatches(0);
+  asio::detail::atomic_count read_count(0);
+  for (int i = 0; i < pipes; ++i)
+  {
+    readers[i] = new readable_pipe(ioc);
+    writers[i] = new writable_pipe(ioc);
+    connect_pipe(*readers[i], *writers[i]);
+    owners[i] = ~static_cast<std::size_t>(0);
+    readers[i]->async_read_some(asio::buffer(&data[i], 1),
+        bindns::bind(read_on_owner, bindns::placeholders::_1, &ioc,
+          readers[i], &data[i], &owners[i], &mismatches, &read_count));
+  }
+
+  for (int j = 0; j < writes; ++j)
+  {
+    for (int i = 0; i < pipes; ++i)
+      writers[i]->write_some(asio::buffer("x", 1));
+    while (read_count < (j + 1) * pipes)
+      spin_for_usec(100);
+  }
+
+  for (int i = 0; i < pipes; ++i)
+  {
+    readers[i]->close();
+    writers[i]->close();
+  }
+  w.reset();
+  for (std::size_t i = 0; i < run_threads.size(); ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+  }
+  for (int i = 0; i < pipes; ++i)
+  {
+    delete readers[i];
+    delete writers[i];
+  }
+
+  ASIO_CHECK(ioc.stopped());
+  ASIO_CHECK(read_count == pipes * writes);
+  ASIO_CHECK(mismatches == 0);
+  int shards_used = 0;
+  for (int i = 0; i < pipes; ++i)
+  {
+    bool first = true;
+    for (int j = 0; j < i; ++j)
+      if (owners[j] == owners[i])
+        first = false;
+    if (first)
+      ++shards_used;
+  }
+  ASIO_CHECK(shards_used > 1);
+#endif // defined(ASIO_HAS_PIPE) && defined(ASIO_HAS_EPOLL)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void record_result(const asio::error_code& ec, std::size_t n,
+    asio::error_code* out_ec, std::size_t* out_n)
+{
+  *out_ec = ec;
+  *out_n = n;
+}
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void read_all(const asio::error_code& ec, std::size_t n,
+    local::stream_protocol::socket* socket, char* buf, std::size_t buf_size,
+    std::vector<char>* received, std::size_t total,
+    asio::detail::atomic_count* done)
+{
+  if (ec)
+    return;
+
+  received->insert(received->end(), buf, buf + n);
+  if (received->size() < total)
+  {
+    socket->async_read_some(asio::buffer(buf, buf_size),
+        bindns::bind(read_all, bindns::placeholders::_1,
+          bindns::placeholders::_2, socket, buf, buf_size,
+          received, total, done));
+  }
+  else
+    ++(*done);
+}
+
+void write_all(const asio::error_code& ec, std::size_t,
+    asio::detail::atomic_count* done)
+{
+  if (!ec)
+    ++(*done);
+}
+
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+
+void io_context_lockfree_descriptors_test()
+{
+#if defined(ASIO_HAS_PIPE)
+  {
+    // A second read moves the read parked in the slot to the queue, and both
+    // complete in order.
+    io_context ioc(ASIO_CONCURRENCY_HINT_LOCKFREE_DESCRIPTORS);
+    readable_pipe reader(ioc);
+    writable_pipe writer(ioc);
+    connect_pipe(reader, writer);
+
+    char data[2] = { 0, 0 };
+    asio::error_code ec1, ec2;
+    std::size_t n1 = 0, n2 = 0;
+    reader.async_read_some(asio::buffer(&data[0], 1),
+        bindns::bind(record_result, bindns::placeholders::_1,
+          bindns::placeholders::_2, &ec1, &n1));
+    reader.async_read_some(asio::buffer(&data[1], 1),
+        bindns::bind(record_result, bindns::placeholders::_1,
+          bindns::placeholders::_2, &ec2, &n2));
+    writer.write_some(asio::buffer("ab", 2));
+    ioc.run();
+
+    ASIO_CHECK(!ec1);
+    ASIO_CHECK(n1 == 1);
+    ASIO_CHECK(!ec2);
+    ASIO_CHECK(n2 == 1);
+    ASIO_CHECK(data[0] == 'a');
+    ASIO_CHECK(data[1] == 'b');
+
+    // Once the queue is empty the slot is used again, and a parked read can
+    // be cancelled.
+    ioc.restart();
+    n1 = ~static_cast<std::size_t>(0);
+    reader.async_read_some(asio::buffer(&data[0], 1),
+        bindns::bind(record_result, bindns::placeholders::_1,
+          bindns::placeholders::_2, &ec1, &n1));
+    ioc.poll();
+    ASIO_CHECK(n1 == ~static_cast<std::size_t>(0));
+    reader.cancel();
+    ioc.run();
+
+    ASIO_CHECK(ec1 == asio::error::operation_aborted);
+    ASIO_CHECK(n1 == 0);
+
+    ioc.restart();
+    reader.async_read_some(asio::buffer(&data[0], 1),
+        bindns::bind(record_result, bindns::placeholders::_1,
+          bindns::placeholders::_2, &ec1, &n1));
+    writer.write_some(asio::buffer("c", 1));
+    ioc.run();
+
+    ASIO_CHECK(!ec1);
+    ASIO_CHECK(n1 == 1);
+    ASIO_CHECK(data[0] == 'c');
+  }
+#endif // defined(ASIO_HAS_PIPE)
+
+#if defined(ASIO_HAS_LOCAL_SOCKETS)
+  // Both ends of several connections read and write at the same time, from a
+  // number of threads, with more data than fits in the socket buffers.
+  io_context ioc(ASIO_CONCURRENCY_HINT_LOCKFREE_DESCRIPTORS);
+  const int pairs = 4;
+  const std::size_t total = 256 * 1024;
+  const std::size_t buf_size = 1000;
+  std::vector<char> sent[pairs * 2];
+  std::vector<char> received[pairs * 2];
+  std::vector<char> bufs[pairs * 2];
+  local::stream_protocol::socket* sockets[pairs * 2];
+  asio::detail::atomic_count done(0);
+  for (int i = 0; i < pairs * 2; ++i)
+  {
+    sockets[i] = new local::stream_protocol::socket(ioc);
+    for (std::size_t j = 0; j < total; ++j)
+      sent[i].push_back(static_cast<char>(j * (i + 3) + (j >> 10)));
+    received[i].reserve(total);
+    bufs[i].resize(buf_size);
+  }
+  for (int i = 0; i < pairs; ++i)
+    local::connect_pair(*sockets[i * 2], *sockets[i * 2 + 1]);
+
+  for (int i = 0; i < pairs * 2; ++i)
+  {
+    sockets[i]->async_read_some(asio::buffer(bufs[i]),
+        bindns::bind(read_all, bindns::placeholders::_1,
+          bindns::placeholders::_2, sockets[i], &bufs[i][0], buf_size,
+          &received[i], total, &done));
+    asio::async_write(*sockets[i], asio::buffer(sent[i]),
+        bindns::bind(write_all, bindns::placeholders::_1,
+          bindns::placeholders::_2, &done));
+  }
+
+  std::vector<thread*> run_threads;
+  for (int i = 0; i < 4; ++i)
+    run_threads.push_back(new thread(bindns::bind(io_context_run, &ioc)));
+  for (std::size_t i = 0; i < run_threads.size(); ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+  }
+
+  ASIO_CHECK(done == pairs * 4);
+  for (int i = 0; i < pairs * 2; ++i)
+  {
+    ASIO_CHECK(received[i] == sent[i ^ 1]);
+    delete sockets[i];
+  }
+#endif // defined(ASIO_HAS_LOCAL_SOCKETS)
+}
+
+#if defined(ASIO_HAS_EPOLL)
+
+// Returns 1 if the descriptor is in the epoll set of any epoll descriptor in
+// the process, 0 if not, and -1 if this cannot be determined.
+int in_epoll_set(int descriptor)
+{
+  std::ifstream self("/proc/self/fdinfo/0");
+  if (!self)
+    return -1;
+
+  for (int fd = 0; fd < 1024; ++fd)
+  {
+    std::ostringstream path;
+    path << "/proc/self/fdinfo/" << fd;
+    std::ifstream info(path.str().c_str());
+    std::string word;
+    while (info >> word)
+    {
+      int target = -1;
+      if (word == "tfd:" && info >> target && target == descriptor)
+        return 1;
+    }
+  }
+
+  return 0;
+}
+
+#endif // defined(ASIO_HAS_EPOLL)
+
+void io_context_lazy_registration_test()
+{
+#if defined(ASIO_HAS_PIPE)
+  io_context ioc(ASIO_CONCURRENCY_HINT_LAZY_REGISTRATION);
+  readable_pipe reader(ioc);
+  writable_pipe writer(ioc);
+  connect_pipe(reader, writer);
+
+  // Operations that complete immediately do not register the descriptors.
+  char data[2] = { 0, 0 };
+  asio::error_code ec;
+  std::size_t n = 0;
+  writer.async_write_some(asio::buffer("ab", 2),
+      bindns::bind(record_result, bindns::placeholders::_1,
+        bindns::placeholders::_2, &ec, &n));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 2);
+
+  ioc.restart();
+  reader.async_read_some(asio::buffer(data, 2),
+      bindns::bind(record_result, bindns::placeholders::_1,
+        bindns::placeholders::_2, &ec, &n));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 2);
+  ASIO_CHECK(data[0] == 'a');
+  ASIO_CHECK(data[1] == 'b');
+
+#if defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  int reader_registered = in_epoll_set(reader.native_handle());
+  int writer_registered = in_epoll_set(writer.native_handle());
+  ASIO_CHECK(reader_registered != 1);
+  ASIO_CHECK(writer_registered != 1);
+#endif // defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // An operation that has to wait registers the descriptor, and completes
+  // when the descriptor becomes ready.
+  ioc.restart();
+  n = ~static_cast<std::size_t>(0);
+  reader.async_read_some(asio::buffer(data, 1),
+      bindns::bind(record_result, bindns::placeholders::_1,
+        bindns::placeholders::_2, &ec, &n));
+  ioc.poll();
+
+  ASIO_CHECK(n == ~static_cast<std::size_t>(0));
+#if defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  if (reader_registered != -1)
+    ASIO_CHECK(in_epoll_set(reader.native_handle()) == 1);
+#endif // defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  writer.write_some(asio::buffer("c", 1));
+  ioc.run();
+
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(n == 1);
+  ASIO_CHECK(data[0] == 'c');
+#endif // defined(ASIO_HAS_PIPE)
+}
+
+void count_read(const asio::error_code& ec, int* count)
+{
+  if (!ec)
+    ++(*count);
+}
+
+#if defined(ASIO_HAS_PIPE)
+
+void make_ready_pipes(io_context* ioc, int n,
+    std::vector<readable_pipe*>* readers,
+    std::vector<writable_pipe*>* writers, char* data, int* count)
+{
+  for (int i = 0; i < n; ++i)
+  {
+    readers->push_back(new readable_pipe(*ioc));
+    writers->push_back(new writable_pipe(*ioc));
+    connect_pipe(*readers->back(), *writers->back());
+    readers->back()->async_read_some(asio::buffer(&data[i], 1),
+        bindns::bind(count_read, bindns::placeholders::_1, count));
+  }
+  for (int i = 0; i < n; ++i)
+    (*writers)[i]->write_some(asio::buffer("x", 1));
+}
+
+void delete_pipes(std::vector<readable_pipe*>* readers,
+    std::vector<writable_pipe*>* writers)
+{
+  for (std::size_t i = 0; i < readers->size(); ++i)
+  {
+    delete (*readers)[i];
+    delete (*writers)[i];
+  }
+  readers->clear();
+  writers->clear();
+}
+
+#endif // defined(ASIO_HAS_PIPE)
+
+void io_context_reactor_statistics_test()
+{
+#if defined(ASIO_HAS_EPOLL) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+  && defined(ASIO_HAS_PIPE)
+  const int pipes = 300;
+  std::vector<readable_pipe*> readers;
+  std::vector<writable_pipe*> writers;
+  char data[pipes];
+  int count = 0;
+
+  // Statistics are only kept when requested.
+  {
+    io_context ioc(ASIO_CONCURRENCY_HINT_SAFE);
+    make_ready_pipes(&ioc, 1, &readers, &writers, data, &count);
+    ioc.run();
+
+    ASIO_CHECK(count == 1);
+    ASIO_CHECK(ioc.reactor_waits() == 0);
+    ASIO_CHECK(ioc.reactor_events() == 0);
+    delete_pipes(&readers, &writers);
+  }
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_REACTOR_STATISTICS);
+
+  ASIO_CHECK(ioc.reactor_waits() == 0);
+  ASIO_CHECK(ioc.reactor_events() == 0);
+
+  // More descriptors become ready at once than fit in the initial batch, so
+  // that at least one wait fills it.
+  count = 0;
+  make_ready_pipes(&ioc, pipes, &readers, &writers, data, &count);
+  ioc.run();
+
+  ASIO_CHECK(count == pipes);
+  ASIO_CHECK(ioc.reactor_waits() >= 2);
+  ASIO_CHECK(ioc.reactor_full_waits() >= 1);
+  ASIO_CHECK(ioc.reactor_events() >= static_cast<std::size_t>(pipes));
+  ASIO_CHECK(ioc.reactor_empty_waits() < ioc.reactor_waits());
+#if !defined(ASIO_HAS_THREADS) || defined(ASIO_HAS_STD_ATOMIC)
+  // Delays are only measured when the counters can be updated atomically.
+  ASIO_CHECK(ioc.reactor_dispatch_samples() >= 1);
+#endif // !defined(ASIO_HAS_THREADS) || defined(ASIO_HAS_STD_ATOMIC)
+  ASIO_CHECK(ioc.reactor_dispatch_samples() <= ioc.reactor_waits());
+  delete_pipes(&readers, &writers);
+
+  // The waits of a sharded reactor's shards are counted too. Pipes opened
+  // inside run() are placed on the running thread's shard.
+  const int sharded_pipes = 8;
+  io_context ioc2(ASIO_CONCURRENCY_HINT_SHARDED_REACTOR
+      | ASIO_CONCURRENCY_HINT_REACTOR_STATISTICS);
+  count = 0;
+  asio::post(ioc2, bindns::bind(make_ready_pipes, &ioc2, sharded_pipes,
+        &readers, &writers, data, &count));
+  ioc2.run();
+
+  ASIO_CHECK(count == sharded_pipes);
+  ASIO_CHECK(ioc2.reactor_events() >= static_cast<std::size_t>(sharded_pipes));
+  delete_pipes(&readers, &writers);
+#endif // defined(ASIO_HAS_EPOLL)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //   && defined(ASIO_HAS_PIPE)
+}
+
+void io_context_watchdog_test()
+{
+#if defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+  using asio::detail::handler_watchdog;
+
+  io_context ioc;
+  int count = 0;
+  asio::post(ioc, bindns::bind(increment, &count));
+  ioc.run();
+  std::size_t slots = handler_watchdog::slot_count();
+
+  // Each thread that runs a handler is given a slot, which is reused by later
+  // threads once the thread has exited.
+  for (int i = 0; i < 16; ++i)
+  {
+    ioc.restart();
+    asio::post(ioc, bindns::bind(increment, &count));
+    thread t(bindns::bind(io_context_run, &ioc));
+    t.join();
+  }
+
+  ASIO_CHECK(count == 17);
+  ASIO_CHECK(handler_watchdog::slot_count() <= slots + 1);
+#endif // defined(ASIO_ENABLE_HANDLER_WATCHDOG)
+}
+
 class test_service : public asio::io_context::service
 {
 public:
@@ -579,6 +2027,19 @@ ASIO_TEST_SUITE
 (
   "io_context",
   ASIO_TEST_CASE(io_context_test)
+  ASIO_TEST_CASE(io_context_work_stealing_test)
+  ASIO_TEST_CASE(io_context_lockfree_post_test)
+  ASIO_TEST_CASE(io_context_busy_poll_test)
+  ASIO_TEST_CASE(io_context_post_batch_test)
+  ASIO_TEST_CASE(io_context_priority_test)
+  ASIO_TEST_CASE(io_context_poll_limit_test)
+  ASIO_TEST_CASE(io_context_thread_executor_test)
+  ASIO_TEST_CASE(io_context_lifo_wake_test)
+  ASIO_TEST_CASE(io_context_sharded_reactor_test)
+  ASIO_TEST_CASE(io_context_lockfree_descriptors_test)
+  ASIO_TEST_CASE(io_context_lazy_registration_test)
+  ASIO_TEST_CASE(io_context_reactor_statistics_test)
+  ASIO_TEST_CASE(io_context_watchdog_test)
   ASIO_TEST_CASE(io_context_service_test)
   ASIO_TEST_CASE(io_context_executor_query_test)
   ASIO_TEST_CASE(io_context_executor_execute_test)
@@ -0,0 +1,153 @@
+//
+// io_context_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/io_context_pool.hpp"
+
+#include "asio/executor_work_guard.hpp"
+#include "asio/post.hpp"
+#include "unit_test.hpp"
+
+#if defined(ASIO_HAS_BOOST_BIND)
+# include <boost/bind/bind.hpp>
+#else // defined(ASIO_HAS_BOOST_BIND)
+# include <functional>
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+using namespace asio;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif
+
+void increment(asio::detail::atomic_count* count)
+{
+  ++(*count);
+}
+
+void check_running_in_this_thread(io_context* ioc,
+    io_context* other, asio::detail::atomic_count* count)
+{
+  ASIO_CHECK(ioc->get_executor().running_in_this_thread());
+  ASIO_CHECK(!other->get_executor().running_in_this_thread());
+  ++(*count);
+}
+
+void decrement_to_zero(io_context_pool::executor_type ex, int* count)
+{
+  if (*count > 0)
+  {
+    --(*count);
+
+    int before_value = *count;
+    asio::post(ex, bindns::bind(decrement_to_zero, ex, count));
+
+    // Handler execution cannot nest, so count value should remain unchanged.
+    ASIO_CHECK(*count == before_value);
+  }
+}
+
+void io_context_pool_test()
+{
+  io_context_pool pool(4);
+  ASIO_CHECK(pool.size() == 4);
+
+  asio::detail::atomic_count count(0);
+  for (int i = 0; i < 100; ++i)
+    asio::post(pool.get_executor(), bindns::bind(increment, &count));
+
+  int count2 = 10;
+  io_context_pool::executor_type ex = pool.get_executor();
+  asio::post(ex, bindns::bind(decrement_to_zero, ex, &count2));
+
+  // Each io_context is run by its own thread.
+  asio::post(pool.get_io_context_at(0),
+      bindns::bind(check_running_in_this_thread,
+        &pool.get_io_context_at(0), &pool.get_io_context_at(1), &count));
+  asio::post(pool.get_io_context_at(1),
+      bindns::bind(check_running_in_this_thread,
+        &pool.get_io_context_at(1), &pool.get_io_context_at(0), &count));
+
+  pool.join();
+
+  // The join() call will not return until all work has finished.
+  ASIO_CHECK(count == 102);
+  ASIO_CHECK(count2 == 0);
+  for (std::size_t i = 0; i < pool.size(); ++i)
+  {
+    ASIO_CHECK(pool.get_io_context_at(i).stopped());
+    ASIO_CHECK(pool.load(i) == 0);
+  }
+
+  // Round-robin selection visits each io_context in turn.
+  ASIO_CHECK(pool.selections(0) == 26);
+  ASIO_CHECK(pool.selections(1) == 25);
+  ASIO_CHECK(pool.selections(2) == 25);
+  ASIO_CHECK(pool.selections(3) == 25);
+}
+
+void io_context_pool_least_loaded_test()
+{
+  io_context_pool pool(3, false);
+
+  // Outstanding work on an io_context counts towards its load.
+  executor_work_guard<io_context_pool::executor_type> w1 =
+    make_work_guard(pool.get_io_context_at(0));
+  executor_work_guard<io_context_pool::executor_type> w2 =
+    make_work_guard(pool.get_io_context_at(2));
+  ASIO_CHECK(pool.load(0) == 1);
+  ASIO_CHECK(pool.load(1) == 0);
+  ASIO_CHECK(pool.load(2) == 1);
+
+  for (int i = 0; i < 10; ++i)
+  {
+    ASIO_CHECK(&pool.get_io_context(io_context_pool::least_loaded)
+        == &pool.get_io_context_at(1));
+  }
+
+  ASIO_CHECK(pool.selections(0) == 0);
+  ASIO_CHECK(pool.selections(1) == 10);
+  ASIO_CHECK(pool.selections(2) == 0);
+
+  w1.reset();
+  w2.reset();
+}
+
+void io_context_pool_stop_test()
+{
+  io_context_pool pool(2);
+
+  // Work guards keep the pool running until it is stopped.
+  executor_work_guard<io_context_pool::executor_type> w1 =
+    make_work_guard(pool.get_io_context_at(0));
+  executor_work_guard<io_context_pool::executor_type> w2 =
+    make_work_guard(pool.get_io_context_at(1));
+
+  pool.stop();
+  pool.join();
+
+  ASIO_CHECK(pool.get_io_context_at(0).stopped());
+  ASIO_CHECK(pool.get_io_context_at(1).stopped());
+}
+
+ASIO_TEST_SUITE
+(
+  "io_context_pool",
+  ASIO_TEST_CASE(io_context_pool_test)
+  ASIO_TEST_CASE(io_context_pool_least_loaded_test)
+  ASIO_TEST_CASE(io_context_pool_stop_test)
+)
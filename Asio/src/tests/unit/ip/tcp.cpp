@@ -19,9 +19,13 @@
 // Test that header file is self-contained.
 #include "asio/ip/tcp.hpp"
 
+#include <cstdlib>
 #include <cstring>
+#include <vector>
 #include "asio/io_context.hpp"
 #include "asio/read.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/thread.hpp"
 #include "asio/write.hpp"
 #include "../unit_test.hpp"
 #include "../archetypes/async_result.hpp"
@@ -35,6 +39,10 @@
 # include <array>
 #endif // defined(ASIO_HAS_BOOST_ARRAY)
 
+#if defined(ASIO_HAS_IO_URING)
+# include <sys/resource.h>
+#endif // defined(ASIO_HAS_IO_URING)
+
 #if defined(ASIO_HAS_BOOST_BIND)
 # include <boost/bind/bind.hpp>
 #else // defined(ASIO_HAS_BOOST_BIND)
@@ -588,6 +596,111 @@ void handle_read_eof(const asio::error_code& err,
   ASIO_CHECK(bytes_transferred == 0);
 }
 
+#if !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+template <typename T>
+struct counting_allocator
+{
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind
+  {
+    typedef counting_allocator<U> other;
+  };
+
+  explicit counting_allocator(int* count)
+    : count_(count)
+  {
+  }
+
+  template <typename U>
+  counting_allocator(const counting_allocator<U>& other)
+    : count_(other.count_)
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++*count_;
+    return static_cast<T*>(::operator new(sizeof(T) * n));
+  }
+
+  void deallocate(T* p, std::size_t)
+  {
+    ::operator delete(p);
+  }
+
+  bool operator==(const counting_allocator& other) const
+  {
+    return count_ == other.count_;
+  }
+
+  bool operator!=(const counting_allocator& other) const
+  {
+    return count_ != other.count_;
+  }
+
+  int* count_;
+};
+
+struct read_loop_provider
+{
+  read_loop_provider(char* data, std::size_t chunk_size, std::size_t* offset)
+    : data_(data),
+      chunk_size_(chunk_size),
+      offset_(offset)
+  {
+  }
+
+  asio::mutable_buffer operator()()
+  {
+    return asio::buffer(data_ + *offset_, chunk_size_);
+  }
+
+  char* data_;
+  std::size_t chunk_size_;
+  std::size_t* offset_;
+};
+
+struct read_loop_handler
+{
+  typedef counting_allocator<void> allocator_type;
+
+  read_loop_handler(std::size_t* offset, std::size_t stop_after,
+      int* calls, asio::error_code* last_error, int* allocations)
+    : offset_(offset),
+      stop_after_(stop_after),
+      calls_(calls),
+      last_error_(last_error),
+      allocations_(allocations)
+  {
+  }
+
+  bool operator()(const asio::error_code& err, std::size_t bytes_transferred)
+  {
+    ++*calls_;
+    *last_error_ = err;
+    *offset_ += bytes_transferred;
+    return *offset_ < stop_after_;
+  }
+
+  allocator_type get_allocator() const
+  {
+    return allocator_type(allocations_);
+  }
+
+  std::size_t* offset_;
+  std::size_t stop_after_;
+  int* calls_;
+  asio::error_code* last_error_;
+  int* allocations_;
+};
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
 void test()
 {
   using namespace std; // For memcmp.
@@ -676,6 +789,74 @@ void test()
   ioc.run();
   ASIO_CHECK(read_cancel_completed);
 
+#if !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // A read loop reuses one operation for many small reads.
+
+  char loop_buffer[sizeof(write_data) * 3];
+  std::size_t loop_offset = 0;
+  int loop_calls = 0;
+  int loop_allocations = 0;
+  asio::error_code loop_error;
+
+  for (int i = 0; i < 3; ++i)
+    asio::write(server_side_socket, asio::buffer(write_data));
+
+  client_side_socket.async_read_loop(
+      read_loop_provider(loop_buffer, 16, &loop_offset),
+      read_loop_handler(&loop_offset, sizeof(loop_buffer),
+        &loop_calls, &loop_error, &loop_allocations));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(!loop_error);
+  ASIO_CHECK(loop_offset == sizeof(loop_buffer));
+  ASIO_CHECK(loop_calls >= static_cast<int>(sizeof(loop_buffer) / 16));
+  ASIO_CHECK(loop_allocations == 1);
+  for (int i = 0; i < 3; ++i)
+  {
+    ASIO_CHECK(memcmp(loop_buffer + i * sizeof(write_data),
+          write_data, sizeof(write_data)) == 0);
+  }
+
+  // A cancelled read loop ends with operation_aborted.
+
+  loop_offset = 0;
+  loop_calls = 0;
+  client_side_socket.async_read_loop(
+      read_loop_provider(loop_buffer, 16, &loop_offset),
+      read_loop_handler(&loop_offset, sizeof(loop_buffer),
+        &loop_calls, &loop_error, &loop_allocations));
+
+  ioc.restart();
+  ioc.poll();
+  ASIO_CHECK(loop_calls == 0);
+
+  client_side_socket.cancel();
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(loop_calls == 1);
+  ASIO_CHECK(loop_error == asio::error::operation_aborted);
+
+  // A read loop whose provider returns an empty buffer ends at once.
+
+  loop_offset = 0;
+  loop_calls = 0;
+  client_side_socket.async_read_loop(
+      read_loop_provider(loop_buffer, 0, &loop_offset),
+      read_loop_handler(&loop_offset, sizeof(loop_buffer),
+        &loop_calls, &loop_error, &loop_allocations));
+
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(loop_calls == 1);
+  ASIO_CHECK(loop_error == asio::error::no_buffer_space);
+#endif // !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
   // A read when the peer closes socket should fail with eof.
 
   bool read_eof_completed = false;
@@ -745,6 +926,27 @@ struct move_accept_ioc_handler
 private:
   move_accept_ioc_handler(const move_accept_handler&) {}
 };
+
+struct accept_many_handler
+{
+  accept_many_handler() {}
+  void operator()(const asio::error_code&,
+      std::vector<asio::ip::tcp::socket>) {}
+  accept_many_handler(accept_many_handler&&) {}
+private:
+  accept_many_handler(const accept_many_handler&) {}
+};
+
+struct accept_many_ioc_handler
+{
+  accept_many_ioc_handler() {}
+  void operator()(const asio::error_code&,
+      std::vector<asio::basic_stream_socket<asio::ip::tcp,
+        asio::io_context::executor_type> >) {}
+  accept_many_ioc_handler(accept_many_ioc_handler&&) {}
+private:
+  accept_many_ioc_handler(const accept_many_ioc_handler&) {}
+};
 #endif // defined(ASIO_HAS_MOVE)
 
 void test()
@@ -936,6 +1138,20 @@ void test()
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_handler());
     acceptor1.async_accept(ioc_ex, peer_endpoint, move_accept_ioc_handler());
 #endif // defined(ASIO_HAS_MOVE)
+
+#if defined(ASIO_HAS_MOVE) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+    acceptor1.async_accept_many(16, accept_many_handler());
+    acceptor1.async_accept_many(16, ioc, accept_many_ioc_handler());
+    acceptor1.async_accept_many(16, ioc_ex, accept_many_ioc_handler());
+    int i6 = acceptor1.async_accept_many(16, lazy);
+    (void)i6;
+#endif // defined(ASIO_HAS_MOVE)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
   }
   catch (std::exception&)
   {
@@ -963,6 +1179,36 @@ void handle_connect(const asio::error_code& err)
   ASIO_CHECK(!err);
 }
 
+#if defined(ASIO_HAS_MOVE) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+struct accept_many_handler
+{
+  accept_many_handler(std::vector<std::size_t>* batches,
+      asio::error_code* last_error)
+    : batches_(batches),
+      last_error_(last_error)
+  {
+  }
+
+  void operator()(const asio::error_code& err,
+      std::vector<asio::ip::tcp::socket> peers)
+  {
+    *last_error_ = err;
+    batches_->push_back(peers.size());
+    for (std::size_t i = 0; i < peers.size(); ++i)
+      ASIO_CHECK(peers[i].is_open());
+  }
+
+  std::vector<std::size_t>* batches_;
+  asio::error_code* last_error_;
+};
+#endif // defined(ASIO_HAS_MOVE)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+
 void test()
 {
   using namespace asio;
@@ -1019,12 +1265,892 @@ void test()
   server_side_remote_endpoint = server_side_socket.remote_endpoint();
   ASIO_CHECK(server_side_remote_endpoint.port()
       == client_endpoint.port());
+
+#if defined(ASIO_HAS_MOVE) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // All connections that are already pending are delivered in one batch.
+  std::vector<std::size_t> batches;
+  asio::error_code last_error;
+  std::vector<ip::tcp::socket> clients;
+  for (int i = 0; i < 5; ++i)
+  {
+    clients.push_back(ip::tcp::socket(ioc));
+    clients.back().connect(server_endpoint);
+  }
+
+  acceptor.async_accept_many(16,
+      accept_many_handler(&batches, &last_error));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!last_error);
+  ASIO_CHECK(batches.size() == 1);
+  ASIO_CHECK(batches.size() == 1 && batches[0] == 5);
+
+  // A batch stops at the limit, leaving the remaining connections pending.
+  batches.clear();
+  for (int i = 0; i < 3; ++i)
+  {
+    clients.push_back(ip::tcp::socket(ioc));
+    clients.back().connect(server_endpoint);
+  }
+
+  acceptor.async_accept_many(2,
+      accept_many_handler(&batches, &last_error));
+
+  ioc.restart();
+  ioc.run();
+
+  acceptor.async_accept_many(2,
+      accept_many_handler(&batches, &last_error));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!last_error);
+  ASIO_CHECK(batches.size() == 2);
+  ASIO_CHECK(batches.size() == 2 && batches[0] == 2 && batches[1] == 1);
+
+  // A limit of zero is rejected.
+  batches.clear();
+  acceptor.async_accept_many(0,
+      accept_many_handler(&batches, &last_error));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(last_error == asio::error::invalid_argument);
+  ASIO_CHECK(batches.size() == 1 && batches[0] == 0);
+
+  // A limit too large to reserve space for is reduced.
+  batches.clear();
+  clients.push_back(ip::tcp::socket(ioc));
+  clients.back().connect(server_endpoint);
+
+  acceptor.async_accept_many(~static_cast<std::size_t>(0),
+      accept_many_handler(&batches, &last_error));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(!last_error);
+  ASIO_CHECK(batches.size() == 1 && batches[0] == 1);
+#endif // defined(ASIO_HAS_MOVE)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
 }
 
 } // namespace ip_tcp_acceptor_runtime
 
 //------------------------------------------------------------------------------
 
+// ip_tcp_acceptor_group_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the
+// ip::tcp::acceptor_group class.
+
+namespace ip_tcp_acceptor_group_runtime {
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void handle_accept(const asio::error_code& err,
+    asio::ip::tcp::acceptor* acceptor, asio::ip::tcp::socket* peer,
+    int* count)
+{
+  if (err)
+    return;
+
+  ++(*count);
+  peer->close();
+  acceptor->async_accept(*peer, bindns::bind(
+        handle_accept, bindns::placeholders::_1, acceptor, peer, count));
+}
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+
+void run_context(asio::io_context* ioc)
+{
+  ioc->run();
+}
+
+void wait_for_count(asio::detail::atomic_count* count, long n)
+{
+  asio::io_context ioc;
+  while (*count < n)
+  {
+    asio::steady_timer t(ioc, asio::chrono::milliseconds(1));
+    t.wait();
+  }
+}
+
+void arrive_and_wait(asio::detail::atomic_count* arrived, long n)
+{
+  ++(*arrived);
+  wait_for_count(arrived, n);
+}
+
+void check_thread(asio::io_context* ioc, std::size_t index,
+    asio::detail::atomic_count* mismatches)
+{
+  if (ioc->this_thread_index() != index)
+    ++(*mismatches);
+}
+
+void handle_read_on_thread(const asio::error_code& err,
+    asio::io_context* ioc, std::size_t index,
+    asio::detail::atomic_count* mismatches, asio::detail::atomic_count* count)
+{
+  ASIO_CHECK(!err);
+  check_thread(ioc, index, mismatches);
+  ++(*count);
+}
+
+void handle_accept_on_thread(const asio::error_code& err,
+    asio::io_context* ioc, std::size_t index, asio::ip::tcp::socket* peer,
+    char* data, asio::detail::atomic_count* mismatches,
+    asio::detail::atomic_count* accept_count,
+    asio::detail::atomic_count* read_count)
+{
+  ASIO_CHECK(!err);
+  check_thread(ioc, index, mismatches);
+
+  // The accepted socket joins the acceptor's shard.
+  peer->async_read_some(asio::buffer(data, 1),
+      bindns::bind(handle_read_on_thread,
+        bindns::placeholders::_1, ioc, index, mismatches, read_count));
+  ++(*accept_count);
+}
+
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+
+void test()
+{
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc;
+
+  ip::tcp::acceptor_group group;
+  ASIO_CHECK(group.size() == 0);
+  ASIO_CHECK(!group.is_open());
+
+  const int acceptors = 3;
+  for (int i = 0; i < acceptors; ++i)
+    group.add(ioc);
+  ASIO_CHECK(group.size() == static_cast<std::size_t>(acceptors));
+
+  asio::error_code ec;
+  group.open(ip::tcp::endpoint(ip::address_v4::loopback(), 0),
+      socket_base::max_listen_connections, ec);
+  if (ec == asio::error::operation_not_supported)
+    return;
+  ASIO_CHECK(!ec);
+  ASIO_CHECK(group.is_open());
+
+  // All acceptors listen on the same port.
+  ip::tcp::endpoint server_endpoint = group.local_endpoint();
+  ASIO_CHECK(server_endpoint.port() != 0);
+  for (int i = 0; i < acceptors; ++i)
+    ASIO_CHECK(group[i].local_endpoint() == server_endpoint);
+
+  // Connections are shared out among the acceptors.
+  ip::tcp::socket* peers[acceptors];
+  int counts[acceptors];
+  for (int i = 0; i < acceptors; ++i)
+  {
+    peers[i] = new ip::tcp::socket(ioc);
+    counts[i] = 0;
+    group[i].async_accept(*peers[i], bindns::bind(
+          handle_accept, bindns::placeholders::_1,
+          &group[i], peers[i], &counts[i]));
+  }
+
+  const int connections = 60;
+  ip::tcp::socket* clients[connections];
+  for (int i = 0; i < connections; ++i)
+  {
+    clients[i] = new ip::tcp::socket(ioc);
+    clients[i]->connect(server_endpoint);
+  }
+
+  int total = 0;
+  while (total < connections)
+  {
+    ioc.run_one();
+    total = 0;
+    for (int i = 0; i < acceptors; ++i)
+      total += counts[i];
+  }
+
+  int acceptors_used = 0;
+  for (int i = 0; i < acceptors; ++i)
+    if (counts[i] > 0)
+      ++acceptors_used;
+  ASIO_CHECK(acceptors_used > 1);
+
+  group.steer_by_cpu(ec);
+  ASIO_CHECK(!ec || ec == asio::error::operation_not_supported);
+
+  group.close();
+  ASIO_CHECK(!group.is_open());
+  ioc.restart();
+  ioc.run();
+
+  for (int i = 0; i < connections; ++i)
+    delete clients[i];
+  for (int i = 0; i < acceptors; ++i)
+    delete peers[i];
+
+#if defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO) \
+  && defined(ASIO_HAS_EPOLL) && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  // With a sharded reactor, each acceptor and the sockets it accepts are
+  // served by the thread with the acceptor's index.
+  io_context ioc2(ASIO_CONCURRENCY_HINT_SHARDED_REACTOR);
+  const long threads = 2;
+  asio::detail::atomic_count arrived(0);
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc2);
+  asio::thread* run_threads[threads];
+  for (long i = 0; i < threads; ++i)
+  {
+    asio::post(ioc2, bindns::bind(
+          arrive_and_wait, &arrived, threads));
+    run_threads[i] = new asio::thread(
+        bindns::bind(run_context, &ioc2));
+  }
+  wait_for_count(&arrived, threads);
+
+  ip::tcp::acceptor_group group2;
+  for (long i = 0; i < threads; ++i)
+    group2.add(ioc2);
+  group2.open(ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  server_endpoint = group2.local_endpoint();
+
+  ip::tcp::socket* peers2[threads];
+  char data[threads];
+  asio::detail::atomic_count mismatches(0);
+  asio::detail::atomic_count accept_count(0);
+  asio::detail::atomic_count read_count(0);
+  for (long i = 0; i < threads; ++i)
+  {
+    peers2[i] = new ip::tcp::socket(ioc2);
+    group2[i].async_accept(*peers2[i], bindns::bind(
+          handle_accept_on_thread, bindns::placeholders::_1, &ioc2,
+          static_cast<std::size_t>(i), peers2[i], &data[i], &mismatches,
+          &accept_count, &read_count));
+  }
+
+  // Enough connections are made that each acceptor accepts one of them.
+  const int connections2 = 32;
+  ip::tcp::socket* clients2[connections2];
+  for (int i = 0; i < connections2; ++i)
+  {
+    clients2[i] = new ip::tcp::socket(ioc2);
+    clients2[i]->connect(server_endpoint);
+  }
+  wait_for_count(&accept_count, threads);
+
+  for (int i = 0; i < connections2; ++i)
+    asio::write(*clients2[i], asio::buffer("x", 1));
+  wait_for_count(&read_count, threads);
+
+  group2.close();
+  for (long i = 0; i < threads; ++i)
+    peers2[i]->close();
+  w.reset();
+  for (long i = 0; i < threads; ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+    delete peers2[i];
+  }
+  for (int i = 0; i < connections2; ++i)
+    delete clients2[i];
+
+  ASIO_CHECK(read_count == threads);
+  ASIO_CHECK(mismatches == 0);
+#endif // defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+       //   && defined(ASIO_HAS_EPOLL)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+} // namespace ip_tcp_acceptor_group_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_io_backend_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that sockets work with the I/O backend selected
+// at runtime by the io_context, when both epoll and io_uring are available.
+
+namespace ip_tcp_io_backend_runtime {
+
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void handle_transfer(const asio::error_code& err,
+    std::size_t bytes_transferred, std::size_t* total)
+{
+  ASIO_CHECK(!err);
+  *total += bytes_transferred;
+}
+
+asio::mutable_buffer provide_buffer(char* data)
+{
+  return asio::buffer(data, 1);
+}
+
+bool handle_read_loop(const asio::error_code& err,
+    std::size_t, asio::error_code* result)
+{
+  *result = err;
+  return false;
+}
+
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+void test()
+{
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  const int hints[] = { ASIO_CONCURRENCY_HINT_SAFE,
+    ASIO_CONCURRENCY_HINT_IO_URING, ASIO_CONCURRENCY_HINT_IO_URING_SQPOLL,
+    ASIO_CONCURRENCY_HINT_SHARDED_IO_URING };
+  for (int i = 0; i < 4; ++i)
+  {
+    io_context ioc(hints[i]);
+#if defined(ASIO_HAS_CHRONO)
+    ioc.set_io_uring_sqpoll(asio::chrono::milliseconds(10));
+#endif // defined(ASIO_HAS_CHRONO)
+    ioc.set_io_uring_ring_size(256);
+    bool uses_io_uring = use_service<
+      asio::detail::io_backend_selector>(ioc).use_io_uring();
+    if (!std::getenv("ASIO_IO_BACKEND") && i == 0)
+      ASIO_CHECK(!uses_io_uring);
+
+    ip::tcp::acceptor acceptor(ioc,
+        ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+    ip::tcp::socket client(ioc);
+    client.connect(acceptor.local_endpoint());
+    ip::tcp::socket server(ioc);
+    acceptor.accept(server);
+
+    const char write_data[] = "io_backend";
+    char read_data[sizeof(write_data)] = "";
+    std::size_t sent = 0;
+    std::size_t received = 0;
+    async_write(client, buffer(write_data),
+        bindns::bind(handle_transfer, bindns::placeholders::_1,
+          bindns::placeholders::_2, &sent));
+    async_read(server, buffer(read_data),
+        bindns::bind(handle_transfer, bindns::placeholders::_1,
+          bindns::placeholders::_2, &received));
+    ioc.run();
+    ASIO_CHECK(sent == sizeof(write_data));
+    ASIO_CHECK(received == sizeof(write_data));
+    ASIO_CHECK(memcmp(read_data, write_data, sizeof(write_data)) == 0);
+
+    // Persistent reads are only supported by the reactor.
+    asio::error_code loop_ec = asio::error::would_block;
+    write(client, buffer(write_data, 1));
+    server.async_read_loop(bindns::bind(provide_buffer, read_data),
+        bindns::bind(handle_read_loop, bindns::placeholders::_1,
+          bindns::placeholders::_2, &loop_ec));
+    ioc.restart();
+    ioc.run();
+    if (uses_io_uring)
+      ASIO_CHECK(loop_ec == asio::error::operation_not_supported);
+    else
+      ASIO_CHECK(!loop_ec);
+  }
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+}
+
+} // namespace ip_tcp_io_backend_runtime
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_io_uring_fixed_files test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that io_uring sockets keep working when the
+// registered file table is full, and that closing a socket releases its slot
+// in the table.
+
+namespace ip_tcp_io_uring_fixed_files {
+
+#if defined(ASIO_HAS_IO_URING)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+void handle_transfer(const asio::error_code& err,
+    std::size_t bytes_transferred, std::size_t* total)
+{
+  ASIO_CHECK(!err);
+  *total += bytes_transferred;
+}
+
+void handle_eof(const asio::error_code& err,
+    std::size_t, asio::error_code* result)
+{
+  *result = err;
+}
+
+// Send one byte each way over every connection.
+void transfer(asio::io_context& ioc,
+    std::vector<asio::ip::tcp::socket*>& clients,
+    std::vector<asio::ip::tcp::socket*>& servers)
+{
+  std::size_t sent = 0;
+  std::size_t received = 0;
+  std::vector<char> data(clients.size() * 2);
+  for (std::size_t i = 0; i < clients.size(); ++i)
+  {
+    asio::async_write(*clients[i], asio::buffer("c", 1),
+        bindns::bind(handle_transfer, bindns::placeholders::_1,
+          bindns::placeholders::_2, &sent));
+    asio::async_write(*servers[i], asio::buffer("s", 1),
+        bindns::bind(handle_transfer, bindns::placeholders::_1,
+          bindns::placeholders::_2, &sent));
+    asio::async_read(*servers[i], asio::buffer(&data[i * 2], 1),
+        bindns::bind(handle_transfer, bindns::placeholders::_1,
+          bindns::placeholders::_2, &received));
+    asio::async_read(*clients[i], asio::buffer(&data[i * 2 + 1], 1),
+        bindns::bind(handle_transfer, bindns::placeholders::_1,
+          bindns::placeholders::_2, &received));
+  }
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(sent == clients.size() * 2);
+  ASIO_CHECK(received == clients.size() * 2);
+  for (std::size_t i = 0; i < clients.size(); ++i)
+  {
+    ASIO_CHECK(data[i * 2] == 'c');
+    ASIO_CHECK(data[i * 2 + 1] == 's');
+  }
+}
+
+#endif // defined(ASIO_HAS_IO_URING)
+
+void test()
+{
+#if defined(ASIO_HAS_IO_URING)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  // The registered file table is no larger than the open file limit when the
+  // io_uring service starts, so a low limit gives a table that the sockets
+  // below overflow.
+  const ::rlim_t table_limit = 64;
+  const std::size_t connections = 64;
+  ::rlimit old_limit;
+  if (::getrlimit(RLIMIT_NOFILE, &old_limit) != 0
+      || old_limit.rlim_cur < table_limit * 4)
+    return;
+  ::rlimit limit = old_limit;
+  limit.rlim_cur = table_limit;
+  ::setrlimit(RLIMIT_NOFILE, &limit);
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_IO_URING);
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+  bool uses_io_uring = use_service<
+    asio::detail::io_backend_selector>(ioc).use_io_uring();
+#else // defined(ASIO_HAS_IO_URING_SELECTION)
+  use_service<asio::detail::io_uring_service>(ioc);
+  bool uses_io_uring = true;
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+  ::setrlimit(RLIMIT_NOFILE, &old_limit);
+  if (!uses_io_uring)
+    return;
+
+  // Connections beyond the size of the table use their descriptors.
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  std::vector<ip::tcp::socket*> clients;
+  std::vector<ip::tcp::socket*> servers;
+  for (std::size_t i = 0; i < connections; ++i)
+  {
+    clients.push_back(new ip::tcp::socket(ioc));
+    clients.back()->connect(acceptor.local_endpoint());
+    servers.push_back(new ip::tcp::socket(ioc));
+    acceptor.accept(*servers.back());
+  }
+
+  transfer(ioc, clients, servers);
+
+  // Closing a socket that has a slot closes the connection, as the table no
+  // longer holds a reference to it.
+  asio::error_code eof_error;
+  char eof_data = 0;
+  clients[0]->close();
+  async_read(*servers[0], asio::buffer(&eof_data, 1),
+      bindns::bind(handle_eof, bindns::placeholders::_1,
+        bindns::placeholders::_2, &eof_error));
+
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(eof_error == asio::error::eof);
+
+  // The slot is then given to the next socket, which must reach its own
+  // connection rather than the closed one.
+  servers[0]->close();
+  clients[0]->connect(acceptor.local_endpoint());
+  acceptor.accept(*servers[0]);
+
+  transfer(ioc, clients, servers);
+
+  for (std::size_t i = 0; i < connections; ++i)
+  {
+    delete clients[i];
+    delete servers[i];
+  }
+#endif // defined(ASIO_HAS_IO_URING)
+}
+
+} // namespace ip_tcp_io_uring_fixed_files
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_io_uring_sharded test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that, with sharded io_uring instances, each
+// socket's handlers run on the thread that owns its shard, and that threads
+// waiting on their own shards are woken for their completions.
+
+namespace ip_tcp_io_uring_sharded {
+
+#if defined(ASIO_HAS_IO_URING) \
+  && defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+
+#if defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+
+using ip_tcp_acceptor_group_runtime::arrive_and_wait;
+using ip_tcp_acceptor_group_runtime::run_context;
+using ip_tcp_acceptor_group_runtime::wait_for_count;
+
+struct connection_end
+{
+  asio::io_context* ioc_;
+  asio::ip::tcp::socket* socket_;
+  char data_;
+  int reads_;
+  std::size_t thread_index_;
+  asio::detail::atomic_count* mismatches_;
+  asio::detail::atomic_count* done_;
+};
+
+// Read two bytes one at a time, checking that both reads complete on the same
+// thread.
+void handle_read(const asio::error_code& err,
+    std::size_t, connection_end* end)
+{
+  ASIO_CHECK(!err);
+  std::size_t index = end->ioc_->this_thread_index();
+  if (end->reads_++ == 0)
+    end->thread_index_ = index;
+  else if (index != end->thread_index_)
+    ++(*end->mismatches_);
+
+  if (end->reads_ < 2)
+  {
+    end->socket_->async_read_some(asio::buffer(&end->data_, 1),
+        bindns::bind(handle_read, bindns::placeholders::_1,
+          bindns::placeholders::_2, end));
+  }
+  else
+    ++(*end->done_);
+}
+
+#endif // defined(ASIO_HAS_IO_URING)
+       //   && defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+
+void test()
+{
+#if defined(ASIO_HAS_IO_URING) \
+  && defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_SHARDED_IO_URING);
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+  if (!use_service<asio::detail::io_backend_selector>(ioc).use_io_uring())
+    return;
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+  // Both threads are inside run(), and so have indexes, before any socket is
+  // opened, so that the sockets are shared out between their shards.
+  const long threads = 2;
+  asio::detail::atomic_count arrived(0);
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  asio::thread* run_threads[threads];
+  for (long i = 0; i < threads; ++i)
+  {
+    asio::post(ioc, bindns::bind(arrive_and_wait, &arrived, threads));
+    run_threads[i] = new asio::thread(bindns::bind(run_context, &ioc));
+  }
+  wait_for_count(&arrived, threads);
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  const int connections = 8;
+  const int ends = connections * 2;
+  ip::tcp::socket* sockets[ends];
+  for (int i = 0; i < connections; ++i)
+  {
+    sockets[i * 2] = new ip::tcp::socket(ioc);
+    sockets[i * 2]->connect(acceptor.local_endpoint());
+    sockets[i * 2 + 1] = new ip::tcp::socket(ioc);
+    acceptor.accept(*sockets[i * 2 + 1]);
+  }
+
+  // The reads are started while the threads are idle, waiting on their
+  // shards, and the data is written only once the threads have gone back to
+  // waiting.
+  asio::detail::atomic_count mismatches(0);
+  asio::detail::atomic_count done(0);
+  connection_end state[ends];
+  for (int i = 0; i < ends; ++i)
+  {
+    connection_end s = { &ioc, sockets[i], 0, 0, 0, &mismatches, &done };
+    state[i] = s;
+    sockets[i]->async_read_some(asio::buffer(&state[i].data_, 1),
+        bindns::bind(handle_read, bindns::placeholders::_1,
+          bindns::placeholders::_2, &state[i]));
+  }
+  asio::steady_timer t(ioc, asio::chrono::milliseconds(10));
+  t.wait();
+  for (int i = 0; i < ends; ++i)
+    asio::write(*sockets[i ^ 1], asio::buffer("xy", 2));
+  wait_for_count(&done, ends);
+
+  w.reset();
+  for (long i = 0; i < threads; ++i)
+  {
+    run_threads[i]->join();
+    delete run_threads[i];
+  }
+
+  // Every handler ran on a thread inside run(), and between them the sockets
+  // used both threads' shards.
+  bool used[threads] = { false, false };
+  for (int i = 0; i < ends; ++i)
+  {
+    ASIO_CHECK(state[i].thread_index_ < static_cast<std::size_t>(threads));
+    if (state[i].thread_index_ < static_cast<std::size_t>(threads))
+      used[state[i].thread_index_] = true;
+    delete sockets[i];
+  }
+  ASIO_CHECK(mismatches == 0);
+  ASIO_CHECK(used[0] && used[1]);
+#endif // defined(ASIO_HAS_IO_URING)
+       //   && defined(ASIO_HAS_THREADS) && defined(ASIO_HAS_CHRONO)
+}
+
+} // namespace ip_tcp_io_uring_sharded
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_acceptor_accept_loop test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a persistent accept loop delivers each new
+// connection, and that it ends when the handler returns false or when the
+// acceptor is cancelled.
+
+namespace ip_tcp_acceptor_accept_loop {
+
+#if defined(ASIO_HAS_MOVE) \
+  && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+    || defined(ASIO_HAS_IO_URING_SELECTION))
+
+struct accept_loop_handler
+{
+  int* count_;
+  int limit_;
+  asio::error_code* result_;
+
+  bool operator()(const asio::error_code& err, asio::ip::tcp::socket peer)
+  {
+    *result_ = err;
+    if (err)
+      return false;
+    ASIO_CHECK(peer.is_open());
+    return ++*count_ < limit_;
+  }
+};
+
+#endif // defined(ASIO_HAS_MOVE)
+       //   && (defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //     || defined(ASIO_HAS_IO_URING_SELECTION))
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) \
+  && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+    || defined(ASIO_HAS_IO_URING_SELECTION))
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_IO_URING);
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+  bool uses_io_uring = use_service<
+    asio::detail::io_backend_selector>(ioc).use_io_uring();
+#else // defined(ASIO_HAS_IO_URING_SELECTION)
+  bool uses_io_uring = true;
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client1(ioc);
+  client1.connect(acceptor.local_endpoint());
+  ip::tcp::socket client2(ioc);
+  client2.connect(acceptor.local_endpoint());
+
+  int count = 0;
+  asio::error_code result = asio::error::would_block;
+  accept_loop_handler handler = { &count, 2, &result };
+  acceptor.async_accept_loop(handler);
+  ioc.run();
+
+  if (!uses_io_uring)
+  {
+    ASIO_CHECK(count == 0);
+    ASIO_CHECK(result == asio::error::operation_not_supported);
+    return;
+  }
+
+  ASIO_CHECK(count == 2);
+  ASIO_CHECK(!result);
+
+  // Cancellation ends a loop that is waiting for connections.
+  count = 0;
+  result = asio::error::would_block;
+  accept_loop_handler handler2 = { &count, 2, &result };
+  acceptor.async_accept_loop(handler2);
+  acceptor.cancel();
+  ioc.restart();
+  ioc.run();
+  ASIO_CHECK(count == 0);
+  ASIO_CHECK(result == asio::error::operation_aborted);
+#endif // defined(ASIO_HAS_MOVE)
+       //   && (defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //     || defined(ASIO_HAS_IO_URING_SELECTION))
+}
+
+} // namespace ip_tcp_acceptor_accept_loop
+
+//------------------------------------------------------------------------------
+
+// ip_tcp_socket_provided_read_loop test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a persistent read loop delivers data in
+// buffers taken from a ring of provided buffers.
+
+namespace ip_tcp_socket_provided_read_loop {
+
+#if defined(ASIO_HAS_MOVE) \
+  && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+    || defined(ASIO_HAS_IO_URING_SELECTION))
+
+struct read_loop_handler
+{
+  std::vector<char>* data_;
+  asio::error_code* result_;
+
+  bool operator()(const asio::error_code& err, asio::provided_buffer buffer)
+  {
+    *result_ = err;
+    if (err)
+      return false;
+    ASIO_CHECK(buffer.size() > 0);
+    const char* p = static_cast<const char*>(buffer.data());
+    data_->insert(data_->end(), p, p + buffer.size());
+    return true;
+  }
+};
+
+#endif // defined(ASIO_HAS_MOVE)
+       //   && (defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //     || defined(ASIO_HAS_IO_URING_SELECTION))
+
+void test()
+{
+#if defined(ASIO_HAS_MOVE) \
+  && (defined(ASIO_HAS_IO_URING_AS_DEFAULT) \
+    || defined(ASIO_HAS_IO_URING_SELECTION))
+  using namespace asio;
+  namespace ip = asio::ip;
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_IO_URING);
+#if defined(ASIO_HAS_IO_URING_SELECTION)
+  bool uses_io_uring = use_service<
+    asio::detail::io_backend_selector>(ioc).use_io_uring();
+#else // defined(ASIO_HAS_IO_URING_SELECTION)
+  bool uses_io_uring = true;
+#endif // defined(ASIO_HAS_IO_URING_SELECTION)
+
+  ip::tcp::acceptor acceptor(ioc,
+      ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  ip::tcp::socket client(ioc);
+  client.connect(acceptor.local_endpoint());
+  ip::tcp::socket server(ioc);
+  acceptor.accept(server);
+
+  provided_buffer_ring ring(ioc, 4, 8);
+
+  const char write_data[] = "provided buffers";
+  write(client, buffer(write_data, sizeof(write_data)));
+  client.shutdown(ip::tcp::socket::shutdown_send);
+
+  std::vector<char> read_data;
+  asio::error_code result = asio::error::would_block;
+  read_loop_handler handler = { &read_data, &result };
+  server.async_read_loop(ring, handler);
+  ioc.run();
+
+  if (!uses_io_uring)
+  {
+    ASIO_CHECK(read_data.empty());
+    ASIO_CHECK(result == asio::error::operation_not_supported);
+    return;
+  }
+
+  ASIO_CHECK(result == asio::error::eof);
+  ASIO_CHECK(read_data.size() == sizeof(write_data));
+  ASIO_CHECK(memcmp(&read_data[0], write_data, sizeof(write_data)) == 0);
+#endif // defined(ASIO_HAS_MOVE)
+       //   && (defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+       //     || defined(ASIO_HAS_IO_URING_SELECTION))
+}
+
+} // namespace ip_tcp_socket_provided_read_loop
+
+//------------------------------------------------------------------------------
+
 // ip_tcp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -1344,6 +2470,12 @@ ASIO_TEST_SUITE
   ASIO_TEST_CASE(ip_tcp_socket_runtime::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_compile::test)
   ASIO_TEST_CASE(ip_tcp_acceptor_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_acceptor_group_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_io_backend_runtime::test)
+  ASIO_TEST_CASE(ip_tcp_io_uring_fixed_files::test)
+  ASIO_TEST_CASE(ip_tcp_io_uring_sharded::test)
+  ASIO_TEST_CASE(ip_tcp_acceptor_accept_loop::test)
+  ASIO_TEST_CASE(ip_tcp_socket_provided_read_loop::test)
   ASIO_TEST_CASE(ip_tcp_resolver_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
   ASIO_TEST_CASE(ip_tcp_resolver_entry_compile::test)
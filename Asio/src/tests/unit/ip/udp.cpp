@@ -521,6 +521,136 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// ip_udp_socket_io_quota_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that a socket's I/O quota limits the number of
+// operations performed each time the reactor dispatches the socket.
+
+namespace ip_udp_socket_io_quota_runtime {
+
+void handle_queued_recv(asio::ip::udp::socket* s, int* count,
+    std::size_t* available, const asio::error_code& err, size_t)
+{
+  ASIO_CHECK(!err);
+  if ((*count)++ == 0)
+    *available = s->available();
+}
+
+void handle_chained_recv(asio::ip::udp::socket* s, char* data,
+    int* count, int limit, const asio::error_code& err, size_t)
+{
+  ASIO_CHECK(!err);
+  if (++(*count) < limit)
+  {
+#if defined(ASIO_HAS_BOOST_BIND)
+    namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+    namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+    using bindns::placeholders::_1;
+    using bindns::placeholders::_2;
+
+    s->async_receive(asio::buffer(data, 4),
+        bindns::bind(handle_chained_recv, s, data, count, limit, _1, _2));
+  }
+}
+
+void test()
+{
+#if defined(ASIO_HAS_EPOLL) \
+  && !defined(ASIO_HAS_IOCP) \
+  && !defined(ASIO_WINDOWS_RUNTIME) \
+  && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+  using namespace asio;
+  namespace ip = asio::ip;
+
+#if defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = boost;
+#else // defined(ASIO_HAS_BOOST_BIND)
+  namespace bindns = std;
+#endif // defined(ASIO_HAS_BOOST_BIND)
+  using bindns::placeholders::_1;
+  using bindns::placeholders::_2;
+
+  io_context ioc(ASIO_CONCURRENCY_HINT_SAFE);
+  ip::udp::socket s1(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  ip::udp::socket s2(ioc, ip::udp::endpoint(ip::address_v4::loopback(), 0));
+  asio::error_code ec;
+
+  socket_base::io_quota quota1;
+  s1.get_option(quota1, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(quota1.value() == 0);
+
+  s1.set_option(socket_base::io_quota(-1), ec);
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+
+  s1.set_option(socket_base::io_quota(2), ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::io_quota quota2;
+  s1.get_option(quota2, ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  ASIO_CHECK(quota2.value() == 2);
+
+  // With a quota, the first handler runs while the later datagrams are still
+  // waiting to be received.
+  const int datagrams = 8;
+  char data[datagrams][4];
+  int count = 0;
+  std::size_t available = 0;
+  for (int i = 0; i < datagrams; ++i)
+  {
+    s1.async_receive(buffer(data[i]),
+        bindns::bind(handle_queued_recv, &s1, &count, &available, _1, _2));
+  }
+  for (int i = 0; i < datagrams; ++i)
+    s2.send_to(buffer("abc", 4), s1.local_endpoint());
+  ioc.run();
+
+  ASIO_CHECK(count == datagrams);
+  ASIO_CHECK(available > 0);
+
+  // Operations that would complete immediately also count against the quota.
+  for (int i = 0; i < datagrams; ++i)
+    s2.send_to(buffer("abc", 4), s1.local_endpoint());
+  count = 0;
+  s1.async_receive(buffer(data[0]), bindns::bind(handle_chained_recv,
+        &s1, data[0], &count, static_cast<int>(datagrams), _1, _2));
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == datagrams);
+  ASIO_CHECK(s1.available() == 0);
+
+  // Without a quota, all of the queued operations are performed at once.
+  s1.set_option(socket_base::io_quota(0), ec);
+  ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  count = 0;
+  available = 1;
+  for (int i = 0; i < datagrams; ++i)
+  {
+    s1.async_receive(buffer(data[i]),
+        bindns::bind(handle_queued_recv, &s1, &count, &available, _1, _2));
+  }
+  for (int i = 0; i < datagrams; ++i)
+    s2.send_to(buffer("abc", 4), s1.local_endpoint());
+  ioc.restart();
+  ioc.run();
+
+  ASIO_CHECK(count == datagrams);
+  ASIO_CHECK(available == 0);
+#endif // defined(ASIO_HAS_EPOLL)
+       //   && !defined(ASIO_HAS_IOCP)
+       //   && !defined(ASIO_WINDOWS_RUNTIME)
+       //   && !defined(ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+} // namespace ip_udp_socket_io_quota_runtime
+
+//------------------------------------------------------------------------------
+
 // ip_udp_resolver_compile test
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 // The following test checks that all public member functions on the class
@@ -669,5 +799,6 @@ ASIO_TEST_SUITE
   "ip/udp",
   ASIO_TEST_CASE(ip_udp_socket_compile::test)
   ASIO_TEST_CASE(ip_udp_socket_runtime::test)
+  ASIO_TEST_CASE(ip_udp_socket_io_quota_runtime::test)
   ASIO_TEST_CASE(ip_udp_resolver_compile::test)
 )
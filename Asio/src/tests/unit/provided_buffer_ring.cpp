@@ -0,0 +1,75 @@
+//
+// provided_buffer_ring.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2022 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include "asio/provided_buffer_ring.hpp"
+
+#include "asio/io_context.hpp"
+#include "asio/system_error.hpp"
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// provided_buffer_ring_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that rings of provided buffers can be created
+// and that their arguments are validated.
+
+namespace provided_buffer_ring_runtime {
+
+void test()
+{
+#if defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+  using namespace asio;
+
+  io_context ioc;
+
+  provided_buffer_ring ring1(ioc, 8, 64);
+  ASIO_CHECK(ring1.buffer_count() == 8);
+  ASIO_CHECK(ring1.buffer_size() == 64);
+
+  provided_buffer_ring ring2(ioc.get_executor(), 1, 16);
+  ASIO_CHECK(ring2.buffer_count() == 1);
+  ASIO_CHECK(ring2.buffer_size() == 16);
+
+  provided_buffer empty;
+  ASIO_CHECK(empty.data() == 0);
+  ASIO_CHECK(empty.size() == 0);
+  empty.reset();
+
+#if !defined(ASIO_NO_EXCEPTIONS)
+  asio::error_code ec;
+  try
+  {
+    provided_buffer_ring ring3(ioc, 3, 64);
+  }
+  catch (const asio::system_error& e)
+  {
+    ec = e.code();
+  }
+  ASIO_CHECK(ec == asio::error::invalid_argument);
+#endif // !defined(ASIO_NO_EXCEPTIONS)
+#endif // defined(ASIO_HAS_IO_URING) && defined(ASIO_HAS_MOVE)
+}
+
+} // namespace provided_buffer_ring_runtime
+
+//------------------------------------------------------------------------------
+
+ASIO_TEST_SUITE
+(
+  "provided_buffer_ring",
+  ASIO_TEST_CASE(provided_buffer_ring_runtime::test)
+)
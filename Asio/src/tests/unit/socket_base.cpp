@@ -177,6 +177,15 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // io_quota class.
+
+    socket_base::io_quota io_quota1(16);
+    sock.set_option(io_quota1);
+    socket_base::io_quota io_quota2;
+    sock.get_option(io_quota2);
+    io_quota1 = 8;
+    (void)static_cast<int>(io_quota1.value());
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;